@@ -0,0 +1,151 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file harness.cpp
+ * @brief Implementation file for the benchmark harness.
+ * @ingroup Benchmarks
+ *
+ * This file replaces the global allocation functions to count allocations,
+ * samples the peak RSS of the process and writes the JSON report.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the benchmark harness
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/harness.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+#if defined(_WIN32)
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+namespace {
+    /**
+     * @brief Process wide allocation counters.
+     * Allocations done by the shared library are counted as well since the
+     * replaced operators are resolved process wide (not on Windows DLLs).
+     */
+    std::atomic<std::uint64_t> g_allocations{0};
+    std::atomic<std::uint64_t> g_bytes{0};
+
+    void* counted_alloc(std::size_t size) {
+        g_allocations.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(size, std::memory_order_relaxed);
+        if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+        throw std::bad_alloc();
+    }
+} // namespace
+
+void* operator new(std::size_t size) { return counted_alloc(size); }
+void* operator new[](std::size_t size) { return counted_alloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return counted_alloc(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return counted_alloc(size); } catch (...) { return nullptr; }
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+namespace bench {
+    /**
+     * @brief Reads the allocation counters maintained by the replaced global operator new.
+     * @return The current allocation counters.
+     */
+    counters allocations() {
+        return { g_allocations.load(std::memory_order_relaxed), g_bytes.load(std::memory_order_relaxed) };
+    }
+
+
+    /**
+     * @brief Reads the peak resident set size of the process.
+     * @return The peak RSS in kilobytes, 0 if the platform does not report it.
+     */
+    std::uint64_t peak_rss_kb() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS pmc;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return pmc.PeakWorkingSetSize / 1024;
+        return 0;
+#else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    #if defined(__APPLE__)
+        /* macOS reports ru_maxrss in bytes */
+        return static_cast<std::uint64_t>(usage.ru_maxrss) / 1024;
+    #else
+        return static_cast<std::uint64_t>(usage.ru_maxrss);
+    #endif
+#endif
+    }
+
+
+    /**
+     * @brief Adds a result to the report and echoes a summary line.
+     * @param res The result to add.
+     */
+    void report::add(const result& res) {
+        std::cerr << std::left << std::setw(28) << res.name
+                  << std::right << std::setw(10) << res.size
+                  << std::setw(14) << std::fixed << std::setprecision(2) << res.ns_per_op << " ns/op"
+                  << std::setw(10) << res.allocs_per_op << " allocs/op"
+                  << std::setw(10) << res.peak_rss_kb << " KB peak\n";
+        this->__results.push_back(res);
+    }
+
+
+    /**
+     * @brief Writes the report as JSON.
+     * @param os The stream to write to.
+     */
+    void report::write_json(std::ostream& os) const {
+        os << "{\n  \"library\": \"TreeCode\",\n  \"version\": \"0.0.1\",\n  \"results\": [";
+        for (std::size_t i = 0; i < this->__results.size(); ++i) {
+            const auto& res = this->__results[i];
+            os << (i ? ",\n" : "\n")
+               << "    {\"name\": \"" << res.name << "\""
+               << ", \"size\": " << res.size
+               << ", \"ops\": " << res.ops
+               << ", \"rounds\": " << res.rounds
+               << std::fixed << std::setprecision(3)
+               << ", \"ns_per_op\": " << res.ns_per_op
+               << ", \"allocs_per_op\": " << res.allocs_per_op
+               << ", \"bytes_per_op\": " << res.bytes_per_op
+               << ", \"peak_rss_kb\": " << res.peak_rss_kb << "}";
+        }
+        os << "\n  ]\n}\n";
+    }
+} // namespace bench
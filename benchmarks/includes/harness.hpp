@@ -0,0 +1,172 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file harness.hpp
+ * @brief Header file for the benchmark harness.
+ * @ingroup Benchmarks
+ *
+ * This file contains the small measurement harness used by treecode_bench:
+ * a monotonic timer, process wide allocation counters, peak RSS sampling
+ * and a JSON report writer.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the benchmark harness
+ */
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bench {
+    /**
+     * @struct counters
+     * @brief Snapshot of the process wide allocation counters.
+     */
+    struct counters {
+        std::uint64_t allocations = 0;
+        std::uint64_t bytes = 0;
+    };
+
+
+    /**
+     * @brief Reads the allocation counters maintained by the replaced global operator new.
+     * @return The current allocation counters.
+     */
+    counters allocations();
+
+
+    /**
+     * @brief Reads the peak resident set size of the process.
+     * @return The peak RSS in kilobytes, 0 if the platform does not report it.
+     */
+    std::uint64_t peak_rss_kb();
+
+
+    /**
+     * @struct result
+     * @brief One measured benchmark case.
+     */
+    struct result {
+        std::string name;
+        std::uint64_t size = 0;
+        std::uint64_t ops = 0;
+        std::uint64_t rounds = 0;
+        double ns_per_op = 0.0;
+        double allocs_per_op = 0.0;
+        double bytes_per_op = 0.0;
+        std::uint64_t peak_rss_kb = 0;
+    };
+
+
+    /**
+     * @class report
+     * @brief Collects results and writes them as a JSON document.
+     */
+    class report {
+    public:
+        /**
+         * @brief Adds a result to the report and echoes a summary line.
+         * @param res The result to add.
+         */
+        void add(const result& res);
+
+
+        /**
+         * @brief Writes the report as JSON.
+         * @param os The stream to write to.
+         */
+        void write_json(std::ostream& os) const;
+
+    private:
+        /**
+         * @var std::vector<result> report::__results
+         * The collected results.
+         */
+        std::vector<result> __results;
+    };
+
+
+    /**
+     * @brief Measures a benchmark case.
+     *
+     * Each round calls setup() outside of the measured region, then runs body(state)
+     * while the timer and allocation counters are active. Rounds are repeated for small
+     * sizes until a minimal amount of work has been measured.
+     *
+     * @param name The name of the case.
+     * @param size The problem size (items, children or nodes).
+     * @param ops The number of operations performed by one call to body.
+     * @param setup Callable producing the state for one round.
+     * @param body Callable performing the measured operations on the state.
+     * @return The measured result.
+     */
+    template <typename Setup, typename Body>
+    result measure(
+        const std::string& name,
+        std::uint64_t size,
+        std::uint64_t ops,
+        Setup&& setup,
+        Body&& body
+    ) {
+        using clock = std::chrono::steady_clock;
+        /* aim for at least ~1M operations or 200ms per case */
+        constexpr std::uint64_t MIN_OPS = 1000000;
+        constexpr auto MIN_TIME = std::chrono::milliseconds(200);
+        constexpr std::uint64_t MAX_ROUNDS = 1000;
+
+        result res;
+        res.name = name;
+        res.size = size;
+        res.ops = ops;
+
+        clock::duration elapsed{};
+        std::uint64_t allocs = 0, bytes = 0;
+        do {
+            auto state = setup();
+            auto before = allocations();
+            auto start = clock::now();
+            body(state);
+            auto stop = clock::now();
+            auto after = allocations();
+            elapsed += stop - start;
+            allocs += after.allocations - before.allocations;
+            bytes += after.bytes - before.bytes;
+            ++res.rounds;
+        } while (res.rounds < MAX_ROUNDS && (res.rounds * ops < MIN_OPS || elapsed < MIN_TIME) && elapsed < MIN_TIME * 10);
+
+        const double total = static_cast<double>(res.rounds * (ops ? ops : 1));
+        res.ns_per_op = std::chrono::duration<double, std::nano>(elapsed).count() / total;
+        res.allocs_per_op = static_cast<double>(allocs) / total;
+        res.bytes_per_op = static_cast<double>(bytes) / total;
+        res.peak_rss_kb = peak_rss_kb();
+        return res;
+    }
+} // namespace bench
+
+#endif // BENCH_HARNESS_H
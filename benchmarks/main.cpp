@@ -0,0 +1,713 @@
+#include <treecode.hpp>
+#include <harness.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    /**
+     * @brief Sink preventing the optimiser from discarding measured lookups.
+     */
+    volatile std::size_t g_sink = 0;
+
+    /**
+     * @struct options
+     * @brief Command line options of treecode_bench.
+     */
+    struct options {
+        std::uint64_t min_size = 10;
+        std::uint64_t max_size = 10000000;
+        std::string filter;
+        std::string out;
+    };
+
+    /**
+     * @struct bench_case
+     * @brief A named benchmark case with the largest size it is run at.
+     *
+     * Some cases scan linearly per operation (unindexed lookups), their limit
+     * keeps a full run tractable.
+     */
+    struct bench_case {
+        const char* name;
+        std::uint64_t limit;
+        std::function<bench::result(std::uint64_t)> run;
+    };
+
+    std::vector<std::string> make_keys(std::uint64_t n) {
+        std::vector<std::string> keys;
+        keys.reserve(n);
+        for (std::uint64_t i = 0; i < n; ++i) keys.push_back("key" + std::to_string(i));
+        return keys;
+    }
+
+    std::shared_ptr<treecode::container> make_container(const std::vector<std::string>& keys) {
+        auto items = std::make_shared<treecode::container>();
+        for (std::size_t i = 0; i < keys.size(); ++i) items->add<int>(keys[i], static_cast<int>(i));
+        return items;
+    }
+
+    /**
+     * @brief Builds the ELEMENT group used by the Did_Tree example.
+     */
+    treecode::group make_element(const std::string& name) {
+        auto ele_group = treecode::group(name);
+        ele_group.items().add<std::string>("NAME")->required();
+        ele_group.items().add<std::string>("TYPE", {"uint8", "uint16"});
+        ele_group.items().add<int>("VALUE", 0);
+        ele_group.items().add<bool>("SHARED", false)->required();
+        return ele_group;
+    }
+
+    /**
+     * @brief Builds the ELEMENT group with inline slots, TYPE keeps its choices in an item.
+     */
+    treecode::group make_inline_element(const std::string& name) {
+        auto ele_group = treecode::group(name);
+        ele_group.items().add_inline<std::string>("NAME");
+        ele_group.items().required("NAME");
+        ele_group.items().add<std::string>("TYPE", {"uint8", "uint16"});
+        ele_group.items().add_inline<int>("VALUE", 0);
+        ele_group.items().add_inline<bool>("SHARED", false);
+        ele_group.items().required("SHARED");
+        return ele_group;
+    }
+
+    /**
+     * @brief Builds a nested hierarchy of n ELEMENT nodes with a fan out of 8.
+     */
+    std::shared_ptr<treecode::group> make_hierarchy(std::uint64_t n) {
+        constexpr std::uint64_t FANOUT = 8;
+        auto root = std::make_shared<treecode::group>(make_element("NODE"));
+        std::vector<std::shared_ptr<treecode::group>> level{root};
+        std::uint64_t count = 1;
+        while (count < n) {
+            std::vector<std::shared_ptr<treecode::group>> next;
+            for (const auto& parent : level) {
+                for (std::uint64_t i = 0; i < FANOUT && count < n; ++i, ++count) {
+                    auto child = std::make_shared<treecode::group>(make_element("NODE"));
+                    parent->add(child);
+                    next.push_back(child);
+                }
+            }
+            level.swap(next);
+        }
+        return root;
+    }
+
+    std::vector<std::string> make_ids(std::uint64_t n) {
+        std::vector<std::string> ids;
+        ids.reserve(n);
+        for (std::uint64_t i = 0; i < n; ++i) ids.push_back("FD" + std::to_string(i));
+        return ids;
+    }
+
+    /**
+     * @brief Builds a root with n DID children, each holding its ID item.
+     */
+    std::shared_ptr<treecode::group> make_did_root(std::uint64_t n) {
+        auto root = std::make_shared<treecode::group>("ROOT");
+        for (const auto& id : make_ids(n)) root->emplace_child("DID")->items().add<std::string>("ID", id);
+        return root;
+    }
+
+    /**
+     * @brief Picks at most sample keys spread evenly over the key set.
+     */
+    std::vector<std::string> sample_keys(const std::vector<std::string>& keys, std::uint64_t sample) {
+        std::vector<std::string> picked;
+        const std::uint64_t n = keys.size();
+        const std::uint64_t count = std::min(n, sample);
+        picked.reserve(count);
+        for (std::uint64_t i = 0; i < count; ++i) picked.push_back(keys[i * n / count]);
+        return picked;
+    }
+
+    std::vector<bench_case> make_cases() {
+        constexpr std::uint64_t REMOVE_SAMPLE = 1000;
+        std::vector<bench_case> cases;
+
+        cases.push_back({"container.add", 10000000, [](std::uint64_t n) {
+            auto keys = make_keys(n);
+            return bench::measure("container.add", n, n,
+                [] { return std::make_shared<treecode::container>(); },
+                [&](std::shared_ptr<treecode::container>& items) {
+                    for (std::size_t i = 0; i < keys.size(); ++i) items->add<int>(keys[i], static_cast<int>(i));
+                });
+        }});
+
+        cases.push_back({"container.get", 10000000, [](std::uint64_t n) {
+            auto keys = make_keys(n);
+            auto items = make_container(keys);
+            return bench::measure("container.get", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (const auto& key : keys) sink += items->get(key) != nullptr;
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"container.get_typed", 10000000, [](std::uint64_t n) {
+            auto keys = make_keys(n);
+            auto items = make_container(keys);
+            return bench::measure("container.get_typed", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (const auto& key : keys) sink += items->get<int>(key) != nullptr;
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"container.get_key", 10000000, [](std::uint64_t n) {
+            auto keys = make_keys(n);
+            auto items = make_container(keys);
+            std::vector<treecode::key> handles(keys.begin(), keys.end());
+            return bench::measure("container.get_key", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (const auto& key : handles) sink += items->get(key) != nullptr;
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"container.add_inline", 10000000, [](std::uint64_t n) {
+            auto keys = make_keys(n);
+            return bench::measure("container.add_inline", n, n,
+                [] { return std::make_shared<treecode::container>(); },
+                [&](std::shared_ptr<treecode::container>& items) {
+                    for (std::size_t i = 0; i < keys.size(); ++i) items->add_inline<int>(keys[i], static_cast<int>(i));
+                });
+        }});
+
+        cases.push_back({"container.value_inline", 10000000, [](std::uint64_t n) {
+            auto keys = make_keys(n);
+            treecode::container items;
+            for (std::size_t i = 0; i < keys.size(); ++i) items.add_inline<int>(keys[i], static_cast<int>(i));
+            std::vector<treecode::key> handles(keys.begin(), keys.end());
+            return bench::measure("container.value_inline", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (const auto& key : handles) sink += static_cast<std::size_t>(*items.value<int>(key));
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"container.exists", 10000000, [](std::uint64_t n) {
+            auto keys = make_keys(n);
+            auto items = make_container(keys);
+            return bench::measure("container.exists", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (const auto& key : keys) sink += items->exists(key);
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"container.remove", 10000000, [](std::uint64_t n) {
+            auto keys = make_keys(n);
+            auto picked = sample_keys(keys, REMOVE_SAMPLE);
+            return bench::measure("container.remove", n, picked.size(),
+                [&] { return make_container(keys); },
+                [&](std::shared_ptr<treecode::container>& items) {
+                    std::size_t sink = 0;
+                    for (const auto& key : picked) sink += items->remove(key);
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"group.add", 10000000, [](std::uint64_t n) {
+            std::vector<std::shared_ptr<treecode::group>> children;
+            children.reserve(n);
+            for (std::uint64_t i = 0; i < n; ++i) children.push_back(std::make_shared<treecode::group>("CHILD"));
+            return bench::measure("group.add", n, n,
+                [] { return std::make_shared<treecode::group>("ROOT"); },
+                [&](std::shared_ptr<treecode::group>& root) {
+                    for (const auto& child : children) root->add(child);
+                });
+        }});
+
+        cases.push_back({"group.child", 10000000, [](std::uint64_t n) {
+            auto root = std::make_shared<treecode::group>("ROOT");
+            auto names = make_keys(n);
+            for (const auto& name : names) root->emplace_child(name);
+            auto picked = sample_keys(names, 1000);
+            return bench::measure("group.child", n, picked.size(),
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (const auto& name : picked) sink += root->child(name) != nullptr;
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"group.find_child_scan", 100000, [](std::uint64_t n) {
+            auto root = make_did_root(n);
+            auto ids = sample_keys(make_ids(n), 1000);
+            return bench::measure("group.find_child_scan", n, ids.size(),
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (const auto& id : ids) sink += root->find_child("ID", id) != nullptr;
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"group.find_child_indexed", 10000000, [](std::uint64_t n) {
+            auto root = make_did_root(n);
+            root->add_index("ID");
+            auto ids = sample_keys(make_ids(n), 1000);
+            const treecode::key id_key("ID");
+            return bench::measure("group.find_child_indexed", n, ids.size(),
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (const auto& id : ids) sink += root->find_child(id_key, id) != nullptr;
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"group.indexed_value_update", 10000000, [](std::uint64_t n) {
+            auto root = make_did_root(n);
+            root->add_index("ID");
+            std::vector<std::shared_ptr<treecode::item<std::string>>> items;
+            items.reserve(n);
+            for (const auto& child : root->children()) items.push_back(child->items().get<std::string>("ID"));
+            auto ids = make_ids(n);
+            return bench::measure("group.indexed_value_update", n, n,
+                [] { return 0; },
+                [&](int& round) {
+                    const std::string suffix = std::to_string(++round % 2);
+                    for (std::size_t i = 0; i < items.size(); ++i) items[i]->value(ids[i] + suffix);
+                });
+        }});
+
+        cases.push_back({"tmpl.clone", 1000000, [](std::uint64_t n) {
+            /* the cloned group is the last of 32 so the name lookup is exercised */
+            treecode::tmpl tmpl("Bench_Tmpl");
+            for (int i = 0; i < 31; ++i) tmpl.add(make_element("GROUP" + std::to_string(i)));
+            tmpl.add(make_element("ELEMENT"));
+            return bench::measure("tmpl.clone", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (std::uint64_t i = 0; i < n; ++i) sink += tmpl.clone("ELEMENT").children().size();
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"tmpl.clone_inline", 1000000, [](std::uint64_t n) {
+            treecode::tmpl tmpl("Bench_Tmpl");
+            for (int i = 0; i < 31; ++i) tmpl.add(make_inline_element("GROUP" + std::to_string(i)));
+            tmpl.add(make_inline_element("ELEMENT"));
+            return bench::measure("tmpl.clone_inline", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (std::uint64_t i = 0; i < n; ++i) sink += tmpl.clone("ELEMENT").children().size();
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"tmpl.clone_shared", 1000000, [](std::uint64_t n) {
+            treecode::tmpl tmpl("Bench_Tmpl");
+            for (int i = 0; i < 31; ++i) tmpl.add(make_element("GROUP" + std::to_string(i)));
+            tmpl.add(make_element("ELEMENT"));
+            return bench::measure("tmpl.clone_shared", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (std::uint64_t i = 0; i < n; ++i) sink += tmpl.clone("ELEMENT", treecode::clone_mode::shared).children().size();
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"tmpl.clone_n", 1000000, [](std::uint64_t n) {
+            treecode::tmpl tmpl("Bench_Tmpl");
+            for (int i = 0; i < 31; ++i) tmpl.add(make_element("GROUP" + std::to_string(i)));
+            tmpl.add(make_element("ELEMENT"));
+            return bench::measure("tmpl.clone_n", n, n,
+                [] { return treecode::group("ROOT"); },
+                [&](treecode::group& root) {
+                    tmpl.clone_n("ELEMENT", n, root, treecode::clone_mode::shared);
+                    g_sink = root.children().size();
+                });
+        }});
+
+        cases.push_back({"tree.build_discard", 1000000, [](std::uint64_t n) {
+            treecode::tmpl tmpl("Bench_Tmpl");
+            tmpl.add(make_element("ELEMENT"));
+            return bench::measure("tree.build_discard", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    /* build a flat tree of n instances and tear it down */
+                    auto root = std::make_unique<treecode::group>("ROOT");
+                    for (std::uint64_t i = 0; i < n; ++i) root->add(tmpl.clone("ELEMENT"));
+                    g_sink = root->children().size();
+                    root.reset();
+                });
+        }});
+
+        cases.push_back({"tree.build_discard_arena", 1000000, [](std::uint64_t n) {
+            treecode::tmpl tmpl("Bench_Tmpl");
+            tmpl.add(make_element("ELEMENT"));
+            return bench::measure("tree.build_discard_arena", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    /* same tree bound to an arena, released in one shot */
+                    auto arena = std::make_unique<treecode::arena>();
+                    auto root = std::make_unique<treecode::group>("ROOT", arena.get());
+                    for (std::uint64_t i = 0; i < n; ++i) root->add(tmpl.clone("ELEMENT", arena.get()));
+                    g_sink = root->children().size();
+                    root.reset();
+                    arena.reset();
+                });
+        }});
+
+        cases.push_back({"tmpl.clone_deep", 1000000, [](std::uint64_t n) {
+            treecode::tmpl tmpl("Bench_Tmpl");
+            tmpl.add(make_hierarchy(n));
+            return bench::measure("tmpl.clone_deep", n, n,
+                [] { return 0; },
+                [&](int&) { g_sink = tmpl.clone("NODE").children().size(); });
+        }});
+
+        cases.push_back({"tmpl.clone_deep_parallel", 1000000, [](std::uint64_t n) {
+            treecode::tmpl tmpl("Bench_Tmpl");
+            tmpl.add(make_hierarchy(n));
+            return bench::measure("tmpl.clone_deep_parallel", n, n,
+                [] { return 0; },
+                [&](int&) { g_sink = tmpl.clone("NODE", treecode::parallel{}).children().size(); });
+        }});
+
+        cases.push_back({"group.deep_copy", 1000000, [](std::uint64_t n) {
+            auto root = make_hierarchy(n);
+            return bench::measure("group.deep_copy", n, n,
+                [] { return 0; },
+                [&](int&) { g_sink = root->deep_copy().children().size(); });
+        }});
+
+        cases.push_back({"group.deep_copy_parallel", 1000000, [](std::uint64_t n) {
+            auto root = make_hierarchy(n);
+            return bench::measure("group.deep_copy_parallel", n, n,
+                [] { return 0; },
+                [&](int&) { g_sink = root->deep_copy(treecode::parallel{}).children().size(); });
+        }});
+
+        cases.push_back({"tree.walk", 10000000, [](std::uint64_t n) {
+            auto root = make_hierarchy(n);
+            return bench::measure("tree.walk", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (const auto& visited : treecode::walk(*root)) sink += visited.depth;
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"tree.walk_items", 1000000, [](std::uint64_t n) {
+            auto root = make_hierarchy(n);
+            return bench::measure("tree.walk_items", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (auto visited : treecode::walk_items(*root)) sink += visited.item.has_value();
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"tree.parallel_for_each", 10000000, [](std::uint64_t n) {
+            auto root = make_hierarchy(n);
+            return bench::measure("tree.parallel_for_each", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::atomic<std::size_t> sink{0};
+                    treecode::parallel_for_each(*root, [&](const treecode::tree_node<const treecode::group>& visited) {
+                        sink.fetch_add(visited.depth, std::memory_order_relaxed);
+                    });
+                    g_sink = sink.load();
+                });
+        }});
+
+        cases.push_back({"tree.parallel_reduce", 10000000, [](std::uint64_t n) {
+            auto root = make_hierarchy(n);
+            return bench::measure("tree.parallel_reduce", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    g_sink = treecode::parallel_reduce(*root, std::size_t(0),
+                        [](const treecode::tree_node<const treecode::group>& visited) { return visited.node->items().size(); },
+                        [](std::size_t a, std::size_t b) { return a + b; });
+                });
+        }});
+
+        cases.push_back({"query.select", 10000000, [](std::uint64_t n) {
+            auto root = make_hierarchy(n);
+            const treecode::query q("**/NODE[SHARED=false]/VALUE");
+            return bench::measure("query.select", n, n,
+                [] { return 0; },
+                [&](int&) { g_sink = q.select(static_cast<const treecode::group&>(*root)).size(); });
+        }});
+
+        cases.push_back({"query.select_parallel", 10000000, [](std::uint64_t n) {
+            auto root = make_hierarchy(n);
+            const treecode::query q("**/NODE[SHARED=false]/VALUE");
+            return bench::measure("query.select_parallel", n, n,
+                [] { return 0; },
+                [&](int&) { g_sink = q.select(*root, treecode::parallel{}).size(); });
+        }});
+
+        cases.push_back({"snapshot.write", 1000000, [](std::uint64_t n) {
+            auto root = make_hierarchy(n);
+            return bench::measure("snapshot.write", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::ostringstream out;
+                    treecode::snapshot::write(*root, out);
+                    g_sink = static_cast<std::size_t>(out.tellp());
+                });
+        }});
+
+        cases.push_back({"snapshot.read", 1000000, [](std::uint64_t n) {
+            std::ostringstream out;
+            treecode::snapshot::write(*make_hierarchy(n), out);
+            const std::string image = out.str();
+            return bench::measure("snapshot.read", n, n,
+                [] { return 0; },
+                [&](int&) { g_sink = treecode::snapshot::read(image.data(), image.size()).children().size(); });
+        }});
+
+        cases.push_back({"snapshot.read_lazy_sample", 1000000, [](std::uint64_t n) {
+            const std::string path = (std::filesystem::temp_directory_path() / "treecode_bench.tcs").string();
+            treecode::snapshot::write(*make_did_root(n), path);
+            /* a run touching a few hundred DIDs of the catalogue */
+            const std::uint64_t sample = std::min<std::uint64_t>(n, 300);
+            auto res = bench::measure("snapshot.read_lazy_sample", n, 1,
+                [] { return 0; },
+                [&](int&) {
+                    const treecode::group root = treecode::snapshot::read_lazy(path);
+                    const auto& children = root.children();
+                    std::size_t sink = 0;
+                    for (std::uint64_t i = 0; i < sample; ++i) sink += children[i * n / sample]->items().exists("ID");
+                    g_sink = sink;
+                });
+            std::filesystem::remove(path);
+            return res;
+        }});
+
+        cases.push_back({"snapshot.read_full_sample", 1000000, [](std::uint64_t n) {
+            const std::string path = (std::filesystem::temp_directory_path() / "treecode_bench.tcs").string();
+            treecode::snapshot::write(*make_did_root(n), path);
+            const std::uint64_t sample = std::min<std::uint64_t>(n, 300);
+            auto res = bench::measure("snapshot.read_full_sample", n, 1,
+                [] { return 0; },
+                [&](int&) {
+                    const treecode::group root = treecode::snapshot::read(path);
+                    const auto& children = root.children();
+                    std::size_t sink = 0;
+                    for (std::uint64_t i = 0; i < sample; ++i) sink += children[i * n / sample]->items().exists("ID");
+                    g_sink = sink;
+                });
+            std::filesystem::remove(path);
+            return res;
+        }});
+
+        cases.push_back({"mapped_tree.open", 1000000, [](std::uint64_t n) {
+            const std::string path = (std::filesystem::temp_directory_path() / "treecode_bench.tcs").string();
+            treecode::snapshot::write(*make_hierarchy(n), path);
+            auto res = bench::measure("mapped_tree.open", n, 1,
+                [] { return 0; },
+                [&](int&) { g_sink = treecode::mapped_tree(path).root().child_count(); });
+            std::filesystem::remove(path);
+            return res;
+        }});
+
+        cases.push_back({"mapped_tree.walk", 1000000, [](std::uint64_t n) {
+            const std::string path = (std::filesystem::temp_directory_path() / "treecode_bench.tcs").string();
+            treecode::snapshot::write(*make_hierarchy(n), path);
+            const treecode::mapped_tree tree(path);
+            auto res = bench::measure("mapped_tree.walk", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    std::vector<treecode::mapped_tree::group_view> stack{tree.root()};
+                    while (!stack.empty()) {
+                        const auto node = stack.back();
+                        stack.pop_back();
+                        sink += node.find("VALUE").has_value();
+                        node.for_each_child([&](const treecode::mapped_tree::group_view& child) { stack.push_back(child); });
+                    }
+                    g_sink = sink;
+                });
+            std::filesystem::remove(path);
+            return res;
+        }});
+
+        cases.push_back({"json.write", 1000000, [](std::uint64_t n) {
+            auto root = make_hierarchy(n);
+            return bench::measure("json.write", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::ostringstream out;
+                    treecode::json::write(*root, out);
+                    g_sink = static_cast<std::size_t>(out.tellp());
+                });
+        }});
+
+        cases.push_back({"json.read", 1000000, [](std::uint64_t n) {
+            std::ostringstream out;
+            treecode::json::write(*make_hierarchy(n), out);
+            const std::string text = out.str();
+            treecode::tmpl schema("SCHEMA");
+            schema.add(make_element("NODE"));
+            return bench::measure("json.read", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::istringstream in(text);
+                    g_sink = treecode::json::read(in, schema).children().size();
+                });
+        }});
+
+        cases.push_back({"rcu_tree.read", 10000000, [](std::uint64_t n) {
+            treecode::rcu_tree tree(make_hierarchy(64));
+            return bench::measure("rcu_tree.read", n, n,
+                [] { return 0; },
+                [&](int&) {
+                    std::size_t sink = 0;
+                    for (std::uint64_t i = 0; i < n; ++i) {
+                        const auto view = tree.read();
+                        sink += view->children().size();
+                    }
+                    g_sink = sink;
+                });
+        }});
+
+        cases.push_back({"persistent_group.update", 1000000, [](std::uint64_t n) {
+            const auto first = treecode::persistent_group::freeze(*make_hierarchy(n));
+            /* the path to the first leaf, a version copies the groups along it only */
+            std::vector<std::size_t> path;
+            for (auto node = first; node.child_count(); node = node.child(0)) path.push_back(0);
+            return bench::measure("persistent_group.update", n, 1000,
+                [] { return 0; },
+                [&](int&) {
+                    auto version = first;
+                    for (int i = 0; i < 1000; ++i) {
+                        version = version.update(path, [i](const treecode::persistent_group& leaf) { return leaf.with_value("VALUE", i); });
+                    }
+                    g_sink = version.child_count();
+                });
+        }});
+
+        cases.push_back({"delta.diff", 1000000, [](std::uint64_t n) {
+            auto from = make_hierarchy(n);
+            treecode::group to = from->deep_copy();
+            /* one changed value on the last leaf */
+            treecode::group* leaf = &to;
+            while (!leaf->children().empty()) leaf = leaf->children().back().get();
+            leaf->items().value<int>("VALUE", 42);
+            return bench::measure("delta.diff", n, n,
+                [] { return 0; },
+                [&](int&) { g_sink = treecode::diff(*from, to).bytes().size(); });
+        }});
+
+        cases.push_back({"group.hash", 1000000, [](std::uint64_t n) {
+            auto root = make_hierarchy(n);
+            treecode::group* leaf = root.get();
+            while (!leaf->children().empty()) leaf = leaf->children().back().get();
+            g_sink = root->hash();
+            /* one changed leaf, only its path is hashed again */
+            int round = 0;
+            return bench::measure("group.hash", n, 1,
+                [] { return 0; },
+                [&](int&) {
+                    leaf->items().value<int>("VALUE", ++round);
+                    g_sink = root->hash();
+                });
+        }});
+
+        cases.push_back({"dedupe", 1000000, [](std::uint64_t n) {
+            auto source = make_hierarchy(n);
+            /* every round interns a fresh copy, the leaves and their items collapse */
+            return bench::measure("dedupe", n, n,
+                [&] { return source->deep_copy(); },
+                [](treecode::group& tree) { g_sink = treecode::dedupe(tree).groups; });
+        }});
+
+        cases.push_back({"validate", 1000000, [](std::uint64_t n) {
+            /* DID instances of four ELEMENT groups, every required item set */
+            treecode::tmpl tmpl("DIDS");
+            treecode::group did("DID");
+            did.items().add<std::string>("ID")->required();
+            for (int i = 0; i < 4; ++i) did.add(make_element("ELEMENT"));
+            tmpl.add(did);
+            treecode::group root("ROOT");
+            const auto ids = make_ids((n + 4) / 5);
+            for (const auto& id : ids) {
+                auto instance = tmpl.clone_ptr("DID");
+                instance->items().value<std::string>("ID", id);
+                for (const auto& element : instance->children()) element->items().value<std::string>("NAME", id);
+                root.add(instance);
+            }
+            const treecode::validator checks(tmpl);
+            return bench::measure("validate", n, ids.size() * 5,
+                [] { return 0; },
+                [&](int&) { g_sink = checks.run(root, treecode::parallel{}).groups; });
+        }});
+
+        return cases;
+    }
+
+    void usage(const char* argv0) {
+        std::cerr << "Usage: " << argv0 << " [--min-size N] [--max-size N] [--filter TEXT] [--out FILE]\n"
+                  << "Runs the TreeCode benchmarks at sizes 10, 100, ..., max-size (default 10000000)\n"
+                  << "and writes the results as JSON to FILE or to the standard output.\n";
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    options opts;
+    for (int i = 1; i < argc; ++i) {
+        auto next = [&]() -> const char* {
+            if (i + 1 >= argc) { usage(argv[0]); std::exit(2); }
+            return argv[++i];
+        };
+        if (!std::strcmp(argv[i], "--min-size")) opts.min_size = std::stoull(next());
+        else if (!std::strcmp(argv[i], "--max-size")) opts.max_size = std::stoull(next());
+        else if (!std::strcmp(argv[i], "--filter")) opts.filter = next();
+        else if (!std::strcmp(argv[i], "--out")) opts.out = next();
+        else { usage(argv[0]); return !std::strcmp(argv[i], "--help") ? 0 : 2; }
+    }
+
+    try {
+        bench::report report;
+        for (const auto& bc : make_cases()) {
+            if (!opts.filter.empty() && std::string(bc.name).find(opts.filter) == std::string::npos) continue;
+            for (std::uint64_t n = 10; n <= opts.max_size && n <= bc.limit; n *= 10) {
+                if (n < opts.min_size) continue;
+                report.add(bc.run(n));
+            }
+        }
+
+        if (opts.out.empty()) report.write_json(std::cout);
+        else {
+            std::ofstream file(opts.out);
+            if (!file) {
+                std::cerr << "[Error] " << treecode::Exception::FILE_OPEN_ERROR << " " << opts.out << std::endl;
+                return 1;
+            }
+            report.write_json(file);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[Error] " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -21,8 +21,8 @@ treecode::tmpl create_tmpl() {
 
 
     // Add DID & ELEMENT to the "DidTmpl" template
-    tmpl.add(did_group);
-    tmpl.add(ele_group);
+    tmpl.add(std::move(did_group));
+    tmpl.add(std::move(ele_group));
 
     return tmpl;
 }
@@ -43,21 +43,21 @@ int main() {
         // Add elements to the DID
         elem = tmpl.clone("ELEMENT");
         elem.items().get<std::string>("NAME")->value("Interface1");
-        did.add(elem);
+        did.add(std::move(elem));
         // Add elements to the DID
         elem = tmpl.clone("ELEMENT");
         elem.items().get<std::string>("NAME")->value("Interface2");
         elem.items().get<std::string>("TYPE")->value("uint16");
         elem.items().get<bool>("SHARED")->value(true);
         elem.items().get<int>("VALUE")->value(350);
-        did.add(elem);
+        did.add(std::move(elem));
         // Add elements to the DID
         elem = tmpl.clone("ELEMENT");
         elem.items().get<std::string>("NAME")->value("Interface3");
         elem.items().get<std::string>("TYPE")->value("uint16");
-        did.add(elem);
+        did.add(std::move(elem));
         // Add the instance to the root group
-        did_tree.add(did);
+        did_tree.add(std::move(did));
 
 
         // Modify instance2 of DID
@@ -76,9 +76,9 @@ int main() {
         elem.items().get<std::string>("NAME")->value("Interface4");
         elem.items().get<std::string>("TYPE")->value("uint16");
         elem.items().get<int>("VALUE")->value(200);
-        did.add(elem);
+        did.add(std::move(elem));
         // Add the instance to the root group
-        did_tree.add(did);
+        did_tree.add(std::move(did));
 
 
         // Modify instance3 of DID
@@ -86,7 +86,7 @@ int main() {
         did.items().get<std::string>("ID")->value("FD11");
         did.items().get<std::string>("TYPE")->value("NORMAL");
         // Add the instance to the root group
-        did_tree.add(did);
+        did_tree.add(std::move(did));
 
 
         // Print Tree
@@ -0,0 +1,304 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file child_index.cpp
+ * @class child_index
+ * @brief Implementation file for the child_index class.
+ * @ingroup Core
+ *
+ * This file contains the implementation of the child_index class, which keeps
+ * the value indexes of a group up to date through the observer notifications
+ * of its children.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the child_index class
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/child_index.hpp"
+#include "includes/group.hpp"
+
+namespace treecode {
+    /**
+     * @brief Destructor, stops observing the children.
+     */
+    child_index::~child_index() {
+        for (auto& m : this->__members) this->__release(m.second);
+    }
+
+
+    /**
+     * @brief Defines an index, replacing an index of another kind on the same key.
+     * @param id The indexed key.
+     * @param kind The kind of index.
+     * @param children The current children of the group.
+     */
+    void child_index::define(
+        const key& id,
+        index_kind kind,
+        const std::pmr::vector<std::shared_ptr<group>>& children
+    ) {
+        const std::size_t existing = this->__find(id);
+        if (existing != this->__indexes.size()) {
+            if (this->__indexes[existing].kind == kind) return;
+            this->drop(id);
+        }
+
+        /* the first index starts following the children */
+        if (this->__indexes.empty()) {
+            this->__indexes.push_back({id, kind, {}, {}});
+            for (const auto& child : children) this->attach(child);
+            return;
+        }
+
+        this->__indexes.push_back({id, kind, {}, {}});
+        const std::size_t pos = this->__indexes.size() - 1;
+        for (auto& m : this->__members) {
+            m.second.values.emplace_back();
+            m.second.items.push_back(nullptr);
+            this->__refresh(m.second, pos);
+        }
+    }
+
+
+    /**
+     * @brief Drops the index of a key.
+     * @param id The indexed key.
+     * @return True if an index was dropped.
+     */
+    bool child_index::drop(
+        const key& id
+    ) {
+        const std::size_t pos = this->__find(id);
+        if (pos == this->__indexes.size()) return false;
+        for (auto& m : this->__members) {
+            this->__forget(m.second, pos);
+            m.second.values.erase(m.second.values.begin() + pos);
+            m.second.items.erase(m.second.items.begin() + pos);
+        }
+        this->__indexes.erase(this->__indexes.begin() + pos);
+        return true;
+    }
+
+
+    /**
+     * @brief Gets the kind of the index of a key.
+     * @param id The indexed key.
+     * @return The kind, empty if the key is not indexed.
+     */
+    std::optional<index_kind> child_index::kind(
+        const key& id
+    ) const {
+        const std::size_t pos = this->__find(id);
+        if (pos == this->__indexes.size()) return std::nullopt;
+        return this->__indexes[pos].kind;
+    }
+
+
+    /**
+     * @brief Checks if no index is defined.
+     * @return True if no index is defined.
+     */
+    bool child_index::empty() const { return this->__indexes.empty(); }
+
+
+    /**
+     * @brief Starts following a child added to the group.
+     * @param child The child.
+     */
+    void child_index::attach(
+        const std::shared_ptr<group>& child
+    ) {
+        if (!child) return;
+        container& items = child->items();
+        auto inserted = this->__members.emplace(&items, member{child, {}, {}});
+        if (!inserted.second) return;
+
+        member& m = inserted.first->second;
+        m.values.resize(this->__indexes.size());
+        m.items.resize(this->__indexes.size(), nullptr);
+        items.observe(this);
+        for (std::size_t pos = 0; pos < this->__indexes.size(); ++pos) this->__refresh(m, pos);
+    }
+
+
+    /**
+     * @brief Stops following a child removed from the group.
+     * @param child The child.
+     */
+    void child_index::detach(
+        const std::shared_ptr<group>& child
+    ) {
+        if (!child) return;
+        auto it = this->__members.find(&child->items());
+        if (it == this->__members.end()) return;
+
+        member& m = it->second;
+        for (std::size_t pos = 0; pos < this->__indexes.size(); ++pos) this->__unfile(m, pos);
+        this->__release(m);
+        this->__members.erase(it);
+    }
+
+
+    /**
+     * @brief Follows the value change of an observed item.
+     * @param item The item.
+     */
+    void child_index::changed(
+        const base& item
+    ) {
+        auto it = this->__items.find(&item);
+        if (it == this->__items.end()) return;
+        member& m = this->__members.at(it->second);
+        for (std::size_t pos = 0; pos < this->__indexes.size(); ++pos)
+            if (m.items[pos] == &item) this->__refresh(m, pos);
+    }
+
+
+    /**
+     * @brief Follows the change of a slot of an observed container.
+     * @param items The container.
+     * @param id The key of the slot.
+     */
+    void child_index::changed(
+        const container& items,
+        const key& id
+    ) {
+        const std::size_t pos = this->__find(id);
+        if (pos == this->__indexes.size()) return;
+        auto it = this->__members.find(&items);
+        if (it != this->__members.end()) this->__refresh(it->second, pos);
+    }
+
+
+    /**
+     * @brief Gets the position of the index of a key.
+     * @param id The indexed key.
+     * @return The position, __indexes.size() if the key is not indexed.
+     */
+    std::size_t child_index::__find(
+        const key& id
+    ) const {
+        std::size_t pos = 0;
+        while (pos < this->__indexes.size() && this->__indexes[pos].id != id) ++pos;
+        return pos;
+    }
+
+
+    /**
+     * @brief Brings the entry of a child in an index up to date with its slot.
+     * @param m The child.
+     * @param pos The position of the index.
+     */
+    void child_index::__refresh(
+        member& m,
+        std::size_t pos
+    ) {
+        index& idx = this->__indexes[pos];
+        container& items = m.node->items();
+        auto view = items.find(idx.id);
+
+        value current = view ? view->value() : value();
+        if (current != m.values[pos]) {
+            /* take the old entry out, then file the child under its new value */
+            this->__unfile(m, pos);
+            if (current.has_value()) {
+                if (idx.kind == index_kind::hash) idx.hashed.emplace(current, &m);
+                else idx.ordered.emplace(current, &m);
+            }
+            m.values[pos] = std::move(current);
+        }
+
+        /* observe the item now held under the key, a shared item is copied by observe first */
+        const base* held = view && !view->is_inline() ? view->ptr().get() : nullptr;
+        if (held == m.items[pos]) return;
+        /* the previous item left the slot, the container detached it */
+        this->__items.erase(m.items[pos]);
+        m.items[pos] = nullptr;
+        if (!held) return;
+        items.observe(idx.id, this);
+        held = items.find(idx.id)->ptr().get();
+        m.items[pos] = held;
+        this->__items[held] = &items;
+    }
+
+
+    /**
+     * @brief Takes a child out of an index.
+     * @param m The child.
+     * @param pos The position of the index.
+     */
+    void child_index::__unfile(
+        member& m,
+        std::size_t pos
+    ) {
+        index& idx = this->__indexes[pos];
+        if (!m.values[pos].has_value()) return;
+        if (idx.kind == index_kind::hash) {
+            auto found = idx.hashed.equal_range(m.values[pos]);
+            for (auto it = found.first; it != found.second; ++it) if (it->second == &m) { idx.hashed.erase(it); break; }
+        } else {
+            auto found = idx.ordered.equal_range(m.values[pos]);
+            for (auto it = found.first; it != found.second; ++it) if (it->second == &m) { idx.ordered.erase(it); break; }
+        }
+        m.values[pos].reset();
+    }
+
+
+    /**
+     * @brief Stops observing the item a child holds for an index.
+     * @param m The child.
+     * @param pos The position of the index.
+     */
+    void child_index::__forget(
+        member& m,
+        std::size_t pos
+    ) {
+        const base* held = m.items[pos];
+        if (!held) return;
+        m.items[pos] = nullptr;
+        this->__items.erase(held);
+        /* the observed item is the one still held under the key, the container detaches the others */
+        auto view = m.node->items().find(this->__indexes[pos].id);
+        if (view && view->ptr().get() == held) view->ptr()->unobserve(this);
+    }
+
+
+    /**
+     * @brief Stops observing a child and its items.
+     * @param m The child.
+     */
+    void child_index::__release(
+        member& m
+    ) {
+        for (std::size_t pos = 0; pos < this->__indexes.size(); ++pos) this->__forget(m, pos);
+        container& items = m.node->items();
+        items.unobserve(this);
+    }
+} // namespace treecode
@@ -41,21 +41,173 @@
  * @brief Include necessary headers
 */
 #include "includes/container.hpp"
+#include "includes/group.hpp"
+
+#include <mutex>
+
+namespace {
+    /**
+     * @brief The lock stripe guarding the owner links of an item.
+     */
+    std::mutex& owner_stripe(
+        const void* item
+    ) {
+        static std::mutex stripes[64];
+        return stripes[(reinterpret_cast<std::uintptr_t>(item) >> 4) % 64];
+    }
+}
 
 namespace treecode {
+    /**
+     * @brief Constructs an empty container allocating from a memory resource.
+     * @param resource The memory resource for the entries and the items added later.
+     */
+    container::container(
+        std::pmr::memory_resource* resource
+    ) : __entries(resource),
+        __index(resource) {}
+
+
+    /**
+     * @brief Copies a container into a memory resource.
+     * @param other The container to copy.
+     * @param resource The memory resource for the copy.
+     */
+    container::container(
+        const container& other,
+        std::pmr::memory_resource* resource
+    ) : __entries(other.__entries, resource),
+        __index(other.__index, resource),
+        __holes(other.__holes) {
+        this->__adopt_copies();
+    }
+
+
+    /**
+     * @brief Copy constructor, the copy allocates from the default resource.
+     * @param other The container to copy.
+     */
+    container::container(
+        const container& other
+    ) : container(other, std::pmr::get_default_resource()) {}
+
+
+    /**
+     * @brief Move constructor, the items owned by the other container are taken over.
+     * @param other The container to move.
+     */
+    container::container(
+        container&& other
+    ) noexcept : __entries(std::move(other.__entries)),
+        __index(std::move(other.__index)),
+        __holes(other.__holes) {
+        other.__holes = 0;
+        this->__adopt_from(&other);
+    }
+
+
+    /**
+     * @brief Copy assignment, the container keeps its resource and shares the items.
+     * @param other The container to copy.
+     * @return This container.
+     */
+    container& container::operator=(
+        const container& other
+    ) {
+        if (this == &other) return *this;
+        this->__release();
+        this->__entries = other.__entries;
+        this->__index = other.__index;
+        this->__holes = other.__holes;
+        this->__adopt_copies();
+        this->__touched();
+        return *this;
+    }
+
+
+    /**
+     * @brief Move assignment, the items owned by the other container are taken over.
+     * @param other The container to move.
+     * @return This container.
+     */
+    container& container::operator=(
+        container&& other
+    ) {
+        if (this == &other) return *this;
+        this->__release();
+        this->__entries = std::move(other.__entries);
+        this->__index = std::move(other.__index);
+        this->__holes = other.__holes;
+        other.__entries.clear();
+        other.__index.clear();
+        other.__holes = 0;
+        this->__adopt_from(&other);
+        this->__touched();
+        return *this;
+    }
+
+
+    /**
+     * @brief Destructor, items held elsewhere outlive the container without an owner.
+     */
+    container::~container() {
+        this->__release();
+    }
+
+
+    /**
+     * @brief Moves a container into a memory resource.
+     * @param other The container to move.
+     * @param resource The memory resource of the result.
+     */
+    container::container(
+        container&& other,
+        std::pmr::memory_resource* resource
+    ) : __entries(std::move(other.__entries), resource),
+        __index(std::move(other.__index), resource),
+        __holes(other.__holes) {
+        other.__entries.clear();
+        other.__index.clear();
+        other.__holes = 0;
+        this->__adopt_from(&other);
+    }
+
+
+    /**
+     * @brief Gets the memory resource the container allocates from.
+     * @return The memory resource of the container.
+     */
+    std::pmr::memory_resource* container::resource() const {
+        return this->__entries.get_allocator().resource();
+    }
+
+
+    /**
+     * This method is overloaded to allow for adding items by
+     * precomputed key or by key string.
+     */
+    /**
+     * @brief Adds an item to the container.
+     * @param key The key for the item.
+     * @param ptr A shared pointer to the item.
+     * @return A shared pointer to the added item.
+     */
     std::shared_ptr<base> container::add(
-        const std::string& key,
+        const key& key,
         const std::shared_ptr<base>& ptr
     ) {
-        /* try to add the item to the container */
-        auto result = this->__items.try_emplace(key, ptr);
-        /* throw an exception if the key already exists */
-        if (!result.second) Exception::Throw::Invalid(key, Exception::CONTAINER_KEY_ALREADY_EXISTS);
-        /* add the key to the list of keys */
-        this->__keys.emplace_back(key);
+        /* add the item to the container, throws if the key already exists */
+        this->__insert(key, ptr, ptr ? ptr->tag() : type_tag::none);
         return ptr;
     }
 
+    std::shared_ptr<base> container::add(
+        std::string_view key,
+        const std::shared_ptr<base>& ptr
+    ) {
+        return this->add(treecode::key(key), ptr);
+    }
+
 
     /**
      * This method is overloaded to allow for getting items by key
@@ -67,50 +219,225 @@ namespace treecode {
      * @return Pointer to the item with the specified key.
      * @throws std::out_of_range if the key is not found in the container.
      */
-    #define GET_ELEMENT_IMPL() \
-        /* find the item with the specified key */ \
-        auto it = this->__items.find(key); \
-        /* return the item if found */ \
-        if (it != this->__items.end()) return it->second; \
-        /* throw an exception if the key is not found */ \
-        Exception::Throw::Range(key, Exception::CONTAINER_KEY_NOT_FOUND); \
-        throw std::runtime_error("Unreachable code"); /* unreachable code */
+    #define GET_ELEMENT_IMPL(SLOT) \
+        /* find the item with the specified key, throws if the key is not found */ \
+        entry& e = SLOT; \
+        /* materialise inline slots into an item */ \
+        if (e.is_inline) { this->__materialise(e); this->__changed(e.id); } \
+        /* shared items are copied before an access that can write to them */ \
+        else if (e.shared) { this->__own(e); this->__changed(e.id); } \
+        return e.ptr;
 
 
     /* non-constant version of the method */
-    std::shared_ptr<base>& container::get(
-        const std::string& key
+    const std::shared_ptr<base>& container::get(
+        const key& key
+    ) { 
+        GET_ELEMENT_IMPL(this->__slot(key))
+    }
+
+    const std::shared_ptr<base>& container::get(
+        std::string_view key
     ) { 
-        GET_ELEMENT_IMPL() 
+        GET_ELEMENT_IMPL(this->__slot(key))
     }
 
-    /* constant version of the method */
+    /* constant version of the method, the entries are mutable */
     const std::shared_ptr<base>& container::get(
-        const std::string& key
+        const key& key
     ) const { 
-        GET_ELEMENT_IMPL()
+        GET_ELEMENT_IMPL(const_cast<entry&>(this->__slot(key)))
+    }
+
+    const std::shared_ptr<base>& container::get(
+        std::string_view key
+    ) const { 
+        GET_ELEMENT_IMPL(const_cast<entry&>(this->__slot(key)))
     }
 
 
+    /**
+     * @brief Clears the value stored under a key.
+     * @param key The key of the slot.
+     * @throws std::out_of_range if the key is not found.
+     */
+    #define CLEAR_VALUE_IMPL() \
+        entry& e = this->__slot(key); \
+        if (e.is_inline) { \
+            e.val.reset(); \
+            this->__changed(e.id); \
+            return; \
+        } \
+        if (e.shared) { this->__own(e); this->__changed(e.id); } \
+        /* item slots of the inline types are cleared through their item<T> */ \
+        const bool cleared = dispatch_tag(e.tag, [&e](auto t) { \
+            using T = typename decltype(t)::type; \
+            if constexpr (std::is_void_v<T>) return false; \
+            else { static_cast<item<T>*>(e.ptr.get())->clear_value(); return true; } \
+        }); \
+        if (!cleared) Exception::Throw::Invalid(__label(key), Exception::ELEMENT_INVALID_TYPE);
+
+    void container::clear_value(const key& key) {
+        CLEAR_VALUE_IMPL()
+    }
+
+    void container::clear_value(std::string_view key) {
+        CLEAR_VALUE_IMPL()
+    }
+
+
+    /**
+     * @brief Sets the slot stored under a key as required.
+     * @param key The key of the slot.
+     * @throws std::out_of_range if the key is not found.
+     */
+    #define REQUIRED_IMPL() \
+        entry& e = this->__slot(key); \
+        if (e.is_inline) e.required = true; \
+        else if (e.ptr) { \
+            if (e.shared) { this->__own(e); this->__changed(e.id); } \
+            e.ptr->required(); \
+        } \
+        /* the required flag is a part of the content, items added to another container first do not tell this one */ \
+        this->__touched();
+
+    void container::required(const key& key) {
+        REQUIRED_IMPL()
+    }
+
+    void container::required(std::string_view key) {
+        REQUIRED_IMPL()
+    }
+
+
+    /**
+     * @brief Checks if the slot stored under a key is required.
+     * @param key The key of the slot.
+     * @return True if the slot is required, false otherwise.
+     */
+    bool container::is_required(const key& key) const {
+        return item_view(this->__slot(key)).is_required();
+    }
+
+    bool container::is_required(std::string_view key) const {
+        return item_view(this->__slot(key)).is_required();
+    }
+
+
+    /**
+     * @brief Gets a read-only view on the slot stored under a key.
+     * @param key The key of the slot.
+     * @return The view on the slot.
+     */
+    container::item_view container::view(const key& key) const {
+        return item_view(this->__slot(key));
+    }
+
+    container::item_view container::view(std::string_view key) const {
+        return item_view(this->__slot(key));
+    }
+
+
+    /**
+     * @brief Looks up the slot stored under a key without throwing.
+     * @param key The key of the slot.
+     * @return The view on the slot, empty if the key is not found.
+     */
+    std::optional<container::item_view> container::find(const key& key) const {
+        const std::size_t pos = this->__find(key);
+        if (pos == npos) return std::nullopt;
+        return item_view(this->__entries[pos]);
+    }
+
+    std::optional<container::item_view> container::find(std::string_view key) const {
+        const std::size_t pos = this->__find(key);
+        if (pos == npos) return std::nullopt;
+        return item_view(this->__entries[pos]);
+    }
+
+
+    /**
+     * @brief Attaches an observer notified after each change of a slot.
+     * @param watcher The observer.
+     */
+    void container::observe(
+        observer* watcher
+    ) {
+        this->__observer.add(watcher);
+    }
+
+
+    /**
+     * @brief Attaches an observer to the item of a slot.
+     * @param key The key of the slot.
+     * @param watcher The observer.
+     * @throws std::out_of_range if the key is not found.
+     */
+    void container::observe(
+        const key& key,
+        observer* watcher
+    ) {
+        entry& e = this->__slot(key);
+        if (e.is_inline || !e.ptr) return;
+        /* the copy holds the same value, the observer is not notified of it */
+        if (e.shared) this->__own(e);
+        e.ptr->observe(watcher);
+    }
+
+
+    /**
+     * @brief Detaches an observer.
+     * @param watcher The observer.
+     */
+    void container::unobserve(
+        const observer* watcher
+    ) {
+        this->__observer.remove(watcher);
+    }
+
+
+    /**
+     * @brief Checks if any observer, or a given one, is attached to the container.
+     * @param watcher The observer.
+     * @return True if the observer is attached.
+     */
+    bool container::observed() const { return !this->__observer.empty(); }
+    bool container::observed_by(const observer* watcher) const { return this->__observer.contains(watcher); }
+
+
     /**
      * @brief Gets the keys of the items in the container.
      * @return A vector of keys in the container.
      */
     std::vector<std::string> container::keys() const {
         /* return an empty vector if the container is empty */
-        if(this->__keys.empty()) return {};
-        /* return the keys */
-        return this->__keys;
+        if (this->size() == 0) return {};
+        /* collect the keys in insertion order, skipping removed slots */
+        std::vector<std::string> keys;
+        keys.reserve(this->size());
+        for (const auto& e : this->__entries) if (e.live) keys.emplace_back(e.id.str());
+        return keys;
     }
 
 
+    /**
+     * @brief Gets a view on the keys of the container.
+     * @return A range of the interned keys in insertion order.
+     */
+    container::key_view container::keys_view() const { return key_view(*this); }
+
+
     /**
      * @brief Checks if an item with the specified key exists in the container.
      * @param key The key to check for existence.
      * @return True if the key exists in the container, false otherwise.
      */
-    bool container::exists(const std::string& key) const {
-        return this->__items.count(key) > 0;
+    bool container::exists(const key& key) const {
+        return this->__find(key) != npos;
+    }
+
+    bool container::exists(std::string_view key) const {
+        return this->__find(key) != npos;
     }
 
 
@@ -120,17 +447,479 @@ namespace treecode {
      * @param key The key of the item to remove.
      * @return True if the item was removed, false otherwise.
      */
-    bool container::remove(const std::string& key) {
-        /* find the item with the specified key */
-        auto it = this->__items.find(key);
-        /* remove the item if found */
-        if (it != this->__items.end()) {
-            this->__items.erase(it);
-            /* remove the key from the list of keys */
-            this->__keys.erase(
-                std::remove(this->__keys.begin(), this->__keys.end(), key), this->__keys.end()
-            );
-            return true;
-        } else return false;
+    #define REMOVE_ELEMENT_IMPL() \
+        std::size_t pos = npos, bucket = npos; \
+        if (this->__index.empty()) { \
+            /* small container: linear scan */ \
+            pos = this->__find(key); \
+            if (pos == npos) return false; \
+        } else { \
+            /* large container: find the bucket holding the entry */ \
+            bucket = this->__find_bucket(key); \
+            if (bucket == npos) return false; \
+            pos = this->__index[bucket] - 1; \
+        } \
+        const treecode::key id = this->__entries[pos].id; \
+        this->__erase(pos, bucket); \
+        this->__changed(id); \
+        return true;
+
+    bool container::remove(const key& key) {
+        REMOVE_ELEMENT_IMPL()
+    }
+
+    bool container::remove(std::string_view key) {
+        REMOVE_ELEMENT_IMPL()
+    }
+
+
+    /**
+     * @brief Gets the number of items in the container.
+     * @return The number of items.
+     */
+    std::size_t container::size() const {
+        return this->__entries.size() - this->__holes;
+    }
+
+
+    /**
+     * @brief Creates an independent copy of the container.
+     * @param resource The memory resource of the copy, null for the default resource.
+     * @param mode clone_mode::shared to share the items until their first write.
+     * @return The copy of the container.
+     */
+    container container::clone(
+        std::pmr::memory_resource* resource,
+        clone_mode mode
+    ) const {
+        container copy(resource ? resource : std::pmr::get_default_resource());
+        if (this->__holes == 0) {
+            /* without holes the slots are copied in bulk and the index as is */
+            copy.__entries.assign(this->__entries.begin(), this->__entries.end());
+            copy.__index.assign(this->__index.begin(), this->__index.end());
+        } else {
+            copy.__entries.reserve(this->size());
+            for (const auto& e : this->__entries) if (e.live) copy.__entries.push_back(e);
+            if (copy.__entries.size() > SMALL_LIMIT) {
+                std::size_t buckets = SMALL_LIMIT * 4;
+                while (copy.__entries.size() * 2 > buckets) buckets *= 2;
+                copy.__rehash(buckets);
+            }
+        }
+        /* inline slots are a plain copy, items are cloned or shared until their first write */
+        for (auto& c : copy.__entries) {
+            if (!c.ptr) continue;
+            if (mode == clone_mode::shared) c.shared = true;
+            else {
+                c.ptr = c.ptr->clone(resource);
+                copy.__adopt(c.ptr);
+                c.shared = false;
+            }
+        }
+        return copy;
+    }
+
+
+    /**
+     * @brief Inserts an item under a new key.
+     * @param key The key for the item.
+     * @param ptr A shared pointer to the item.
+     * @param tag The type tag of the item.
+     * @throws std::invalid_argument if the key already exists.
+     */
+    void container::__insert(
+        const key& key,
+        const std::shared_ptr<base>& ptr,
+        type_tag tag
+    ) {
+        entry e;
+        e.id = key;
+        e.ptr = ptr;
+        e.tag = tag;
+        this->__insert(std::move(e));
+        this->__adopt(ptr);
+    }
+
+
+    /**
+     * @brief Inserts a slot under a new key.
+     * @param e The slot, its key and hash are taken from e.id.
+     * @throws std::invalid_argument if the key already exists.
+     */
+    void container::__insert(
+        entry&& e
+    ) {
+        /* throw an exception if the key already exists */
+        if (this->__find(e.id) != npos) Exception::Throw::Invalid(e.id.str(), Exception::CONTAINER_KEY_ALREADY_EXISTS);
+
+        e.hash = e.id.hash();
+        e.live = true;
+        this->__entries.push_back(std::move(e));
+        if (this->__index.empty()) {
+            /* switch to the indexed representation once the small limit is exceeded */
+            if (this->size() > SMALL_LIMIT) this->__rehash(SMALL_LIMIT * 4);
+        } else if (this->size() * 2 > this->__index.size()) {
+            /* keep the load factor at or below one half */
+            this->__rehash(this->__index.size() * 2);
+        } else {
+            const std::size_t mask = this->__index.size() - 1;
+            std::size_t i = this->__entries.back().hash & mask;
+            while (this->__index[i]) i = (i + 1) & mask;
+            this->__index[i] = static_cast<std::uint32_t>(this->__entries.size());
+        }
+        this->__changed(this->__entries.back().id);
+    }
+
+
+    /**
+     * @brief Builds an item<T> holding the value and required flag of an inline slot.
+     * @param e The inline slot, left unchanged.
+     * @return The new item, null for slots of no inline type.
+     */
+    std::shared_ptr<base> container::__detach(
+        const entry& e
+    ) const {
+        return dispatch_tag(e.tag, [this, &e](auto t) -> std::shared_ptr<base> {
+            using T = typename decltype(t)::type;
+            if constexpr (std::is_void_v<T>) return nullptr;
+            else {
+                auto itemPtr = make_shared_in<item<T>>(this->resource());
+                if (const T* v = e.val.template get_if<T>()) itemPtr->value(*v);
+                if (e.required) itemPtr->required();
+                return itemPtr;
+            }
+        });
+    }
+
+
+    /**
+     * @brief Turns an inline slot into an item slot holding an equivalent item<T>.
+     * @param e The slot to materialise.
+     */
+    void container::__materialise(
+        entry& e
+    ) const {
+        e.ptr = this->__detach(e);
+        this->__adopt(e.ptr);
+        e.val.reset();
+        e.required = false;
+        e.is_inline = false;
+    }
+
+
+    /**
+     * @brief Replaces the shared item of a slot by a private copy.
+     * @param e The slot to own.
+     */
+    void container::__own(
+        entry& e
+    ) const {
+        e.ptr = e.ptr->clone(this->resource());
+        this->__adopt(e.ptr);
+        e.shared = false;
+    }
+
+
+    /**
+     * @brief Drops the cached hash of the group holding the container.
+     */
+    void container::__touched() const {
+        if (this->__group.ptr) this->__group.ptr->__invalidate();
+    }
+
+
+    /**
+     * @brief Forwards a change of an owned item to its containers.
+     * @param item The changed item.
+     */
+    void base::__touch(
+        const base& item
+    ) {
+        /* dropping hashes takes the group link stripes, never the other way around */
+        std::lock_guard<std::mutex> lock(owner_stripe(&item));
+        item.__owner.each([](const container* owner) { owner->__touched(); });
+    }
+
+
+    /**
+     * @brief Links the container as an owner of an item held by one more of its slots.
+     * @param ptr The item, may be null.
+     */
+    void container::__adopt(
+        const std::shared_ptr<base>& ptr
+    ) const {
+        if (!ptr) return;
+        std::lock_guard<std::mutex> lock(owner_stripe(ptr.get()));
+        ptr->__owner.add(this);
+    }
+
+
+    /**
+     * @brief Drops one link of the container as an owner of an item.
+     * @param ptr The item, may be null.
+     */
+    void container::__disown(
+        const std::shared_ptr<base>& ptr
+    ) const {
+        if (!ptr) return;
+        std::lock_guard<std::mutex> lock(owner_stripe(ptr.get()));
+        ptr->__owner.remove(this);
+    }
+
+
+    /**
+     * @brief Takes over the items owned by a container moved into this one.
+     * @param from The moved container.
+     */
+    void container::__adopt_from(
+        const container* from
+    ) {
+        for (auto& e : this->__entries) {
+            if (!e.ptr || e.shared) continue;
+            std::lock_guard<std::mutex> lock(owner_stripe(e.ptr.get()));
+            e.ptr->__owner.replace(from, this);
+        }
+    }
+
+
+    /**
+     * @brief Links the container as an owner of the items of the slots, shared with the
+     *        container they were copied from. Items the source shares with the container
+     *        it was cloned from stay shared and are copied on their first write.
+     */
+    void container::__adopt_copies() {
+        for (const auto& e : this->__entries) if (!e.shared) this->__adopt(e.ptr);
+    }
+
+
+    /**
+     * @brief Releases the ownership of the items of the slots.
+     */
+    void container::__release() {
+        for (const auto& e : this->__entries) if (!e.shared) this->__disown(e.ptr);
+    }
+
+
+    /**
+     * This method is overloaded to allow for finding entries by
+     * precomputed key or by key string.
+     */
+    /**
+     * @brief Finds the entry position of a key.
+     * @param key The key to find.
+     * @return The position in the entry array, npos if not found.
+     */
+    std::size_t container::__find(
+        const key& key
+    ) const {
+        if (this->__index.empty()) {
+            /* small container: compare atoms */
+            for (std::size_t pos = 0; pos < this->__entries.size(); ++pos) {
+                const auto& e = this->__entries[pos];
+                if (e.live && e.id == key) return pos;
+            }
+            return npos;
+        }
+        const std::size_t i = this->__find_bucket(key);
+        return i == npos ? npos : this->__index[i] - 1;
+    }
+
+    std::size_t container::__find(
+        std::string_view key
+    ) const {
+        if (this->__index.empty()) {
+            /* small container: compare the interned strings, no hashing */
+            for (std::size_t pos = 0; pos < this->__entries.size(); ++pos) {
+                const auto& e = this->__entries[pos];
+                if (e.live && e.id.view() == key) return pos;
+            }
+            return npos;
+        }
+        const std::size_t i = this->__find_bucket(key);
+        return i == npos ? npos : this->__index[i] - 1;
+    }
+
+
+    /**
+     * @brief Finds the index bucket holding a key.
+     * @param key The key to find.
+     * @return The bucket position, npos if not found.
+     */
+    std::size_t container::__find_bucket(
+        const key& key
+    ) const {
+        const std::size_t mask = this->__index.size() - 1;
+        for (std::size_t i = key.hash() & mask; this->__index[i]; i = (i + 1) & mask) {
+            if (this->__entries[this->__index[i] - 1].id == key) return i;
+        }
+        return npos;
+    }
+
+    std::size_t container::__find_bucket(
+        std::string_view key
+    ) const {
+        const std::uint32_t hash = key::hash_of(key);
+        const std::size_t mask = this->__index.size() - 1;
+        for (std::size_t i = hash & mask; this->__index[i]; i = (i + 1) & mask) {
+            const auto& e = this->__entries[this->__index[i] - 1];
+            if (e.hash == hash && e.id.view() == key) return i;
+        }
+        return npos;
+    }
+
+
+    /**
+     * @brief Removes the entry at the given position.
+     * @param pos The position in the entry array.
+     * @param bucket The index bucket of the entry, ignored for small containers.
+     */
+    void container::__erase(
+        std::size_t pos,
+        std::size_t bucket
+    ) {
+        if (!this->__index.empty()) {
+            /* delete the bucket by shifting the rest of the probe chain back (no tombstones) */
+            const std::size_t mask = this->__index.size() - 1;
+            std::size_t i = bucket;
+            for (std::size_t j = i;;) {
+                j = (j + 1) & mask;
+                if (!this->__index[j]) break;
+                const std::size_t home = this->__entries[this->__index[j] - 1].hash & mask;
+                /* leave the bucket in place if its home lies cyclically in (i, j] */
+                if (i <= j ? (i < home && home <= j) : (i < home || home <= j)) continue;
+                this->__index[i] = this->__index[j];
+                i = j;
+            }
+            this->__index[i] = 0;
+        }
+
+        /* turn the slot into a hole, the entry array keeps its insertion order */
+        auto& e = this->__entries[pos];
+        /* an item leaving the container is no longer observed on its behalf */
+        if (e.ptr) this->__observer.each([&e](observer* watcher) { e.ptr->unobserve(watcher); });
+        if (!e.shared) this->__disown(e.ptr);
+        e.live = false;
+        e.ptr.reset();
+        e.val.reset();
+        ++this->__holes;
+
+        /* drop trailing holes right away, compact once holes dominate the array */
+        while (!this->__entries.empty() && !this->__entries.back().live) {
+            this->__entries.pop_back();
+            --this->__holes;
+        }
+        if (this->__holes > SMALL_LIMIT && this->__holes * 2 > this->__entries.size()) this->__compact();
+    }
+
+
+    /**
+     * @brief Rebuilds the index table with the given number of buckets.
+     * @param buckets The number of buckets, a power of two.
+     */
+    void container::__rehash(
+        std::size_t buckets
+    ) {
+        this->__index.assign(buckets, 0);
+        const std::size_t mask = buckets - 1;
+        for (std::size_t pos = 0; pos < this->__entries.size(); ++pos) {
+            if (!this->__entries[pos].live) continue;
+            std::size_t i = this->__entries[pos].hash & mask;
+            while (this->__index[i]) i = (i + 1) & mask;
+            this->__index[i] = static_cast<std::uint32_t>(pos + 1);
+        }
+    }
+
+
+    /**
+     * @brief Removes the holes from the entry array and rebuilds the index table.
+     */
+    void container::__compact() {
+        this->__entries.erase(
+            std::remove_if(this->__entries.begin(), this->__entries.end(), [](const entry& e) { return !e.live; }),
+            this->__entries.end()
+        );
+        this->__holes = 0;
+        if (this->__index.empty()) return;
+        /* fall back to the small representation, or rebuild the index over the new positions */
+        if (this->__entries.size() <= SMALL_LIMIT) {
+            this->__index.clear();
+            this->__index.shrink_to_fit();
+            return;
+        }
+        std::size_t buckets = SMALL_LIMIT * 4;
+        while (this->__entries.size() * 2 > buckets) buckets *= 2;
+        this->__rehash(buckets);
+    }
+
+
+    /**
+     * @brief Gets the key of the slot.
+     * @return The interned key.
+     */
+    const key& container::item_view::id() const { return this->__entry->id; }
+
+
+    /**
+     * @brief Gets the type tag of the slot.
+     * @return The type tag of the stored value.
+     */
+    type_tag container::item_view::tag() const { return this->__entry->tag; }
+
+
+    /**
+     * @brief Checks if the slot stores its value inline.
+     * @return True for inline slots, false for item slots.
+     */
+    bool container::item_view::is_inline() const { return this->__entry->is_inline; }
+
+
+    /**
+     * @brief Checks if the slot still shares its item with the container it was cloned from.
+     * @return True for shared item slots, false otherwise.
+     */
+    bool container::item_view::is_shared() const { return this->__entry->shared; }
+
+
+    /**
+     * @brief Checks if the slot is required.
+     * @return True if the slot is required, false otherwise.
+     */
+    bool container::item_view::is_required() const {
+        if (this->__entry->is_inline) return this->__entry->required;
+        return this->__entry->ptr && this->__entry->ptr->is_required();
+    }
+
+
+    /**
+     * @brief Checks if the slot holds a value.
+     * @return True if a value is set, false otherwise.
+     */
+    bool container::item_view::has_value() const {
+        if (this->__entry->is_inline) return this->__entry->val.has_value();
+        return this->__entry->ptr && this->__entry->ptr->is_value_set();
+    }
+
+
+    /**
+     * @brief Gets the item of the slot.
+     * @return The shared item, null for inline slots.
+     */
+    const std::shared_ptr<base>& container::item_view::ptr() const { return this->__entry->ptr; }
+
+
+    /**
+     * @brief Gets the value of the slot.
+     * @return The value, no value if none is set or the slot holds a user type.
+     */
+    treecode::value container::item_view::value() const {
+        if (this->__entry->is_inline) return this->__entry->val;
+        return dispatch_tag(this->__entry->tag, [this](auto t) {
+            using T = typename decltype(t)::type;
+            if constexpr (std::is_void_v<T>) return treecode::value();
+            else {
+                const T* v = this->get_if<T>();
+                return v ? treecode::value(*v) : treecode::value();
+            }
+        });
     }
 } // namespace treecode
\ No newline at end of file
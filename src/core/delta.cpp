@@ -0,0 +1,695 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file delta.cpp
+ * @class delta
+ * @brief Implementation file for the delta class.
+ * @ingroup Core
+ *
+ * This file contains the encoding of deltas, the comparison of two trees
+ * skipping the subtrees that hash equal, and the replay of a delta.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the delta class
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/delta.hpp"
+
+#include <cstring>
+
+/**
+ * @brief The magic bytes opening every delta, followed by the version byte
+ */
+#define DELTA_MAGIC "TCDL"
+#define DELTA_MAGIC_SIZE 4U
+
+namespace treecode {
+    namespace {
+        /**
+         * @enum op
+         * @brief The operations of a group patch, a patch ends with OP_END.
+         */
+        enum op : std::uint8_t {
+            OP_END = 0,
+            OP_RENAME,              /* name */
+            OP_ITEM_VALUE,          /* key, value or no value to clear it */
+            OP_ITEM_REQUIRED,       /* key */
+            OP_ITEM_ADD,            /* item */
+            OP_ITEM_REMOVE,         /* key */
+            OP_ITEMS,               /* count, items: the items replaced as a whole */
+            OP_CHILD_PATCH,         /* position, patch */
+            OP_CHILD_REMOVE,        /* position, count */
+            OP_CHILD_INSERT         /* position, count, subtrees */
+        };
+
+        /**
+         * @brief The flags of an encoded item.
+         */
+        constexpr std::uint8_t ITEM_REQUIRED = 1;
+        constexpr std::uint8_t ITEM_VALUE = 2;
+        constexpr std::uint8_t ITEM_INLINE = 4;
+        constexpr std::uint8_t ITEM_CHOICES = 8;
+
+
+        /**
+         * @brief Gets the choices of an item slot.
+         * @return The choices, null for inline slots and items without choices.
+         */
+        template <typename T>
+        const std::vector<T>* choices_of(
+            const container::item_view& view
+        ) {
+            /* the tag of an item slot is the tag of its item<T> */
+            return view.is_inline() ? nullptr : static_cast<const treecode::item<T>*>(view.ptr().get())->choices_ptr();
+        }
+
+
+        /**
+         * @class encoder
+         * @brief Appends the encoding of patches to a string.
+         */
+        class encoder {
+        public:
+            explicit encoder(
+                std::string& out
+            ) : __out(out) {}
+
+            void byte(
+                std::uint8_t b
+            ) {
+                this->__out.push_back(static_cast<char>(b));
+            }
+
+            void varint(
+                std::uint64_t v
+            ) {
+                while (v >= 0x80) {
+                    this->byte(static_cast<std::uint8_t>(v | 0x80));
+                    v >>= 7;
+                }
+                this->byte(static_cast<std::uint8_t>(v));
+            }
+
+            void text(
+                std::string_view s
+            ) {
+                this->varint(s.size());
+                this->__out.append(s.data(), s.size());
+            }
+
+
+            /**
+             * @brief Writes a value of an inline type, signed integers zigzag encoded, floating point values little endian.
+             */
+            template <typename T>
+            void scalar(
+                const T& v
+            ) {
+                if constexpr (std::is_same_v<T, std::string>) {
+                    this->text(v);
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    this->byte(v ? 1 : 0);
+                } else if constexpr (std::is_floating_point_v<T>) {
+                    std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t> bits = 0;
+                    std::memcpy(&bits, &v, sizeof(v));
+                    for (std::size_t i = 0; i < sizeof(bits); ++i) this->byte(static_cast<std::uint8_t>(bits >> (8 * i)));
+                } else if constexpr (std::is_signed_v<T>) {
+                    const auto x = static_cast<std::int64_t>(v);
+                    this->varint((static_cast<std::uint64_t>(x) << 1) ^ static_cast<std::uint64_t>(x >> 63));
+                } else {
+                    this->varint(v);
+                }
+            }
+
+
+            /**
+             * @brief Writes a tag and its value, the tag alone for no value.
+             */
+            void value(
+                const treecode::value& v
+            ) {
+                this->byte(static_cast<std::uint8_t>(v.tag()));
+                v.visit([this](const auto& x) {
+                    if constexpr (!std::is_same_v<std::decay_t<decltype(x)>, std::monostate>) this->scalar(x);
+                });
+            }
+
+
+            /**
+             * @brief Writes an item: key, tag, flags, value and choices.
+             */
+            void item(
+                const container::item_view& view
+            ) {
+                this->text(view.id().view());
+                this->byte(static_cast<std::uint8_t>(view.tag()));
+                dispatch_tag(view.tag(), [&](auto t) {
+                    using T = typename decltype(t)::type;
+                    if constexpr (std::is_void_v<T>) {
+                        Exception::Throw::Invalid(view.id().str(), Exception::DELTA_USER_TYPE);
+                    } else {
+                        const T* v = view.get_if<T>();
+                        const std::vector<T>* list = choices_of<T>(view);
+                        this->byte(static_cast<std::uint8_t>(
+                            (view.is_required() ? ITEM_REQUIRED : 0U) | (v ? ITEM_VALUE : 0U) |
+                            (view.is_inline() ? ITEM_INLINE : 0U) | (list ? ITEM_CHOICES : 0U)));
+                        if (v) this->scalar(*v);
+                        if (list) {
+                            this->varint(list->size());
+                            for (const T& choice : *list) this->scalar(choice);
+                        }
+                    }
+                });
+            }
+
+
+            /**
+             * @brief Writes a whole subtree: name, items and children.
+             */
+            void subtree(
+                const group& g
+            ) {
+                this->text(g.name());
+                const container& items = g.items();
+                this->varint(items.size());
+                items.for_each([this](const container::item_view& view) { this->item(view); });
+                const auto& children = g.children();
+                this->varint(children.size());
+                for (const auto& child : children) {
+                    if (!child) Exception::Throw::Invalid(g.name(), Exception::NULL_GROUP);
+                    this->subtree(*child);
+                }
+            }
+
+        private:
+            std::string& __out;
+        };
+
+
+        /**
+         * @class decoder
+         * @brief Reads the encoding of patches, every read is bounds checked.
+         */
+        class decoder {
+        public:
+            decoder(
+                const std::string& in,
+                std::size_t pos
+            ) : __in(in), __pos(pos) {}
+
+            bool done() const { return this->__pos == this->__in.size(); }
+
+            void corrupt() const { Exception::Throw::Runtime("delta", Exception::DELTA_CORRUPT); }
+
+            std::uint8_t byte() {
+                if (this->__pos >= this->__in.size()) this->corrupt();
+                return static_cast<std::uint8_t>(this->__in[this->__pos++]);
+            }
+
+            std::uint64_t varint() {
+                std::uint64_t v = 0;
+                for (unsigned shift = 0; shift < 64; shift += 7) {
+                    const std::uint8_t b = this->byte();
+                    v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+                    if (!(b & 0x80)) return v;
+                }
+                this->corrupt();
+                return 0;
+            }
+
+
+            /**
+             * @brief Reads a count of encoded elements, each one taking at least a byte.
+             */
+            std::size_t count() {
+                const std::uint64_t n = this->varint();
+                if (n > this->__in.size() - this->__pos) this->corrupt();
+                return static_cast<std::size_t>(n);
+            }
+
+            std::string_view text() {
+                const std::size_t size = this->count();
+                std::string_view s(this->__in.data() + this->__pos, size);
+                this->__pos += size;
+                return s;
+            }
+
+            template <typename T>
+            T scalar() {
+                if constexpr (std::is_same_v<T, std::string>) {
+                    return std::string(this->text());
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    return this->byte() != 0;
+                } else if constexpr (std::is_floating_point_v<T>) {
+                    std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t> bits = 0;
+                    for (std::size_t i = 0; i < sizeof(bits); ++i) bits |= static_cast<decltype(bits)>(this->byte()) << (8 * i);
+                    T v;
+                    std::memcpy(&v, &bits, sizeof(v));
+                    return v;
+                } else if constexpr (std::is_signed_v<T>) {
+                    const std::uint64_t z = this->varint();
+                    return static_cast<T>(static_cast<std::int64_t>(z >> 1) ^ -static_cast<std::int64_t>(z & 1));
+                } else {
+                    return static_cast<T>(this->varint());
+                }
+            }
+
+
+            /**
+             * @brief Reads the tag of an inline type, type_tag::none included if allowed.
+             */
+            type_tag tag(
+                bool none
+            ) {
+                const std::uint8_t t = this->byte();
+                if (t > static_cast<std::uint8_t>(type_tag::string) || (!none && t == 0)) this->corrupt();
+                return static_cast<type_tag>(t);
+            }
+
+            treecode::value value() {
+                treecode::value v;
+                dispatch_tag(this->tag(true), [this, &v](auto t) {
+                    using T = typename decltype(t)::type;
+                    if constexpr (!std::is_void_v<T>) v.set(this->scalar<T>());
+                });
+                return v;
+            }
+
+
+            /**
+             * @brief Reads an item and adds it to a container.
+             */
+            void item(
+                container& items
+            ) {
+                const key id(this->text());
+                const type_tag t = this->tag(false);
+                const std::uint8_t flags = this->byte();
+                if (items.exists(id)) Exception::Throw::Runtime(id.str(), Exception::DELTA_MISMATCH);
+                dispatch_tag(t, [&](auto tag) {
+                    using T = typename decltype(tag)::type;
+                    if constexpr (!std::is_void_v<T>) {
+                        std::optional<T> v;
+                        if (flags & ITEM_VALUE) v = this->scalar<T>();
+                        if (flags & ITEM_INLINE) {
+                            if (v) items.add_inline<T>(id, *v);
+                            else items.add_inline<T>(id);
+                            if (flags & ITEM_REQUIRED) items.required(id);
+                            return;
+                        }
+                        std::shared_ptr<treecode::item<T>> slot;
+                        if (flags & ITEM_CHOICES) {
+                            const std::size_t count = this->count();
+                            std::vector<T> list;
+                            list.reserve(count);
+                            for (std::size_t i = 0; i < count; ++i) list.push_back(this->scalar<T>());
+                            slot = items.emplace<T>(id, std::make_shared<const std::vector<T>>(std::move(list)));
+                        } else {
+                            slot = items.emplace<T>(id);
+                        }
+                        if (v) slot->value(*v);
+                        else slot->clear_value();
+                        if ((flags & ITEM_REQUIRED) && !slot->is_required()) slot->required();
+                    }
+                });
+            }
+
+        private:
+            const std::string& __in;
+            std::size_t __pos;
+        };
+
+
+        /**
+         * @brief Checks if two slots of a key differ by more than their value and a required flag being set.
+         */
+        bool replaced(
+            const container::item_view& a,
+            const container::item_view& b
+        ) {
+            if (a.tag() != b.tag() || a.is_inline() != b.is_inline() || (a.is_required() && !b.is_required())) return true;
+            return dispatch_tag(a.tag(), [&](auto t) {
+                using T = typename decltype(t)::type;
+                if constexpr (std::is_void_v<T>) {
+                    return true;
+                } else {
+                    const std::vector<T>* la = choices_of<T>(a);
+                    const std::vector<T>* lb = choices_of<T>(b);
+                    return la != lb && (!la || !lb || *la != *lb);
+                }
+            });
+        }
+
+
+        /**
+         * @brief Checks if two containers hold the same slots in the same order.
+         */
+        bool same_items(
+            const container& a,
+            const container& b
+        ) {
+            if (a.size() != b.size()) return false;
+            std::vector<container::item_view> before, after;
+            before.reserve(a.size());
+            after.reserve(b.size());
+            a.for_each([&before](const container::item_view& view) { before.push_back(view); });
+            b.for_each([&after](const container::item_view& view) { after.push_back(view); });
+            for (std::size_t i = 0; i < before.size(); ++i) {
+                const auto& x = before[i];
+                const auto& y = after[i];
+                if (x.id() != y.id() || x.is_required() != y.is_required() || replaced(x, y)) return false;
+                if (x.value() != y.value()) return false;
+            }
+            return true;
+        }
+
+
+        /**
+         * @brief Checks if two children are the same subtree.
+         *        Equal addresses are the same, otherwise the hash only rules out different
+         *        subtrees and equality is confirmed slot by slot, as the interner does.
+         */
+        bool same(
+            const std::shared_ptr<group>& a,
+            const std::shared_ptr<group>& b
+        ) {
+            if (a == b) return true;
+            if (!a || !b || a->hash() != b->hash()) return false;
+            if (a->name() != b->name() || !same_items(a->items(), b->items())) return false;
+            const auto& ca = a->children();
+            const auto& cb = b->children();
+            if (ca.size() != cb.size()) return false;
+            for (std::size_t i = 0; i < ca.size(); ++i) if (!same(ca[i], cb[i])) return false;
+            return true;
+        }
+
+
+        /**
+         * @brief Writes the item operations turning the items of a group into those of another.
+         *        Keys kept in order with new keys appended become single operations, any other
+         *        change of the order or of a slot replaces the items as a whole.
+         */
+        void patch_items(
+            const container& a,
+            const container& b,
+            encoder& out
+        ) {
+            std::vector<container::item_view> before, after;
+            before.reserve(a.size());
+            after.reserve(b.size());
+            a.for_each([&before](const container::item_view& view) { before.push_back(view); });
+            b.for_each([&after](const container::item_view& view) { after.push_back(view); });
+
+            std::vector<std::pair<container::item_view, container::item_view>> kept;
+            std::vector<key> removed;
+            bool whole = false;
+            for (const auto& view : before) {
+                if (!b.exists(view.id())) {
+                    removed.push_back(view.id());
+                    continue;
+                }
+                const std::size_t pos = kept.size();
+                if (pos >= after.size() || after[pos].id() != view.id() || replaced(view, after[pos])) {
+                    whole = true;
+                    break;
+                }
+                kept.emplace_back(view, after[pos]);
+            }
+            for (std::size_t i = kept.size(); !whole && i < after.size(); ++i) whole = a.exists(after[i].id());
+
+            if (whole) {
+                out.byte(OP_ITEMS);
+                out.varint(after.size());
+                for (const auto& view : after) out.item(view);
+                return;
+            }
+            for (const key& id : removed) {
+                out.byte(OP_ITEM_REMOVE);
+                out.text(id.view());
+            }
+            for (const auto& [from, to] : kept) {
+                const value v = to.value();
+                if (from.value() != v) {
+                    out.byte(OP_ITEM_VALUE);
+                    out.text(to.id().view());
+                    out.value(v);
+                }
+                if (!from.is_required() && to.is_required()) {
+                    out.byte(OP_ITEM_REQUIRED);
+                    out.text(to.id().view());
+                }
+            }
+            for (std::size_t i = kept.size(); i < after.size(); ++i) {
+                out.byte(OP_ITEM_ADD);
+                out.item(after[i]);
+            }
+        }
+
+
+        /**
+         * @brief Writes the patch turning a group into another.
+         */
+        void patch(
+            const group& a,
+            const group& b,
+            encoder& out
+        ) {
+            const std::string name = b.name();
+            if (a.name() != name) {
+                out.byte(OP_RENAME);
+                out.text(name);
+            }
+            patch_items(a.items(), b.items(), out);
+
+            /* the equal ends of the child lists are skipped, the middle is compared by position */
+            const auto& ca = a.children();
+            const auto& cb = b.children();
+            std::size_t prefix = 0;
+            while (prefix < ca.size() && prefix < cb.size() && same(ca[prefix], cb[prefix])) ++prefix;
+            std::size_t suffix = 0;
+            while (suffix < ca.size() - prefix && suffix < cb.size() - prefix &&
+                same(ca[ca.size() - 1 - suffix], cb[cb.size() - 1 - suffix])) ++suffix;
+            const std::size_t na = ca.size() - prefix - suffix;
+            const std::size_t nb = cb.size() - prefix - suffix;
+
+            for (std::size_t i = prefix; i < prefix + std::min(na, nb); ++i) {
+                if (same(ca[i], cb[i])) continue;
+                if (!cb[i]) Exception::Throw::Invalid(name, Exception::NULL_GROUP);
+                if (ca[i] && ca[i]->name() == cb[i]->name()) {
+                    out.byte(OP_CHILD_PATCH);
+                    out.varint(i);
+                    patch(*ca[i], *cb[i], out);
+                } else {
+                    out.byte(OP_CHILD_REMOVE);
+                    out.varint(i);
+                    out.varint(1);
+                    out.byte(OP_CHILD_INSERT);
+                    out.varint(i);
+                    out.varint(1);
+                    out.subtree(*cb[i]);
+                }
+            }
+            const std::size_t tail = prefix + std::min(na, nb);
+            if (na > nb) {
+                out.byte(OP_CHILD_REMOVE);
+                out.varint(tail);
+                out.varint(na - nb);
+            } else if (nb > na) {
+                out.byte(OP_CHILD_INSERT);
+                out.varint(tail);
+                out.varint(nb - na);
+                for (std::size_t i = tail; i < tail + nb - na; ++i) {
+                    if (!cb[i]) Exception::Throw::Invalid(name, Exception::NULL_GROUP);
+                    out.subtree(*cb[i]);
+                }
+            }
+            out.byte(OP_END);
+        }
+    } // namespace
+
+
+    /**
+     * @brief Default constructor, a delta without changes.
+     */
+    delta::delta() {
+        encoder out(this->__bytes);
+        this->__bytes.append(DELTA_MAGIC, DELTA_MAGIC_SIZE);
+        out.byte(VERSION);
+        out.byte(OP_END);
+    }
+
+
+    /**
+     * @brief Takes over an encoded delta.
+     * @param bytes The encoding.
+     */
+    delta::delta(
+        std::string bytes
+    ) : __bytes(std::move(bytes)) {
+        if (this->__bytes.size() <= DELTA_MAGIC_SIZE + 1 || std::memcmp(this->__bytes.data(), DELTA_MAGIC, DELTA_MAGIC_SIZE) != 0 ||
+            static_cast<std::uint8_t>(this->__bytes[DELTA_MAGIC_SIZE]) != VERSION)
+            Exception::Throw::Runtime("delta", Exception::DELTA_CORRUPT);
+    }
+
+
+    /**
+     * @brief Checks if the delta has no changes.
+     * @return True if the root patch is empty.
+     */
+    bool delta::empty() const {
+        return this->__bytes.size() == DELTA_MAGIC_SIZE + 2 && this->__bytes.back() == static_cast<char>(OP_END);
+    }
+
+
+    /**
+     * @brief Computes the changes turning a group tree into another.
+     * @param from The source tree.
+     * @param to The target tree.
+     * @return The delta.
+     */
+    delta delta::diff(
+        const group& from,
+        const group& to
+    ) {
+        delta result;
+        result.__bytes.resize(DELTA_MAGIC_SIZE + 1);
+        encoder out(result.__bytes);
+        patch(from, to, out);
+        return result;
+    }
+
+
+    /**
+     * @brief Replays the delta on a copy of its source tree.
+     * @param target The tree.
+     */
+    void delta::apply(
+        group& target
+    ) const {
+        struct replay {
+            decoder in;
+
+            void mismatch(const std::string& label) const { Exception::Throw::Runtime(label, Exception::DELTA_MISMATCH); }
+
+            std::shared_ptr<group> subtree(
+                std::pmr::memory_resource* resource
+            ) {
+                auto node = make_shared_in<group>(resource, std::string(this->in.text()), resource);
+                for (std::size_t i = this->in.count(); i > 0; --i) this->in.item(node->__container);
+                const std::size_t count = this->in.count();
+                node->__children.reserve(count);
+                /* a new group has no index yet, the name index is built on first use */
+                for (std::size_t i = 0; i < count; ++i) {
+                    node->__children.push_back(this->subtree(resource));
+                    node->__children.back()->__link(node.get());
+                }
+                return node;
+            }
+
+            void operator()(
+                group& g
+            ) {
+                container& items = g.items();
+                for (;;) {
+                    switch (this->in.byte()) {
+                        case OP_END:
+                            return;
+                        case OP_RENAME:
+                            g.__name = std::string(this->in.text());
+                            break;
+                        case OP_ITEM_VALUE: {
+                            const key id(this->in.text());
+                            const value v = this->in.value();
+                            auto view = items.find(id);
+                            if (!view || (v.has_value() && view->tag() != v.tag())) this->mismatch(id.str());
+                            if (!v.has_value()) {
+                                items.clear_value(id);
+                                break;
+                            }
+                            dispatch_tag(v.tag(), [&](auto t) {
+                                using T = typename decltype(t)::type;
+                                if constexpr (!std::is_void_v<T>) items.value<T>(id, *v.get_if<T>());
+                            });
+                            break;
+                        }
+                        case OP_ITEM_REQUIRED: {
+                            const key id(this->in.text());
+                            if (!items.exists(id)) this->mismatch(id.str());
+                            items.required(id);
+                            break;
+                        }
+                        case OP_ITEM_ADD:
+                            this->in.item(items);
+                            break;
+                        case OP_ITEM_REMOVE: {
+                            const key id(this->in.text());
+                            if (!items.remove(id)) this->mismatch(id.str());
+                            break;
+                        }
+                        case OP_ITEMS: {
+                            for (const std::string& id : items.keys()) items.remove(id);
+                            for (std::size_t i = this->in.count(); i > 0; --i) this->in.item(items);
+                            break;
+                        }
+                        case OP_CHILD_PATCH: {
+                            const std::uint64_t pos = this->in.varint();
+                            const auto& children = g.children();
+                            if (pos >= children.size() || !children[pos]) this->mismatch(g.__name);
+                            (*this)(*children[pos]);
+                            break;
+                        }
+                        case OP_CHILD_REMOVE: {
+                            const std::uint64_t pos = this->in.varint();
+                            const std::uint64_t count = this->in.varint();
+                            const std::size_t size = g.children().size();
+                            if (pos > size || count > size - pos) this->mismatch(g.__name);
+                            g.__splice(pos, count, {});
+                            break;
+                        }
+                        case OP_CHILD_INSERT: {
+                            const std::uint64_t pos = this->in.varint();
+                            if (pos > g.children().size()) this->mismatch(g.__name);
+                            std::vector<std::shared_ptr<group>> inserted(this->in.count());
+                            for (auto& child : inserted) child = this->subtree(g.resource());
+                            g.__splice(pos, 0, inserted);
+                            break;
+                        }
+                        default:
+                            this->in.corrupt();
+                    }
+                }
+            }
+        };
+
+        replay run{decoder(this->__bytes, DELTA_MAGIC_SIZE + 1)};
+        run(target);
+        if (!run.in.done()) run.in.corrupt();
+    }
+} // namespace treecode
@@ -41,8 +41,107 @@
  * @brief Include necessary headers
 */
 #include "includes/group.hpp"
+#include "includes/snapshot.hpp"
+#include "includes/interner.hpp"
+
+#include <cstring>
+#include <mutex>
 
 namespace treecode {
+    namespace {
+        /**
+         * @brief Mixes a word into a running hash, the splitmix64 finaliser over the state.
+         */
+        void mix(
+            std::uint64_t& h,
+            std::uint64_t w
+        ) {
+            std::uint64_t x = h ^ w;
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            h = x ^ (x >> 31);
+        }
+
+        void mix_text(
+            std::uint64_t& h,
+            std::string_view s
+        ) {
+            mix(h, s.size());
+            std::size_t i = 0;
+            for (; i + 8 <= s.size(); i += 8) {
+                std::uint64_t w = 0;
+                std::memcpy(&w, s.data() + i, 8);
+                mix(h, w);
+            }
+            if (i < s.size()) {
+                std::uint64_t w = 0;
+                std::memcpy(&w, s.data() + i, s.size() - i);
+                mix(h, w);
+            }
+        }
+
+        template <typename T>
+        void mix_scalar(
+            std::uint64_t& h,
+            const T& v
+        ) {
+            if constexpr (std::is_same_v<T, std::string>) {
+                mix_text(h, v);
+            } else if constexpr (std::is_floating_point_v<T>) {
+                std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t> bits = 0;
+                std::memcpy(&bits, &v, sizeof(v));
+                mix(h, bits);
+            } else {
+                mix(h, static_cast<std::uint64_t>(v));
+            }
+        }
+
+
+        /**
+         * @brief Hashes the items of a container: keys, type tags, flags, values and choices.
+         *        Items of user types have no known content, they hash by address.
+         */
+        std::uint64_t hash_items(
+            const container& items
+        ) {
+            std::uint64_t h = 0x9e3779b97f4a7c15ULL;
+            mix(h, items.size());
+            items.for_each([&h](const container::item_view& view) {
+                mix_text(h, view.id().view());
+                mix(h, static_cast<std::uint64_t>(view.tag()) | (view.is_required() ? 0x100U : 0U) | (view.is_inline() ? 0x200U : 0U));
+                dispatch_tag(view.tag(), [&](auto t) {
+                    using T = typename decltype(t)::type;
+                    if constexpr (std::is_void_v<T>) {
+                        mix(h, reinterpret_cast<std::uintptr_t>(view.ptr().get()));
+                    } else {
+                        const T* v = view.get_if<T>();
+                        mix(h, v != nullptr);
+                        if (v) mix_scalar(h, *v);
+                        /* the tag of an item slot is the tag of its item<T> */
+                        const std::vector<T>* list = view.is_inline() ? nullptr : static_cast<const item<T>*>(view.ptr().get())->choices_ptr();
+                        if (list) {
+                            mix(h, list->size());
+                            for (const T& choice : *list) mix_scalar(h, choice);
+                        }
+                    }
+                });
+            });
+            return h;
+        }
+
+
+        /**
+         * @brief The lock stripe guarding the parent links of a group.
+         */
+        std::mutex& link_stripe(
+            const void* g
+        ) {
+            static std::mutex stripes[64];
+            return stripes[(reinterpret_cast<std::uintptr_t>(g) >> 4) % 64];
+        }
+    }
+
+
     /**
      * @brief Constructor for the group class.
      * @param name The name of the group.
@@ -50,7 +149,149 @@ namespace treecode {
      */
     group::group(
         const std::string& name
-    ) : __name(name) {}
+    ) : __name(name) {
+        this->__container.__group.ptr = this;
+    }
+
+
+    /**
+     * @brief Default constructor for the group class.
+     */
+    group::group() {
+        this->__container.__group.ptr = this;
+    }
+
+
+    /**
+     * @brief Constructor for a group bound to a memory resource.
+     * @param name The name of the group.
+     * @param resource The memory resource of the group.
+     */
+    group::group(
+        const std::string& name,
+        std::pmr::memory_resource* resource
+    ) : __name(name),
+        __container(resource),
+        __children(resource) {
+        this->__container.__group.ptr = this;
+    }
+
+
+    /**
+     * @brief Copy constructor, the copy allocates from the default resource.
+     * @param other The group to copy.
+     */
+    group::group(
+        const group& other
+    ) : group(other, std::pmr::get_default_resource()) {}
+
+
+    /**
+     * @brief Copies a group into a memory resource.
+     * @param other The group to copy.
+     * @param resource The memory resource for the copy.
+     */
+    group::group(
+        const group& other,
+        std::pmr::memory_resource* resource
+    ) : __name(other.__name),
+        /* items() and children() load a group read lazily */
+        __container(other.items(), resource),
+        __children(other.children().begin(), other.children().end(), resource) {
+        this->__container.__group.ptr = this;
+        /* the children are shared with the other group */
+        for (const auto& child : this->__children) if (child) child->__link(this);
+    }
+
+
+    /**
+     * @brief Copy assignment, the items and children are shared with the other group.
+     * @param other The group to copy.
+     * @return This group.
+     */
+    group& group::operator=(
+        const group& other
+    ) {
+        if (this == &other) return *this;
+        this->__invalidate();
+        for (const auto& child : this->__children) if (child) child->__unlink(this);
+        this->__name = other.__name;
+        this->__container = other.items();
+        const child_range children = other.children();
+        this->__children.assign(children.begin(), children.end());
+        this->__indexes = other.__indexes;
+        this->__names = other.__names;
+        this->__lazy = other.__lazy;
+        for (const auto& child : this->__children) if (child) child->__link(this);
+        return *this;
+    }
+
+
+    /**
+     * @brief Move constructor, the children are moved along with their links.
+     * @param other The group to move.
+     */
+    group::group(
+        group&& other
+    ) : group(std::move(other), other.resource()) {}
+
+
+    /**
+     * @brief Move assignment, the children are moved along with their links.
+     * @param other The group to move.
+     * @return This group.
+     */
+    group& group::operator=(
+        group&& other
+    ) {
+        if (this == &other) return *this;
+        this->__invalidate();
+        for (const auto& child : this->__children) if (child) child->__unlink(this);
+        this->__name = std::move(other.__name);
+        this->__container = std::move(other.__container);
+        this->__children = std::move(other.__children);
+        this->__indexes = std::move(other.__indexes);
+        this->__names = std::move(other.__names);
+        this->__lazy = std::move(other.__lazy);
+        for (const auto& child : this->__children) if (child) child->__relink(&other, this);
+        return *this;
+    }
+
+
+    /**
+     * @brief Destructor, the children forget the group as a parent.
+     */
+    group::~group() {
+        for (const auto& child : this->__children) if (child) child->__unlink(this);
+    }
+
+
+    /**
+     * @brief Moves a group into a memory resource.
+     * @param other The group to move.
+     * @param resource The memory resource of the result.
+     */
+    group::group(
+        group&& other,
+        std::pmr::memory_resource* resource
+    ) : __name(std::move(other.__name)),
+        __container(std::move(other.__container), resource),
+        __children(std::move(other.__children), resource),
+        __indexes(std::move(other.__indexes)),
+        __names(std::move(other.__names)),
+        __lazy(std::move(other.__lazy)) {
+        this->__container.__group.ptr = this;
+        for (const auto& child : this->__children) if (child) child->__relink(&other, this);
+    }
+
+
+    /**
+     * @brief Gets the memory resource the group allocates from.
+     * @return The memory resource of the group.
+     */
+    std::pmr::memory_resource* group::resource() const {
+        return this->__children.get_allocator().resource();
+    }
 
     /**
      * @brief Adds a child group to the current group.
@@ -59,41 +300,118 @@ namespace treecode {
     void group::add(
         const std::shared_ptr<group>& child
     ) {
+        this->__load();
+        /* large groups check for the child in the name index, small ones scan */
+        const name_index* names = this->__name_index();
+        const bool present = names
+            ? names->members.count(child.get()) != 0
+            : std::find(this->__children.begin(), this->__children.end(), child) != this->__children.end();
         /* add the child to the list of children */
-        if (std::find(this->__children.begin(), this->__children.end(), child) == this->__children.end())
-            this->__children.emplace_back(child);
+        if (!present) this->__attached(this->__children.emplace_back(child));
     }
 
     void group::add(
         const group& child
     ) {
-        std::shared_ptr<group> childPtr = std::make_shared<group>(child);
-        /* add the child to the list of children */
-        if (std::find(this->__children.begin(), this->__children.end(), childPtr) == this->__children.end())
-            this->__children.emplace_back(childPtr);
+        this->__load();
+        /* copy the child into the resource of this group, a new node cannot be a child yet */
+        auto node = make_shared_in<group>(this->resource(), child, this->resource());
+        /* only the items are shared, they are copied on write, the node stays this group's own */
+        if (interner::enabled()) interner::shared().intern_items(*node);
+        this->__attached(this->__children.emplace_back(std::move(node)));
+    }
+
+    void group::add(
+        group&& child
+    ) {
+        this->__load();
+        /* move the child into the resource of this group, a new node cannot be a child yet */
+        auto node = make_shared_in<group>(this->resource(), std::move(child), this->resource());
+        /* only the items are shared, they are copied on write, the node stays this group's own */
+        if (interner::enabled()) interner::shared().intern_items(*node);
+        this->__attached(this->__children.emplace_back(std::move(node)));
+    }
+
+
+    /**
+     * @brief Creates an empty child group in place.
+     * @param name The name of the child group.
+     * @return A shared pointer to the child group.
+     */
+    std::shared_ptr<group> group::emplace_child(
+        const std::string& name
+    ) {
+        this->__load();
+        const auto& child = this->__children.emplace_back(make_shared_in<group>(this->resource(), name, this->resource()));
+        this->__attached(child);
+        return child;
     }
 
     /**
      * @brief Removes a child group from the current group.
-     * @param child The child group to remove.
+     * @param removed The child group to remove.
      */
     void group::remove(
-        const std::shared_ptr<group>& child
+        const std::shared_ptr<group>& removed
     ) {
+        /* the argument may be a slot of __children, which the removal moves from */
+        const std::shared_ptr<group> child = removed;
+        this->__load();
+        if (this->__indexes.ptr) this->__indexes.ptr->detach(child);
+        if (name_index* names = this->__names.ptr.load()) {
+            names->members.erase(child.get());
+            if (child) {
+                auto it = names->named.find(child->__name);
+                if (it != names->named.end()) {
+                    auto& same = it->second->groups;
+                    same.erase(std::remove(same.begin(), same.end(), child), same.end());
+                    if (same.empty()) names->named.erase(it);
+                }
+            }
+        }
         /* remove the child from the list of children */
-        this->__children.erase(
-            std::remove_if(this->__children.begin(), this->__children.end(),
-            [&child](const std::shared_ptr<group>& g) { return g == child; }), this->__children.end()
-        );
+        const auto last = std::remove(this->__children.begin(), this->__children.end(), child);
+        if (last == this->__children.end()) return;
+        if (child) for (auto it = last; it != this->__children.end(); ++it) child->__unlink(this);
+        this->__children.erase(last, this->__children.end());
+        this->__invalidate();
+    }
+
+    /**
+     * @brief Gets a child for writing, replacing it by a copy first if other groups share it.
+     * @param pos The position of the child.
+     * @return The child, only held by this group.
+     */
+    std::shared_ptr<group> group::own_child(
+        std::size_t pos
+    ) {
+        this->__load();
+        if (pos >= this->__children.size()) Exception::Throw::Range(this->__name, Exception::GROUP_CHILD_OUT_OF_RANGE);
+        const std::shared_ptr<group> child = this->__children[pos];
+        if (!child || !child->__shared()) return child;
+        /* the copy would share the items, they are cloned; the children stay shared until owned in turn */
+        auto copy = make_shared_in<group>(this->resource(), *child, this->resource());
+        copy->__container = child->items().clone(this->resource());
+        /* the content is equal, the hash cached above stays valid once the copy has it too */
+        copy->__hash.value.store(child->__hash.value.load(std::memory_order_acquire), std::memory_order_release);
+        this->__replace(pos, copy);
+        return copy;
     }
 
     /**
      * @brief Gets the container of the group.
      * @return The container of the group.
      */
-    container& group::items() { return this->__container; }
+    container& group::items() {
+        this->__load();
+        /* changes made through the reference drop the cached hash, see container::__touched */
+        return this->__container;
+    }
 
-    const container& group::items() const { return this->__container; }
+    const container& group::items() const {
+        this->__load();
+        return this->__container;
+    }
     
 
     /**
@@ -104,7 +422,615 @@ namespace treecode {
 
     /**
      * @brief Gets the child groups of the current group.
-     * @return A vector of shared pointers to the child groups.
+     * @return A view on the child groups.
+     */
+    child_range group::children() const {
+        this->__load();
+        return child_range(this->__children.data(), this->__children.size());
+    }
+
+
+    /**
+     * @brief Gets the first child group with a name.
+     * @param name The name of the child group.
+     * @return The first child group with the name, null if there is none.
+     */
+    std::shared_ptr<group> group::child(
+        std::string_view name
+    ) const {
+        if (const name_index* names = this->__name_index()) {
+            auto it = names->named.find(name);
+            return it != names->named.end() ? it->second->groups.front() : nullptr;
+        }
+        for (const auto& c : this->__children) if (c && c->__name == name) return c;
+        return nullptr;
+    }
+
+
+    /**
+     * @brief Gets the child groups with a name.
+     * @param name The name of the child groups.
+     * @return The child groups with the name, in child order.
+     */
+    std::vector<std::shared_ptr<group>> group::children_named(
+        std::string_view name
+    ) const {
+        if (const name_index* names = this->__name_index()) {
+            auto it = names->named.find(name);
+            return it != names->named.end() ? it->second->groups : std::vector<std::shared_ptr<group>>();
+        }
+        std::vector<std::shared_ptr<group>> found;
+        for (const auto& c : this->__children) if (c && c->__name == name) found.push_back(c);
+        return found;
+    }
+
+
+    /**
+     * @brief Indexes the children by the value they hold under a key.
+     * @param key The indexed key.
+     * @param kind index_kind::ordered to also support range lookups.
+     */
+    void group::add_index(
+        const key& key,
+        index_kind kind
+    ) {
+        this->__load();
+        if (!this->__indexes.ptr) this->__indexes.ptr = std::make_unique<child_index>();
+        this->__indexes.ptr->define(key, kind, this->__children);
+    }
+
+    void group::add_index(
+        std::string_view key,
+        index_kind kind
+    ) {
+        this->add_index(treecode::key(key), kind);
+    }
+
+
+    /**
+     * @brief Drops the index of a key.
+     * @param key The indexed key.
+     * @return True if an index was dropped.
+     */
+    bool group::drop_index(const key& key) {
+        if (!this->__indexes.ptr || !this->__indexes.ptr->drop(key)) return false;
+        /* the last index stops following the children */
+        if (this->__indexes.ptr->empty()) this->__indexes.ptr.reset();
+        return true;
+    }
+
+    bool group::drop_index(std::string_view key) {
+        return this->drop_index(treecode::key(key));
+    }
+
+
+    /**
+     * @brief Gets the kind of the index of a key.
+     * @param key The indexed key.
+     * @return The kind, empty if the key is not indexed.
+     */
+    std::optional<index_kind> group::index_of(const key& key) const {
+        return this->__indexes.ptr ? this->__indexes.ptr->kind(key) : std::nullopt;
+    }
+
+    std::optional<index_kind> group::index_of(std::string_view key) const {
+        return this->index_of(treecode::key(key));
+    }
+
+
+    /**
+     * @brief Finds a child holding a value under a key.
+     * @param key The key.
+     * @param v The value, compared with its type.
+     * @return A child holding the value, null if none does.
+     */
+    std::shared_ptr<group> group::find_child(
+        const key& key,
+        const value& v
+    ) const {
+        std::shared_ptr<group> found;
+        if (this->index_of(key)) {
+            this->__indexes.ptr->equal(key, v, [&found](const std::shared_ptr<group>& child) {
+                found = child;
+                return false;
+            });
+            return found;
+        }
+        for (const auto& child : this->children()) {
+            if (!child) continue;
+            auto view = child->items().find(key);
+            if (view && view->value() == v) return child;
+        }
+        return found;
+    }
+
+    std::shared_ptr<group> group::find_child(
+        std::string_view key,
+        const value& v
+    ) const {
+        return this->find_child(treecode::key(key), v);
+    }
+
+
+    /**
+     * @brief Finds the children holding a value under a key.
+     * @param key The key.
+     * @param v The value, compared with its type.
+     * @return The children holding the value.
      */
-    const std::vector<std::shared_ptr<group>>& group::children() const { return this->__children; }
+    std::vector<std::shared_ptr<group>> group::find_children(
+        const key& key,
+        const value& v
+    ) const {
+        std::vector<std::shared_ptr<group>> found;
+        if (this->index_of(key)) {
+            this->__indexes.ptr->equal(key, v, [&found](const std::shared_ptr<group>& child) {
+                found.push_back(child);
+                return true;
+            });
+            return found;
+        }
+        for (const auto& child : this->children()) {
+            if (!child) continue;
+            auto view = child->items().find(key);
+            if (view && view->value() == v) found.push_back(child);
+        }
+        return found;
+    }
+
+    std::vector<std::shared_ptr<group>> group::find_children(
+        std::string_view key,
+        const value& v
+    ) const {
+        return this->find_children(treecode::key(key), v);
+    }
+
+
+    /**
+     * @brief Finds the children holding a value in [low, high] under a key.
+     * @param key The key.
+     * @param low The lowest value.
+     * @param high The highest value.
+     * @return The children in the range.
+     */
+    std::vector<std::shared_ptr<group>> group::find_children(
+        const key& key,
+        const value& low,
+        const value& high
+    ) const {
+        std::vector<std::shared_ptr<group>> found;
+        if (this->index_of(key) == index_kind::ordered) {
+            this->__indexes.ptr->range(key, low, high, [&found](const std::shared_ptr<group>& child) {
+                found.push_back(child);
+                return true;
+            });
+            return found;
+        }
+        for (const auto& child : this->children()) {
+            if (!child) continue;
+            auto view = child->items().find(key);
+            if (!view) continue;
+            const value current = view->value();
+            if (current.has_value() && !(current < low) && !(high < current)) found.push_back(child);
+        }
+        return found;
+    }
+
+    std::vector<std::shared_ptr<group>> group::find_children(
+        std::string_view key,
+        const value& low,
+        const value& high
+    ) const {
+        return this->find_children(treecode::key(key), low, high);
+    }
+
+
+    /**
+     * @brief Gets the content hash of the group and its subtree, computed for changed groups only.
+     * @return The hash, never 0.
+     */
+    std::uint64_t group::hash() const {
+        std::uint64_t h = this->__hash.value.load(std::memory_order_acquire);
+        if (h) return h;
+        h = 0x9e3779b97f4a7c15ULL;
+        mix_text(h, this->__name);
+        mix(h, hash_items(this->items()));
+        const auto& children = this->children();
+        mix(h, children.size());
+        for (const auto& child : children) mix(h, child ? child->hash() : 0U);
+        /* 0 marks a hash to compute */
+        if (!h) h = 1;
+        this->__hash.value.store(h, std::memory_order_release);
+        return h;
+    }
+
+
+    /**
+     * @brief Creates an independent copy of the group and its subtree.
+     * @param resource The memory resource of the copy, null for the default resource.
+     * @return The copy of the group.
+     */
+    group group::deep_copy(
+        std::pmr::memory_resource* resource
+    ) const {
+        group copy(this->__name, resource ? resource : std::pmr::get_default_resource());
+        __deep_copy(*this, copy, nullptr, 0);
+        return copy;
+    }
+
+
+    /**
+     * @brief Creates an independent copy of the group and its subtree on a thread pool.
+     * @param options The pool and grain size of the copy.
+     * @return The copy of the group.
+     */
+    group group::deep_copy(
+        const parallel& options
+    ) const {
+        group copy(this->__name);
+        task_group tasks(options.workers ? *options.workers : pool::shared());
+        __deep_copy(*this, copy, &tasks, std::max<std::size_t>(options.grain, 1U));
+        /* the copy is complete once every forked subtree is */
+        tasks.wait();
+        return copy;
+    }
+
+
+    /**
+     * @brief Gets the name index, building it for a group that outgrew NAME_INDEX_LIMIT.
+     * @return The name index, null if the group is small enough to be scanned.
+     */
+    const group::name_index* group::__name_index() const {
+        this->__load();
+        const name_index* names = this->__names.ptr.load(std::memory_order_acquire);
+        if (names || this->__children.size() <= NAME_INDEX_LIMIT) return names;
+
+        /* concurrent readers may race to build it, one lock for all groups as it happens once per group */
+        static std::mutex mutex;
+        std::lock_guard<std::mutex> lock(mutex);
+        names = this->__names.ptr.load(std::memory_order_acquire);
+        if (names) return names;
+        auto built = std::make_unique<name_index>();
+        built->members.reserve(this->__children.size());
+        for (const auto& c : this->__children) {
+            built->members.insert(c.get());
+            if (c) built->of(c->__name).push_back(c);
+        }
+        name_index* created = built.release();
+        this->__names.ptr.store(created, std::memory_order_release);
+        return created;
+    }
+
+
+    /**
+     * @brief Gets the children of a name, adding an empty list for a new name.
+     * @param name The name of the children.
+     * @return The children with the name, in child order.
+     */
+    std::vector<std::shared_ptr<group>>& group::name_index::of(
+        const std::string& name
+    ) {
+        auto it = this->named.find(name);
+        if (it == this->named.end()) {
+            /* the key views the copy of the name held by the list, which does not move */
+            auto created = std::make_unique<named_children>(named_children{name, {}});
+            const std::string_view view = created->name;
+            it = this->named.emplace(view, std::move(created)).first;
+        }
+        return it->second->groups;
+    }
+
+
+    /**
+     * @brief Loads the pending record under a lock, see __load.
+     */
+    void group::__load_pending() const {
+        /* a lock stripe per group address, loading one group never waits on another */
+        static std::mutex stripes[64];
+        std::lock_guard<std::mutex> lock(stripes[(reinterpret_cast<std::uintptr_t>(this) >> 4) % 64]);
+        lazy_node* pending = this->__lazy.ptr.load(std::memory_order_acquire);
+        if (!pending) return;
+        snapshot::__load(*this, *pending);
+        /* readers seeing null see the loaded items and children */
+        this->__lazy.ptr.store(nullptr, std::memory_order_release);
+        delete pending;
+    }
+
+
+    /**
+     * @brief Files a child appended to __children in the name index and the child indexes.
+     * @param child The child.
+     */
+    void group::__attached(
+        const std::shared_ptr<group>& child
+    ) {
+        if (name_index* names = this->__names.ptr.load()) {
+            names->members.insert(child.get());
+            if (child) names->of(child->__name).push_back(child);
+        } else {
+            /* the index is built over every child once the group outgrows the limit */
+            this->__name_index();
+        }
+        if (this->__indexes.ptr) this->__indexes.ptr->attach(child);
+        if (child) child->__link(this);
+        this->__invalidate();
+    }
+
+
+    /**
+     * @brief Records a parent of the group, once per time the parent holds it.
+     * @param parent The parent.
+     */
+    void group::__link(
+        const group* parent
+    ) {
+        std::lock_guard<std::mutex> lock(link_stripe(this));
+        if (!this->__parents.first) {
+            this->__parents.first = parent;
+            return;
+        }
+        if (!this->__parents.more) this->__parents.more = std::make_unique<std::unordered_multiset<const group*>>();
+        this->__parents.more->insert(parent);
+    }
+
+
+    /**
+     * @brief Forgets a parent of the group, once.
+     * @param parent The parent.
+     */
+    void group::__unlink(
+        const group* parent
+    ) {
+        std::lock_guard<std::mutex> lock(link_stripe(this));
+        auto& more = this->__parents.more;
+        if (this->__parents.first == parent) {
+            /* one of the other parents takes the first slot */
+            if (more && !more->empty()) {
+                this->__parents.first = *more->begin();
+                more->erase(more->begin());
+            } else {
+                this->__parents.first = nullptr;
+            }
+            return;
+        }
+        if (!more) return;
+        auto it = more->find(parent);
+        if (it != more->end()) more->erase(it);
+    }
+
+
+    /**
+     * @brief Replaces a parent of the group, once, for a parent that was moved.
+     * @param from The moved parent.
+     * @param to The parent it was moved to.
+     */
+    void group::__relink(
+        const group* from,
+        const group* to
+    ) {
+        std::lock_guard<std::mutex> lock(link_stripe(this));
+        if (this->__parents.first == from) {
+            this->__parents.first = to;
+            return;
+        }
+        if (!this->__parents.more) return;
+        auto it = this->__parents.more->find(from);
+        if (it == this->__parents.more->end()) return;
+        this->__parents.more->erase(it);
+        this->__parents.more->insert(to);
+    }
+
+
+    /**
+     * @brief Checks if the group is held by more than one group.
+     * @return True if the group has several parents, or one parent holding it twice.
+     */
+    bool group::__shared() const {
+        std::lock_guard<std::mutex> lock(link_stripe(this));
+        return this->__parents.more && !this->__parents.more->empty();
+    }
+
+
+    /**
+     * @brief Replaces a child by a group of equal content, the cached hashes stay valid.
+     * @param pos The position of the child.
+     * @param child The group taking its place.
+     */
+    void group::__replace(
+        std::size_t pos,
+        const std::shared_ptr<group>& child
+    ) {
+        std::shared_ptr<group>& slot = this->__children[pos];
+        const std::shared_ptr<group> old = slot;
+        if (this->__indexes.ptr) this->__indexes.ptr->detach(slot);
+        if (slot) slot->__unlink(this);
+        slot = child;
+        if (child) child->__link(this);
+        if (this->__indexes.ptr) this->__indexes.ptr->attach(child);
+        name_index* names = this->__names.ptr.load();
+        if (!names) return;
+        if (old && child && old->__name == child->__name) {
+            /* the child takes the place of the old one in the list of its name */
+            auto& same = names->of(child->__name);
+            auto at = std::find(same.begin(), same.end(), old);
+            if (at != same.end() && std::find(at + 1, same.end(), old) != same.end()) {
+                /* a child held at several positions gives up its occurrence of the same rank */
+                const auto before = this->__children.begin() + static_cast<std::ptrdiff_t>(pos);
+                for (auto n = std::count(this->__children.begin(), before, old); n > 0 && at != same.end(); --n)
+                    at = std::find(at + 1, same.end(), old);
+            }
+            if (at != same.end()) {
+                *at = child;
+                names->members.insert(child.get());
+                if (std::find(same.begin(), same.end(), old) == same.end()) names->members.erase(old.get());
+                return;
+            }
+        }
+        this->__unindex_name(*names, old);
+        this->__index_names(*names, pos, 1);
+    }
+
+
+    /**
+     * @brief Files the children of a range of __children, already in place, in the name index.
+     * @param names The name index.
+     * @param pos The position of the first child.
+     * @param count The number of children.
+     */
+    void group::__index_names(
+        name_index& names,
+        std::size_t pos,
+        std::size_t count
+    ) const {
+        const auto begin = this->__children.begin() + static_cast<std::ptrdiff_t>(pos);
+        const auto end = begin + static_cast<std::ptrdiff_t>(count);
+        /* the lists of names are in child order, a range before the last child counts the earlier children of its names */
+        std::unordered_map<std::string_view, std::size_t> ranks;
+        if (end != this->__children.end()) {
+            for (auto it = begin; it != end; ++it) if (*it) ranks.emplace((*it)->__name, 0U);
+            for (auto it = this->__children.begin(); it != begin; ++it) {
+                if (!*it) continue;
+                auto rank = ranks.find((*it)->__name);
+                if (rank != ranks.end()) ++rank->second;
+            }
+        }
+        for (auto it = begin; it != end; ++it) {
+            names.members.insert(it->get());
+            if (!*it) continue;
+            auto& same = names.of((*it)->__name);
+            auto rank = ranks.find((*it)->__name);
+            if (rank == ranks.end()) same.push_back(*it);
+            else same.insert(same.begin() + static_cast<std::ptrdiff_t>(rank->second++), *it);
+        }
+    }
+
+
+    /**
+     * @brief Takes one occurrence of a child no longer in __children out of the name index.
+     * @param names The name index.
+     * @param child The child.
+     */
+    void group::__unindex_name(
+        name_index& names,
+        const std::shared_ptr<group>& child
+    ) const {
+        bool held = false;
+        if (child) {
+            /* the occurrences of a child in the list of its name are alike, any one goes */
+            auto it = names.named.find(child->__name);
+            if (it != names.named.end()) {
+                auto& same = it->second->groups;
+                const auto at = std::find(same.begin(), same.end(), child);
+                if (at != same.end()) same.erase(at);
+                held = std::find(same.begin(), same.end(), child) != same.end();
+                if (same.empty()) names.named.erase(it);
+            }
+        } else {
+            held = std::find(this->__children.begin(), this->__children.end(), nullptr) != this->__children.end();
+        }
+        /* a child held at another position stays a member */
+        if (!held) names.members.erase(child.get());
+    }
+
+
+    /**
+     * @brief Drops the cached hash of the group and of its ancestors that have one.
+     *        A group without a cached hash has none above it, so the walk stops there.
+     *        The version of each group whose hash is dropped moves on.
+     */
+    void group::__invalidate() const {
+        /* the path up is followed in place, groups with several parents queue the others */
+        std::vector<const group*> forks;
+        const group* g = this;
+        for (;;) {
+            const group* next = nullptr;
+            /* the plain load keeps repeated changes of an uncached group cheap */
+            if (g && g->__hash.value.load(std::memory_order_relaxed) && g->__hash.value.exchange(0, std::memory_order_relaxed)) {
+                g->__hash.version.fetch_add(1, std::memory_order_release);
+                std::lock_guard<std::mutex> lock(link_stripe(g));
+                next = g->__parents.first;
+                if (g->__parents.more) forks.insert(forks.end(), g->__parents.more->begin(), g->__parents.more->end());
+            }
+            if (!next) {
+                if (forks.empty()) return;
+                next = forks.back();
+                forks.pop_back();
+            }
+            g = next;
+        }
+    }
+
+
+    /**
+     * @brief Replaces a range of children, keeping the child indexes up to date.
+     * @param pos The position of the first replaced child.
+     * @param count The number of children removed at pos.
+     * @param inserted The children inserted at pos, in order.
+     */
+    void group::__splice(
+        std::size_t pos,
+        std::size_t count,
+        const std::vector<std::shared_ptr<group>>& inserted
+    ) {
+        this->__load();
+        const auto first = this->__children.begin() + static_cast<std::ptrdiff_t>(pos);
+        const auto last = first + static_cast<std::ptrdiff_t>(count);
+        if (this->__indexes.ptr) for (auto it = first; it != last; ++it) this->__indexes.ptr->detach(*it);
+        for (auto it = first; it != last; ++it) if (*it) (*it)->__unlink(this);
+        name_index* names = this->__names.ptr.load();
+        std::vector<std::shared_ptr<group>> removed;
+        if (names) removed.assign(first, last);
+        const auto at = this->__children.erase(first, last);
+        this->__children.insert(at, inserted.begin(), inserted.end());
+        if (this->__indexes.ptr) for (const auto& child : inserted) this->__indexes.ptr->attach(child);
+        for (const auto& child : inserted) if (child) child->__link(this);
+        /* the name index is updated in place, as __attached does */
+        if (names) {
+            for (const auto& child : removed) this->__unindex_name(*names, child);
+            this->__index_names(*names, pos, inserted.size());
+        }
+        this->__invalidate();
+    }
+
+
+    /**
+     * @brief Copies the items and the subtree of a group into an empty group.
+     * @param src The group to copy.
+     * @param dst The group receiving the copy.
+     * @param tasks The task group forking child subtrees, null for a serial copy.
+     * @param grain The minimum number of groups copied by a forked task.
+     */
+    void group::__deep_copy(
+        const group& src,
+        group& dst,
+        task_group* tasks,
+        std::size_t grain
+    ) {
+        src.__load();
+        std::pmr::memory_resource* resource = dst.resource();
+        dst.__container = src.__container.clone(resource);
+        /* the child slots are sized up front, so tasks only write their own slots */
+        dst.__children.resize(src.__children.size());
+
+        auto body = [&src, &dst, resource, tasks, grain](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const auto& child = src.__children[i];
+                if (!child) continue;
+                auto node = make_shared_in<group>(resource, child->__name, resource);
+                __deep_copy(*child, *node, tasks, grain);
+                node->__link(&dst);
+                dst.__children[i] = std::move(node);
+            }
+        };
+
+        if (!tasks) {
+            body(0, src.__children.size());
+            return;
+        }
+        /* the size of a child subtree is estimated by the child and its direct children */
+        fork_chunks(*tasks, src.__children.size(), grain, [&src](std::size_t i) {
+            const auto& child = src.__children[i];
+            return 1U + (child ? child->children().size() : 0U);
+        }, body);
+    }
 } // namespace treecode
\ No newline at end of file
@@ -0,0 +1,105 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file arena.hpp
+ * @class arena
+ * @brief Header file for the arena class.
+ * @ingroup Core
+ *
+ * This file contains the definition of the arena class, a monotonic memory
+ * resource a whole tree can be allocated from and released with in one shot.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the arena class
+ */
+#ifndef ARENA_H
+#define ARENA_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "common.hpp"
+
+namespace treecode {
+    /**
+     * @class arena
+     * @brief Monotonic memory resource for tree scoped allocation.
+     *
+     * Groups, their item containers, child lists and items bound to an arena are
+     * carved out of large contiguous blocks. Deallocation is a no-op, all blocks are
+     * returned to the system when the arena is destroyed, so the arena must outlive
+     * every group and item allocated from it. An arena is not thread-safe.
+     *
+     * Usage:
+     *      treecode::arena arena;
+     *      treecode::group root("ROOT", &arena);
+     *      root.add(tmpl.clone("DID", &arena));
+     */
+    class arena : public std::pmr::monotonic_buffer_resource {
+    public:
+        /**
+         * @brief Default constructor for the arena class.
+         */
+        arena() : std::pmr::monotonic_buffer_resource(std::pmr::new_delete_resource()) {}
+
+
+        /**
+         * @brief Constructs an arena with a first block of the given size.
+         * @param initial_size The size of the first block in bytes.
+         */
+        explicit arena(
+            std::size_t initial_size
+        ) : std::pmr::monotonic_buffer_resource(initial_size, std::pmr::new_delete_resource()) {}
+
+
+        /**
+         * @brief Arenas own their blocks and can be neither copied nor moved.
+         */
+        arena(const arena&) = delete;
+        arena& operator=(const arena&) = delete;
+    };
+
+
+    /**
+     * @brief Creates a shared object in a memory resource.
+     *        Objects and their control block are allocated from the resource, the plain
+     *        heap path (std::make_shared) is taken for a null or the new/delete resource.
+     * @param resource The memory resource to allocate from.
+     * @param args The constructor arguments.
+     * @return A shared pointer to the created object.
+     */
+    template <typename T, typename... Args>
+    std::shared_ptr<T> make_shared_in(
+        std::pmr::memory_resource* resource,
+        Args&&... args
+    ) {
+        if (!resource || resource == std::pmr::new_delete_resource()) return std::make_shared<T>(std::forward<Args>(args)...);
+        return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(resource), std::forward<Args>(args)...);
+    }
+} // namespace treecode
+
+#endif // ARENA_H
@@ -43,14 +43,179 @@
  * @brief Include necessary headers
  */
 #include "common.hpp"
+#include "value.hpp"
 
 
 namespace treecode {
+    class base;
+    class container;
+    class key;
+
+
+    /**
+     * @class observer
+     * @brief Receives the changes of the items and containers it is attached to.
+     *
+     * Notifications are delivered synchronously on the thread making the change,
+     * after the change is complete.
+     */
+    class observer {
+    public:
+        /**
+         * @brief Destructor for the observer class.
+         */
+        virtual ~observer() = default;
+
+
+        /**
+         * @brief Called after the value of an observed item is set or cleared.
+         * @param item The item.
+         */
+        virtual void changed(
+            const base& item
+        ) = 0;
+
+
+        /**
+         * @brief Called after a slot of an observed container is added, removed, has its inline
+         *        value set or cleared, or has its item replaced.
+         * @param items The container.
+         * @param id The key of the slot.
+         */
+        virtual void changed(
+            const container& items,
+            const key& id
+        ) = 0;
+    };
+
+
+    /**
+     * @struct observer_slot
+     * @brief The observers of an object, which copies and moves of the object do not carry over.
+     *        Most objects have at most one, the others are kept aside.
+     */
+    struct observer_slot {
+        observer* first = nullptr;
+        std::unique_ptr<std::vector<observer*>> more;
+
+        observer_slot() = default;
+        observer_slot(const observer_slot&) {}
+        observer_slot& operator=(const observer_slot&) { return *this; }
+
+        bool empty() const { return !this->first; }
+
+        bool contains(const observer* watcher) const {
+            return watcher && (this->first == watcher ||
+                (this->more && std::find(this->more->begin(), this->more->end(), watcher) != this->more->end()));
+        }
+
+        /* an observer attached twice is notified once */
+        void add(observer* watcher) {
+            if (!watcher || this->contains(watcher)) return;
+            if (!this->first) this->first = watcher;
+            else {
+                if (!this->more) this->more = std::make_unique<std::vector<observer*>>();
+                this->more->push_back(watcher);
+            }
+        }
+
+        void remove(const observer* watcher) {
+            if (!watcher) return;
+            if (this->first == watcher) {
+                /* the first of the others moves up, an empty slot has no first */
+                this->first = nullptr;
+                if (this->more && !this->more->empty()) {
+                    this->first = this->more->front();
+                    this->more->erase(this->more->begin());
+                }
+            } else if (this->more) {
+                this->more->erase(std::remove(this->more->begin(), this->more->end(), watcher), this->more->end());
+            }
+            if (this->more && this->more->empty()) this->more.reset();
+        }
+
+        /* observers may attach or detach others while they are notified */
+        template <typename F>
+        void each(F&& fn) const {
+            if (!this->first) return;
+            fn(this->first);
+            for (std::size_t i = 0; this->more && i < this->more->size(); ++i) fn((*this->more)[i]);
+        }
+    };
+
+
+    /**
+     * @struct owner_slot
+     * @brief The containers owning an item, which copies of the item do not carry over.
+     *        Most items have one, the copies of its container sharing it are kept aside.
+     *        A container is listed once per slot holding the item, the containers guard
+     *        the links, see container::__adopt.
+     */
+    struct owner_slot {
+        const container* first = nullptr;
+        std::unique_ptr<std::vector<const container*>> more;
+
+        owner_slot() = default;
+        owner_slot(const owner_slot&) {}
+        owner_slot& operator=(const owner_slot&) { return *this; }
+
+        bool empty() const { return !this->first; }
+
+        void add(const container* owner) {
+            if (!this->first) this->first = owner;
+            else {
+                if (!this->more) this->more = std::make_unique<std::vector<const container*>>();
+                this->more->push_back(owner);
+            }
+        }
+
+        /* one link of the owner is dropped */
+        void remove(const container* owner) {
+            if (this->first == owner) {
+                this->first = nullptr;
+                if (this->more && !this->more->empty()) {
+                    this->first = this->more->back();
+                    this->more->pop_back();
+                }
+            } else if (this->more) {
+                auto it = std::find(this->more->begin(), this->more->end(), owner);
+                if (it != this->more->end()) {
+                    *it = this->more->back();
+                    this->more->pop_back();
+                }
+            }
+            if (this->more && this->more->empty()) this->more.reset();
+        }
+
+        /* every link of the owner moves to the other one */
+        void replace(const container* from, const container* to) {
+            if (this->first == from) this->first = to;
+            if (this->more) std::replace(this->more->begin(), this->more->end(), from, to);
+        }
+
+        template <typename F>
+        void each(F&& fn) const {
+            if (!this->first) return;
+            fn(this->first);
+            if (this->more) for (const container* owner : *this->more) fn(owner);
+        }
+    };
+
+
     /**
      * @class base
      * @brief Represents the base item with a label, description, type, and optional constraints.
+     *
+     * An item knows the containers that own it, those it was added to and their copies,
+     * so that changes made through a held item pointer reach every group holding one of
+     * them. Implementations call __notify after each change of their value and __touched
+     * after other changes of their content.
      */
     class base {
+        /* containers take and release the ownership of their items */
+        friend class container;
+        /* interners release the ownership of the items they share */
+        friend class interner;
         
     public:
         /**
@@ -71,6 +236,33 @@ namespace treecode {
         virtual std::shared_ptr<base> clone() const = 0;
 
 
+        /**
+         * @brief Clone the base into a memory resource.
+         *        The default implementation ignores the resource and allocates on the heap.
+         * @param resource The memory resource to allocate the clone from.
+         * @return A shared pointer to the cloned base.
+         */
+        virtual std::shared_ptr<base> clone(
+            std::pmr::memory_resource* resource
+        ) const { (void)resource; return this->clone(); }
+
+
+        /**
+         * @brief Gets the type tag of the value held by the base.
+         *        Implementations return a tag other than type_tag::user only if they
+         *        derive from item<T> for the type of that tag.
+         * @return The type tag, type_tag::user by default.
+         */
+        virtual type_tag tag() const { return type_tag::user; }
+
+
+        /**
+         * @brief Checks if a value is set.
+         * @return True if a value is set, true by default for bases without an optional value.
+         */
+        virtual bool is_value_set() const { return true; }
+
+
         /**
          * @brief Checks if the base is required.
          * @return True if the base is required, false otherwise.
@@ -84,6 +276,31 @@ namespace treecode {
          */
         virtual void required() = 0;
 
+
+        /**
+         * @brief Attaches an observer notified after each change of the value.
+         *        Several observers may be attached, each one once. Copies and clones
+         *        of the base are not observed.
+         * @param watcher The observer.
+         */
+        void observe(observer* watcher) { this->__observer.add(watcher); }
+
+
+        /**
+         * @brief Detaches an observer, nothing is done if it is not attached.
+         * @param watcher The observer.
+         */
+        void unobserve(const observer* watcher) { this->__observer.remove(watcher); }
+
+
+        /**
+         * @brief Checks if any observer, or a given one, is attached to the base.
+         * @param watcher The observer.
+         * @return True if the observer is attached.
+         */
+        bool observed() const { return !this->__observer.empty(); }
+        bool observed_by(const observer* watcher) const { return this->__observer.contains(watcher); }
+
         protected:
         /**
          * @brief Copy constructor for the base class.
@@ -96,6 +313,42 @@ namespace treecode {
          * @return A reference to the assigned base object.
          */
         base& operator=(const base&) = default;
+
+
+        /**
+         * @brief Notifies the observers, to be called after each change of the value.
+         */
+        void __notify() const {
+            this->__observer.each([this](observer* watcher) { watcher->changed(*this); });
+            this->__touched();
+        }
+
+
+        /**
+         * @brief Tells the owning container that the content changed, without notifying the observer.
+         */
+        void __touched() const { if (!this->__owner.empty()) __touch(*this); }
+
+    private:
+        /**
+         * @var observer_slot base::__observer
+         * The observers of the value.
+         */
+        observer_slot __observer;
+
+        /**
+         * @var owner_slot base::__owner
+         * The containers owning the item, none for detached and shared items.
+         */
+        owner_slot __owner;
+
+        /**
+         * @brief Forwards a change of an owned item to its containers, see container::__touched.
+         * @param item The changed item.
+         */
+        static void __touch(
+            const base& item
+        );
     };
 } // namespace treecode
 
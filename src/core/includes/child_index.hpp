@@ -0,0 +1,353 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file child_index.hpp
+ * @class child_index
+ * @brief Header file for the child_index class.
+ * @ingroup Core
+ *
+ * This file contains the definition of the child_index class, the secondary
+ * indexes of a group over the values its children hold under given keys.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the child_index class
+ */
+#ifndef CHILD_INDEX_H
+#define CHILD_INDEX_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "container.hpp"
+#include <map>
+
+namespace treecode {
+    class group;
+
+
+    /**
+     * @enum index_kind
+     * @brief The lookups a child index supports.
+     */
+    enum class index_kind : std::uint8_t {
+        hash,       /* equality lookups */
+        ordered     /* equality and range lookups */
+    };
+
+
+    /**
+     * @class child_index
+     * @brief The value indexes of a group over its children.
+     *
+     * Each index maps the value a child holds under a key to the child, children
+     * without the key or without a value are not indexed. The index observes the
+     * containers of the children and the items under indexed keys, so it follows
+     * values set through the container or directly on the item<T>. A child held
+     * by several parents is followed by the indexes of each of them, and replacing
+     * the whole container of a child is not followed.
+     */
+    class child_index : public observer {
+    public:
+        /**
+         * @brief Default constructor, holds no index.
+         */
+        child_index() = default;
+
+
+        /**
+         * @brief Child indexes observe their children by address and can be neither copied nor moved.
+         */
+        child_index(const child_index&) = delete;
+        child_index& operator=(const child_index&) = delete;
+
+
+        /**
+         * @brief Destructor, stops observing the children.
+         */
+        ~child_index() override;
+
+
+        /**
+         * @brief Defines an index, replacing an index of another kind on the same key.
+         * @param id The indexed key.
+         * @param kind The kind of index.
+         * @param children The current children of the group.
+         */
+        void define(
+            const key& id,
+            index_kind kind,
+            const std::pmr::vector<std::shared_ptr<group>>& children
+        );
+
+
+        /**
+         * @brief Drops the index of a key.
+         * @param id The indexed key.
+         * @return True if an index was dropped.
+         */
+        bool drop(
+            const key& id
+        );
+
+
+        /**
+         * @brief Gets the kind of the index of a key.
+         * @param id The indexed key.
+         * @return The kind, empty if the key is not indexed.
+         */
+        std::optional<index_kind> kind(
+            const key& id
+        ) const;
+
+
+        /**
+         * @brief Checks if no index is defined.
+         * @return True if no index is defined.
+         */
+        bool empty() const;
+
+
+        /**
+         * @brief Starts following a child added to the group.
+         * @param child The child.
+         */
+        void attach(
+            const std::shared_ptr<group>& child
+        );
+
+
+        /**
+         * @brief Stops following a child removed from the group.
+         * @param child The child.
+         */
+        void detach(
+            const std::shared_ptr<group>& child
+        );
+
+
+        /**
+         * @brief Finds the children holding a value under an indexed key.
+         * @param id The indexed key.
+         * @param v The value.
+         * @param fn Callable invoked as fn(const std::shared_ptr<group>&), returning false to stop.
+         */
+        template <typename F>
+        void equal(
+            const key& id,
+            const value& v,
+            F&& fn
+        ) const;
+
+
+        /**
+         * @brief Finds the children holding a value in [low, high] under a key with an ordered index.
+         *        Values are ordered by tag first, so the bounds must have the type of the values.
+         * @param id The indexed key.
+         * @param low The lowest value.
+         * @param high The highest value.
+         * @param fn Callable invoked as fn(const std::shared_ptr<group>&), returning false to stop.
+         */
+        template <typename F>
+        void range(
+            const key& id,
+            const value& low,
+            const value& high,
+            F&& fn
+        ) const;
+
+
+        /**
+         * @brief Follows the value change of an observed item.
+         * @param item The item.
+         */
+        void changed(
+            const base& item
+        ) override;
+
+
+        /**
+         * @brief Follows the change of a slot of an observed container.
+         * @param items The container.
+         * @param id The key of the slot.
+         */
+        void changed(
+            const container& items,
+            const key& id
+        ) override;
+
+    private:
+        /**
+         * @struct member
+         * @brief A followed child.
+         */
+        struct member {
+            std::shared_ptr<group> node;
+            std::vector<value> values;              /* the indexed value per index, no value when unset */
+            std::vector<const base*> items;         /* the observed item per index, null for inline slots */
+        };
+
+        /**
+         * @struct index
+         * @brief An index over one key, only the map of its kind is used.
+         */
+        struct index {
+            key id;
+            index_kind kind;
+            std::unordered_multimap<value, member*> hashed;
+            std::multimap<value, member*> ordered;
+        };
+
+        /**
+         * @var std::vector<index> child_index::__indexes
+         * The defined indexes.
+         */
+        std::vector<index> __indexes;
+
+        /**
+         * @var std::unordered_map<const container*, member> child_index::__members
+         * The followed children by the address of their container, the nodes are stable.
+         */
+        std::unordered_map<const container*, member> __members;
+
+        /**
+         * @var std::unordered_map<const base*, const container*> child_index::__items
+         * The observed items with the container holding them.
+         */
+        std::unordered_map<const base*, const container*> __items;
+
+        /**
+         * @brief Gets the position of the index of a key.
+         * @param id The indexed key.
+         * @return The position, __indexes.size() if the key is not indexed.
+         */
+        std::size_t __find(
+            const key& id
+        ) const;
+
+        /**
+         * @brief Brings the entry of a child in an index up to date with its slot.
+         * @param m The child.
+         * @param pos The position of the index.
+         */
+        void __refresh(
+            member& m,
+            std::size_t pos
+        );
+
+        /**
+         * @brief Takes a child out of an index.
+         * @param m The child.
+         * @param pos The position of the index.
+         */
+        void __unfile(
+            member& m,
+            std::size_t pos
+        );
+
+        /**
+         * @brief Stops observing the item a child holds for an index.
+         * @param m The child.
+         * @param pos The position of the index.
+         */
+        void __forget(
+            member& m,
+            std::size_t pos
+        );
+
+        /**
+         * @brief Stops observing a child and its items.
+         * @param m The child.
+         */
+        void __release(
+            member& m
+        );
+    };
+
+
+    /**
+     * @brief Finds the children holding a value under an indexed key.
+     * @param id The indexed key.
+     * @param v The value.
+     * @param fn Callable invoked as fn(const std::shared_ptr<group>&), returning false to stop.
+     */
+    template <typename F>
+    void child_index::equal(
+        const key& id,
+        const value& v,
+        F&& fn
+    ) const {
+        const std::size_t pos = this->__find(id);
+        if (pos == this->__indexes.size()) return;
+        const index& idx = this->__indexes[pos];
+        if (idx.kind == index_kind::hash) {
+            auto found = idx.hashed.equal_range(v);
+            for (auto it = found.first; it != found.second; ++it) if (!fn(it->second->node)) return;
+        } else {
+            auto found = idx.ordered.equal_range(v);
+            for (auto it = found.first; it != found.second; ++it) if (!fn(it->second->node)) return;
+        }
+    }
+
+
+    /**
+     * @brief Finds the children holding a value in [low, high] under a key with an ordered index.
+     * @param id The indexed key.
+     * @param low The lowest value.
+     * @param high The highest value.
+     * @param fn Callable invoked as fn(const std::shared_ptr<group>&), returning false to stop.
+     */
+    template <typename F>
+    void child_index::range(
+        const key& id,
+        const value& low,
+        const value& high,
+        F&& fn
+    ) const {
+        const std::size_t pos = this->__find(id);
+        if (pos == this->__indexes.size() || this->__indexes[pos].kind != index_kind::ordered || high < low) return;
+        const index& idx = this->__indexes[pos];
+        const auto end = idx.ordered.upper_bound(high);
+        for (auto it = idx.ordered.lower_bound(low); it != end; ++it) if (!fn(it->second->node)) return;
+    }
+
+
+    /**
+     * @struct child_index_ptr
+     * @brief The child indexes of a group, which copies of the group do not carry over.
+     */
+    struct child_index_ptr {
+        std::unique_ptr<child_index> ptr;
+
+        child_index_ptr() = default;
+        child_index_ptr(const child_index_ptr&) {}
+        child_index_ptr(child_index_ptr&&) = default;
+        child_index_ptr& operator=(const child_index_ptr&) { this->ptr.reset(); return *this; }
+        child_index_ptr& operator=(child_index_ptr&&) = default;
+    };
+} // namespace treecode
+
+#endif // CHILD_INDEX_H
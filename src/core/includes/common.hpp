@@ -41,11 +41,13 @@
 /**
  * @brief Include necessary headers
  */
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <algorithm>
 #include <unordered_map>
 #include <memory>
+#include <memory_resource>
 #include <exception>
 #include <sstream>
 #include <optional>
@@ -43,14 +43,230 @@
  * @brief Include necessary headers
  */
 #include "item.hpp"
+#include "key.hpp"
 
 namespace treecode {
+    class group;
+
+
+    /**
+     * @enum clone_mode
+     * @brief Selects how the items of a container are copied by clone.
+     */
+    enum class clone_mode : std::uint8_t {
+        deep,   /* every item is cloned */
+        shared  /* items are shared with the source and copied on their first write */
+    };
+
+
     /**
      * @class container
      * @brief Represents a container for storing items in a key-value format.
+     *
+     * Keys are stored as interned key handles. Every lookup method is available
+     * with a precomputed key (pointer comparison, no hashing) and with a
+     * std::string_view (heterogeneous lookup, no temporary string and no interning).
+     *
+     * Items are stored either as a shared item<T> (add) or, for the inline types
+     * (bool, fixed width integers, float, double, std::string), as a tagged value
+     * directly in the slot (add_inline). Inline slots cost no allocation and are read
+     * and written through value<T>, typed access is resolved by comparing type tags.
+     * get/get<T> hand out the item of the slot, materialising an inline slot into an
+     * item<T> once. find, view, value<T> and item_view::get_if read a slot in place,
+     * without allocating and without changing the slot, and are the path for readers.
+     *
+     * A container cloned with clone_mode::shared references the items of its source.
+     * A shared item is copied into the container before any access that can write to
+     * it: value, clear_value, required and get/get<T>, so an item handed out is never
+     * the one of the source.
+     *
+     * A container owns the items of its slots and forwards their changes, like its own,
+     * to the group holding it, which drops its cached hash. Copies of a container share
+     * its items and own them as well, so a change made through one copy drops the cached
+     * hash of the groups holding any of them.
      */
     class container {
+        struct entry;
+
     public:
+        class key_view;
+
+    public:
+        /**
+         * @class item_view
+         * @brief Read-only view on a slot of the container, valid until the container is modified.
+         */
+        class item_view {
+        public:
+            /**
+             * @brief Gets the key of the slot.
+             * @return The interned key.
+             */
+            const key& id() const;
+
+
+            /**
+             * @brief Gets the type tag of the slot.
+             * @return The type tag of the stored value.
+             */
+            type_tag tag() const;
+
+
+            /**
+             * @brief Checks if the slot stores its value inline.
+             * @return True for inline slots, false for item slots.
+             */
+            bool is_inline() const;
+
+
+            /**
+             * @brief Checks if the slot still shares its item with the container it was cloned from.
+             * @return True for shared item slots, false otherwise.
+             */
+            bool is_shared() const;
+
+
+            /**
+             * @brief Checks if the slot is required.
+             * @return True if the slot is required, false otherwise.
+             */
+            bool is_required() const;
+
+
+            /**
+             * @brief Checks if the slot holds a value.
+             * @return True if a value is set, false otherwise.
+             */
+            bool has_value() const;
+
+
+            /**
+             * @brief Gets the item of the slot.
+             * @return The shared item, null for inline slots.
+             */
+            const std::shared_ptr<base>& ptr() const;
+
+
+            /**
+             * @brief Gets a pointer to the value of the slot if it has the given type.
+             * @return A pointer to the value, null if no value or another type is held.
+             */
+            template <typename T>
+            const T* get_if() const;
+
+
+            /**
+             * @brief Gets the value of the slot.
+             * @return The value, no value if none is set or the slot holds a user type.
+             */
+            treecode::value value() const;
+
+        private:
+            friend class container;
+            friend class key_view;
+
+            explicit item_view(const entry& e) : __entry(&e) {}
+
+            /**
+             * @var const entry* item_view::__entry
+             * The viewed slot.
+             */
+            const entry* __entry;
+        };
+
+
+        /**
+         * @class key_view
+         * @brief Range over the keys of the container in insertion order, without copying them.
+         *        Valid until the container is modified.
+         */
+        class key_view {
+        public:
+            /**
+             * @class iterator
+             * @brief Forward iterator over the keys, skipping removed slots.
+             */
+            class iterator {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = key;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const key*;
+                using reference = const key&;
+
+                iterator() = default;
+
+                reference operator*() const { return this->__pos->id; }
+                pointer operator->() const { return &this->__pos->id; }
+
+                /**
+                 * @brief Gets a view on the slot of the current key.
+                 * @return The view on the slot.
+                 */
+                item_view item() const { return key_view::__view(*this->__pos); }
+
+                iterator& operator++() {
+                    ++this->__pos;
+                    this->__skip();
+                    return *this;
+                }
+
+                iterator operator++(int) {
+                    iterator copy = *this;
+                    ++*this;
+                    return copy;
+                }
+
+                bool operator==(const iterator& other) const { return this->__pos == other.__pos; }
+                bool operator!=(const iterator& other) const { return this->__pos != other.__pos; }
+
+            private:
+                friend class key_view;
+
+                iterator(const entry* pos, const entry* end) : __pos(pos), __end(end) { this->__skip(); }
+
+                /* moves past removed slots */
+                void __skip() { while (this->__pos != this->__end && !this->__pos->live) ++this->__pos; }
+
+                const entry* __pos = nullptr;
+                const entry* __end = nullptr;
+            };
+
+            iterator begin() const {
+                const entry* first = this->__container->__entries.data();
+                return iterator(first, first + this->__container->__entries.size());
+            }
+
+            iterator end() const {
+                const entry* last = this->__container->__entries.data() + this->__container->__entries.size();
+                return iterator(last, last);
+            }
+
+            std::size_t size() const { return this->__container->size(); }
+
+            bool empty() const { return this->size() == 0; }
+
+        private:
+            friend class container;
+
+            explicit key_view(const container& c) : __container(&c) {}
+
+            static item_view __view(const entry& e) { return item_view(e); }
+
+            /**
+             * @var const container* key_view::__container
+             * The viewed container.
+             */
+            const container* __container;
+        };
+
+        /**
+         * @var container::npos
+         * The position of a key that is not in the container, as std::string::npos.
+         */
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+
         /**
          * @brief Default constructor for the container class.
          */
@@ -58,11 +274,66 @@ namespace treecode {
 
 
         /**
-         * @brief Destructor for the container class.
+         * @brief Constructs an empty container allocating from a memory resource.
+         * @param resource The memory resource for the entries and the items added later.
          */
-        ~container() = default;
+        explicit container(
+            std::pmr::memory_resource* resource
+        );
+
+
+        /**
+         * @brief Copies a container into a memory resource.
+         *        The items are shared with the source container, as with the copy constructor.
+         * @param other The container to copy.
+         * @param resource The memory resource for the copy.
+         */
+        container(
+            const container& other,
+            std::pmr::memory_resource* resource
+        );
+
+
+        /**
+         * @brief Moves a container into a memory resource.
+         *        The slots are moved as a block if the resources are equal, one by one otherwise.
+         * @param other The container to move.
+         * @param resource The memory resource of the result.
+         */
+        container(
+            container&& other,
+            std::pmr::memory_resource* resource
+        );
+
+
+        /**
+         * @brief Copy and move operations, a copy allocates from the default resource.
+         *        Copies share the items, moves carry the ownership of the items over,
+         *        assignments keep the resource of the assigned container.
+         */
+        container(const container& other);
+        container(container&& other) noexcept;
+        container& operator=(const container& other);
+        container& operator=(container&& other);
 
 
+        /**
+         * @brief Destructor for the container class, releases the ownership of the items.
+         */
+        ~container();
+
+
+        /**
+         * @brief Gets the memory resource the container allocates from.
+         * @return The memory resource of the container.
+         */
+        std::pmr::memory_resource* resource() const;
+
+
+        /**
+         * This method is overloaded to allow for adding items by
+         * precomputed key or by key string.
+         */
         /**
          * @brief Adds an item to the container.
          * @param key The key for the item.
@@ -70,7 +341,12 @@ namespace treecode {
          */
         template <typename T>
         std::shared_ptr<item<T>> add(
-            const std::string& key
+            const key& key
+        );
+
+        template <typename T>
+        std::shared_ptr<item<T>> add(
+            std::string_view key
         );
 
 
@@ -82,7 +358,13 @@ namespace treecode {
          */
         template <typename T>
         std::shared_ptr<item<T>> add(
-            const std::string& key,
+            const key& key,
+            const T& value
+        );
+
+        template <typename T>
+        std::shared_ptr<item<T>> add(
+            std::string_view key,
             const T& value
         );
 
@@ -95,11 +377,36 @@ namespace treecode {
          */
         template <typename T>
         std::shared_ptr<item<T>> add(
-            const std::string& key,
+            const key& key,
+            const std::vector<T>& choices
+        );
+
+        template <typename T>
+        std::shared_ptr<item<T>> add(
+            std::string_view key,
             const std::vector<T>& choices
         );
 
 
+        /**
+         * @brief Adds an item constructed in place from the given arguments.
+         * @param key The key for the item.
+         * @param args The constructor arguments of item<T>, e.g. a value or a choice vector.
+         * @return A shared pointer to the added item.
+         */
+        template <typename T, typename... Args>
+        std::shared_ptr<item<T>> emplace(
+            const key& key,
+            Args&&... args
+        );
+
+        template <typename T, typename... Args>
+        std::shared_ptr<item<T>> emplace(
+            std::string_view key,
+            Args&&... args
+        );
+
+
         /**
          * @brief Adds an item to the container.
          * @param key The key for the item.
@@ -107,28 +414,169 @@ namespace treecode {
          * @return A shared pointer to the added item.
          */
         std::shared_ptr<base> add(
-            const std::string& key,
+            const key& key,
+            const std::shared_ptr<base>& ptr
+        );
+
+        std::shared_ptr<base> add(
+            std::string_view key,
             const std::shared_ptr<base>& ptr
         );
 
 
+        /**
+         * @brief Adds an inline slot to the container.
+         * @param key The key for the slot.
+         */
+        template <typename T>
+        void add_inline(
+            const key& key
+        );
+
+        template <typename T>
+        void add_inline(
+            std::string_view key
+        );
+
+
+        /**
+         * @brief Adds an inline slot to the container with a value.
+         * @param key The key for the slot.
+         * @param value The value for the slot.
+         */
+        template <typename T>
+        void add_inline(
+            const key& key,
+            const T& value
+        );
+
+        template <typename T>
+        void add_inline(
+            std::string_view key,
+            const T& value
+        );
+
+
+        /**
+         * @brief Gets the value stored under a key, without materialising inline slots.
+         * @param key The key of the slot.
+         * @return The value, std::nullopt if no value is set.
+         * @throws std::out_of_range if the key is not found.
+         * @throws std::invalid_argument if the slot holds another type.
+         */
+        template <typename T>
+        std::optional<T> value(
+            const key& key
+        ) const;
+
+        template <typename T>
+        std::optional<T> value(
+            std::string_view key
+        ) const;
+
+
+        /**
+         * @brief Sets the value stored under a key.
+         *        Item slots apply their constraints (allowed choices) as item<T>::value does.
+         * @param key The key of the slot.
+         * @param value The new value.
+         * @throws std::out_of_range if the key is not found.
+         * @throws std::invalid_argument if the slot holds another type.
+         */
+        template <typename T>
+        void value(
+            const key& key,
+            const T& value
+        );
+
+        template <typename T>
+        void value(
+            std::string_view key,
+            const T& value
+        );
+
+
+        /**
+         * @brief Clears the value stored under a key.
+         * @param key The key of the slot.
+         * @throws std::out_of_range if the key is not found.
+         */
+        void clear_value(const key& key);
+
+        void clear_value(std::string_view key);
+
+
+        /**
+         * @brief Sets the slot stored under a key as required.
+         * @param key The key of the slot.
+         * @throws std::out_of_range if the key is not found.
+         */
+        void required(const key& key);
+
+        void required(std::string_view key);
+
+
+        /**
+         * @brief Checks if the slot stored under a key is required.
+         * @param key The key of the slot.
+         * @return True if the slot is required, false otherwise.
+         * @throws std::out_of_range if the key is not found.
+         */
+        bool is_required(const key& key) const;
+
+        bool is_required(std::string_view key) const;
+
+
+        /**
+         * @brief Gets a read-only view on the slot stored under a key.
+         * @param key The key of the slot.
+         * @return The view on the slot.
+         * @throws std::out_of_range if the key is not found.
+         */
+        item_view view(const key& key) const;
+
+        item_view view(std::string_view key) const;
+
+
+        /**
+         * @brief Looks up the slot stored under a key without throwing.
+         * @param key The key of the slot.
+         * @return The view on the slot, empty if the key is not found.
+         */
+        std::optional<item_view> find(const key& key) const;
+
+        std::optional<item_view> find(std::string_view key) const;
+
+
         /**
          * This method is overloaded to allow for getting items by key
          * for both constant and non-constant containers.
          */
         /**
          * @brief Gets an base item from the container.
+         *        The slot itself cannot be reassigned through the result, use remove and add.
+         *        Both versions materialise an inline slot and copy a shared item first, so
+         *        the constant one is not safe concurrently with other readers of the slot;
+         *        read through find or value<T> instead, which never allocate.
          * @param key The key for the item.
          * @return A shared pointer to the base.
          */
         /* non-constant version of the method */
-        std::shared_ptr<base>& get(
-            const std::string& key
+        const std::shared_ptr<base>& get(
+            const key& key
+        );
+
+        const std::shared_ptr<base>& get(
+            std::string_view key
         );
 
         /* constant version of the method */
         const std::shared_ptr<base>& get(
-            const std::string& key
+            const key& key
+        ) const;
+
+        const std::shared_ptr<base>& get(
+            std::string_view key
         ) const;
 
 
@@ -138,19 +586,31 @@ namespace treecode {
          */
         /**
          * @brief Gets an item from the container.
+         *        As get, both versions materialise an inline slot and copy a shared item
+         *        first; item_view::get_if reads the value without an item.
          * @param key The key for the item.
          * @return A shared pointer to the item.
          */
         /* non-constant version of the method */
         template <typename T>
         std::shared_ptr<item<T>> get(
-            const std::string& key
+            const key& key
+        );
+
+        template <typename T>
+        std::shared_ptr<item<T>> get(
+            std::string_view key
         );
 
         /* constant version of the method */
         template <typename T>
         std::shared_ptr<item<T>> get(
-            const std::string& key
+            const key& key
+        ) const;
+
+        template <typename T>
+        std::shared_ptr<item<T>> get(
+            std::string_view key
         ) const;
 
 
@@ -161,32 +621,407 @@ namespace treecode {
         std::vector<std::string> keys() const;
 
 
+        /**
+         * @brief Gets a view on the keys of the container.
+         * @return A range of the interned keys in insertion order.
+         */
+        key_view keys_view() const;
+
+
+        /**
+         * @brief Calls a function for every slot in insertion order.
+         * @param fn Callable invoked as fn(const item_view&).
+         */
+        template <typename F>
+        void for_each(
+            F&& fn
+        ) const;
+
+
+        /**
+         * @brief Creates an independent copy of the container.
+         *        Inline slots are copied, items are cloned or shared depending on the mode,
+         *        the index table is copied as is.
+         * @param resource The memory resource of the copy, null for the default resource.
+         * @param mode clone_mode::shared to share the items until their first write.
+         * @return The copy of the container.
+         */
+        container clone(
+            std::pmr::memory_resource* resource = nullptr,
+            clone_mode mode = clone_mode::deep
+        ) const;
+
+
         /**
          * @brief Checks if an item exists in the container.
          * @param key The key of the item.
          * @return True if the item exists, false otherwise.
          */
-        bool exists(const std::string& key) const;
+        bool exists(const key& key) const;
+
+        bool exists(std::string_view key) const;
 
 
         /**
          * @brief Removes an item from the container.
          * @param key The key of the item to remove.
          */
-        bool remove(const std::string& key);
+        bool remove(const key& key);
+
+        bool remove(std::string_view key);
+
+
+        /**
+         * @brief Gets the number of items in the container.
+         * @return The number of items.
+         */
+        std::size_t size() const;
+
+
+        /**
+         * @brief Attaches an observer notified after each change of a slot.
+         *        Several observers may be attached, each one once. Value changes made
+         *        through an item are only notified by items observed with
+         *        observe(key, watcher). Copies, clones and whole container assignments
+         *        are not observed.
+         * @param watcher The observer.
+         */
+        void observe(observer* watcher);
+
+
+        /**
+         * @brief Attaches an observer to the item of a slot, see base::observe.
+         *        A shared item is copied first, so only this container observes it;
+         *        nothing is done for inline slots, whose changes the container notifies.
+         * @param key The key of the slot.
+         * @param watcher The observer.
+         * @throws std::out_of_range if the key is not found.
+         */
+        void observe(
+            const key& key,
+            observer* watcher
+        );
+
+
+        /**
+         * @brief Detaches an observer, nothing is done if it is not attached.
+         * @param watcher The observer.
+         */
+        void unobserve(const observer* watcher);
+
+
+        /**
+         * @brief Checks if any observer, or a given one, is attached to the container.
+         * @param watcher The observer.
+         * @return True if the observer is attached.
+         */
+        bool observed() const;
+        bool observed_by(const observer* watcher) const;
 
     private:
+        /* groups bind the container they hold */
+        friend class group;
+        /* items forward their changes to their owner */
+        friend class base;
+        /* interners replace the items of slots by shared instances */
+        friend class interner;
+        /* validators walk the slots of instances along the slots of their prototype */
+        friend class validator;
+
         /**
-         * @var std::unordered_map<std::string, std::shared_ptr<base>> container::__items
-         * The items of the container.
+         * @var container::SMALL_LIMIT
+         * Up to this many items the container is scanned linearly and no index table is kept.
          */
-        std::unordered_map<std::string, std::shared_ptr<base>> __items;
+        static constexpr std::size_t SMALL_LIMIT = 8U;
 
         /**
-         * @var std::vector<std::string> container::__keys
-         * The keys of the container.
+         * @struct entry
+         * @brief A slot of the dense, insertion-ordered entry array.
          */
-        std::vector<std::string> __keys;
+        struct entry {
+            /**
+             * @var key entry::id
+             * The interned key of the item.
+             */
+            key id;
+
+            /**
+             * @var std::shared_ptr<base> entry::ptr
+             * The item stored under the key, null for inline slots.
+             */
+            std::shared_ptr<base> ptr;
+
+            /**
+             * @var value entry::val
+             * The value of an inline slot.
+             */
+            treecode::value val;
+
+            /**
+             * @var std::uint32_t entry::hash
+             * Copy of the key hash, kept in the slot so probing does not touch the atom.
+             */
+            std::uint32_t hash = 0;
+
+            /**
+             * @var type_tag entry::tag
+             * The type tag of the value, cached from the item for item slots.
+             */
+            type_tag tag = type_tag::user;
+
+            /**
+             * @var bool entry::is_inline
+             * True if the value is stored in val rather than in an item.
+             */
+            bool is_inline = false;
+
+            /**
+             * @var bool entry::required
+             * The required flag of an inline slot.
+             */
+            bool required = false;
+
+            /**
+             * @var bool entry::shared
+             * True while the item belongs to the container this one was cloned from.
+             */
+            bool shared = false;
+
+            /**
+             * @var bool entry::live
+             * False once the item is removed and the slot waits for compaction.
+             */
+            bool live = true;
+        };
+
+        /**
+         * @var std::pmr::vector<entry> container::__entries
+         * The items of the container in insertion order, removed slots are holes.
+         * Mutable so that the constant get can materialise and own slots, see get.
+         */
+        mutable std::pmr::vector<entry> __entries;
+
+        /**
+         * @var std::pmr::vector<std::uint32_t> container::__index
+         * Open addressing table (linear probing) holding entry positions + 1, 0 marks an empty bucket.
+         * Empty while the container holds at most SMALL_LIMIT items.
+         */
+        std::pmr::vector<std::uint32_t> __index;
+
+        /**
+         * @var std::size_t container::__holes
+         * The number of removed slots in the entry array.
+         */
+        std::size_t __holes = 0;
+
+        /**
+         * @var observer_slot container::__observer
+         * The observers of the slots.
+         */
+        observer_slot __observer;
+
+        /**
+         * @struct group_slot
+         * @brief The group holding the container, which copies and moves do not carry over.
+         */
+        struct group_slot {
+            const group* ptr = nullptr;
+
+            group_slot() = default;
+            group_slot(const group_slot&) {}
+            group_slot& operator=(const group_slot&) { return *this; }
+        };
+
+        /**
+         * @var group_slot container::__group
+         * The group holding the container, null for free containers.
+         */
+        group_slot __group;
+
+        /**
+         * @brief Notifies the observers of a change of a slot.
+         * @param id The key of the slot.
+         */
+        void __changed(const key& id) const {
+            this->__observer.each([this, &id](observer* watcher) { watcher->changed(*this, id); });
+            this->__touched();
+        }
+
+        /**
+         * @brief Drops the cached hash of the group holding the container.
+         */
+        void __touched() const;
+
+        /**
+         * @brief Links the container as an owner of an item held by one more of its slots.
+         *        Copies of a container on several threads link the same items, so the links
+         *        are guarded by a lock stripe of the item.
+         * @param ptr The item, may be null.
+         */
+        void __adopt(
+            const std::shared_ptr<base>& ptr
+        ) const;
+
+        /**
+         * @brief Drops one link of the container as an owner of an item.
+         * @param ptr The item, may be null.
+         */
+        void __disown(
+            const std::shared_ptr<base>& ptr
+        ) const;
+
+        /**
+         * @brief Takes over the items owned by a container moved into this one.
+         * @param from The moved container.
+         */
+        void __adopt_from(
+            const container* from
+        );
+
+        /**
+         * @brief Links the container as an owner of the items of the slots, shared with the
+         *        container they were copied from.
+         */
+        void __adopt_copies();
+
+        /**
+         * @brief Releases the ownership of the items of the slots.
+         */
+        void __release();
+
+        /**
+         * @brief Inserts a slot under a new key.
+         * @param e The slot, its key and hash are taken from e.id.
+         * @throws std::invalid_argument if the key already exists.
+         */
+        void __insert(
+            entry&& e
+        );
+
+        /**
+         * @brief Inserts an item under a new key.
+         * @param key The key for the item.
+         * @param ptr A shared pointer to the item.
+         * @param tag The type tag of the item.
+         * @throws std::invalid_argument if the key already exists.
+         */
+        void __insert(
+            const key& key,
+            const std::shared_ptr<base>& ptr,
+            type_tag tag
+        );
+
+        /**
+         * @brief Finds the slot of a key.
+         * @param key The key to find.
+         * @return The slot.
+         * @throws std::out_of_range if the key is not found.
+         */
+        template <typename K>
+        entry& __slot(
+            const K& key
+        );
+
+        template <typename K>
+        const entry& __slot(
+            const K& key
+        ) const;
+
+        /**
+         * @brief Builds an item<T> holding the value and required flag of an inline slot.
+         * @param e The inline slot, left unchanged.
+         * @return The new item, null for slots of no inline type.
+         */
+        std::shared_ptr<base> __detach(
+            const entry& e
+        ) const;
+
+        /**
+         * @brief Turns an inline slot into an item slot holding an equivalent item<T>.
+         * @param e The slot to materialise.
+         */
+        void __materialise(
+            entry& e
+        ) const;
+
+        /**
+         * @brief Replaces the shared item of a slot by a private copy.
+         * @param e The slot to own.
+         */
+        void __own(
+            entry& e
+        ) const;
+
+        /**
+         * @brief Gets the item of an item slot as item<T>.
+         * @param e The slot.
+         * @return The item, null if the slot holds another type.
+         */
+        template <typename T>
+        static item<T>* __item(
+            const entry& e
+        );
+
+        /**
+         * This method is overloaded to build exception labels from
+         * precomputed keys and key strings.
+         */
+        static std::string __label(const key& key) { return key.str(); }
+
+        static std::string __label(std::string_view key) { return std::string(key); }
+
+        /**
+         * This method is overloaded to allow for finding entries by
+         * precomputed key or by key string.
+         */
+        /**
+         * @brief Finds the entry position of a key.
+         * @param key The key to find.
+         * @return The position in the entry array, npos if not found.
+         */
+        std::size_t __find(
+            const key& key
+        ) const;
+
+        std::size_t __find(
+            std::string_view key
+        ) const;
+
+        /**
+         * @brief Finds the index bucket holding a key.
+         * @param key The key to find.
+         * @return The bucket position, npos if not found.
+         */
+        std::size_t __find_bucket(
+            const key& key
+        ) const;
+
+        std::size_t __find_bucket(
+            std::string_view key
+        ) const;
+
+        /**
+         * @brief Removes the entry at the given position.
+         * @param pos The position in the entry array.
+         * @param bucket The index bucket of the entry, ignored for small containers.
+         */
+        void __erase(
+            std::size_t pos,
+            std::size_t bucket
+        );
+
+        /**
+         * @brief Rebuilds the index table with the given number of buckets.
+         * @param buckets The number of buckets, a power of two.
+         */
+        void __rehash(
+            std::size_t buckets
+        );
+
+        /**
+         * @brief Removes the holes from the entry array and rebuilds the index table.
+         */
+        void __compact();
     };
 
 
@@ -197,18 +1032,21 @@ namespace treecode {
      */
     template <typename T>
     std::shared_ptr<item<T>> container::add(
-        const std::string& key 
+        const key& key
     ) {
-        auto itemPtr = std::make_shared<item<T>>();
-        /* try to add the item to the container */
-        auto result = this->__items.try_emplace(key, itemPtr);
-        /* throw an exception if the key already exists */
-        if (!result.second) Exception::Throw::Invalid(key, Exception::CONTAINER_KEY_ALREADY_EXISTS);
-        /* add the key to the list of keys */
-        this->__keys.emplace_back(key);
+        auto itemPtr = make_shared_in<item<T>>(this->resource());
+        /* add the item to the container, throws if the key already exists */
+        this->__insert(key, itemPtr, type_tag_of<T>::value);
         return itemPtr;
     }
 
+    template <typename T>
+    std::shared_ptr<item<T>> container::add(
+        std::string_view key
+    ) {
+        return this->add<T>(treecode::key(key));
+    }
+
 
     /**
      * @brief Adds an item to the container with a value.
@@ -218,20 +1056,23 @@ namespace treecode {
      */
     template <typename T>
     std::shared_ptr<item<T>> container::add(
-        const std::string& key,
+        const key& key,
         const T& value
     ) {
-        auto itemPtr = std::make_shared<item<T>>(value);
-        /* try to add the item to the container */
-        auto result = this->__items.try_emplace(key, itemPtr);
-        /* throw an exception if the key already exists */
-        if (!result.second) Exception::Throw::Invalid(key, Exception::CONTAINER_KEY_ALREADY_EXISTS);
-        /* add the key to the list of keys */
-        this->__keys.emplace_back(key);
-
+        auto itemPtr = make_shared_in<item<T>>(this->resource(), value);
+        /* add the item to the container, throws if the key already exists */
+        this->__insert(key, itemPtr, type_tag_of<T>::value);
         return itemPtr;
     }
 
+    template <typename T>
+    std::shared_ptr<item<T>> container::add(
+        std::string_view key,
+        const T& value
+    ) {
+        return this->add<T>(treecode::key(key), value);
+    }
+
 
     /**
      * @brief Adds an item to the container with multi choice values.
@@ -241,43 +1082,286 @@ namespace treecode {
      */
     template <typename T>
     std::shared_ptr<item<T>> container::add(
-        const std::string& key,
+        const key& key,
         const std::vector<T>& choices
     ) {
-        auto itemPtr = std::make_shared<item<T>>(choices);
-        /* try to add the item to the container */
-        auto result = this->__items.try_emplace(key, itemPtr);
-        /* throw an exception if the key already exists */
-        if (!result.second) Exception::Throw::Invalid(key, Exception::CONTAINER_KEY_ALREADY_EXISTS);
-        /* add the key to the list of keys */
-        this->__keys.emplace_back(key);
-
+        auto itemPtr = make_shared_in<item<T>>(this->resource(), choices);
+        /* add the item to the container, throws if the key already exists */
+        this->__insert(key, itemPtr, type_tag_of<T>::value);
         return itemPtr;
     }
 
+    template <typename T>
+    std::shared_ptr<item<T>> container::add(
+        std::string_view key,
+        const std::vector<T>& choices
+    ) {
+        return this->add<T>(treecode::key(key), choices);
+    }
+
 
     /**
-     * @brief Adds an item to the container.
+     * @brief Adds an item constructed in place from the given arguments.
      * @param key The key for the item.
-     * @param ptr A shared pointer to the item.
+     * @param args The constructor arguments of item<T>.
      * @return A shared pointer to the added item.
      */
+    template <typename T, typename... Args>
+    std::shared_ptr<item<T>> container::emplace(
+        const key& key,
+        Args&&... args
+    ) {
+        auto itemPtr = make_shared_in<item<T>>(this->resource(), std::forward<Args>(args)...);
+        /* add the item to the container, throws if the key already exists */
+        this->__insert(key, itemPtr, type_tag_of<T>::value);
+        return itemPtr;
+    }
+
+    template <typename T, typename... Args>
+    std::shared_ptr<item<T>> container::emplace(
+        std::string_view key,
+        Args&&... args
+    ) {
+        return this->emplace<T>(treecode::key(key), std::forward<Args>(args)...);
+    }
+
+
+    /**
+     * @brief Adds an inline slot to the container.
+     * @param key The key for the slot.
+     */
+    template <typename T>
+    void container::add_inline(
+        const key& key
+    ) {
+        static_assert(is_inline_type<T>, "add_inline requires one of the inline types, use add<T> otherwise");
+        entry e;
+        e.id = key;
+        e.tag = type_tag_of<T>::value;
+        e.is_inline = true;
+        /* add the slot to the container, throws if the key already exists */
+        this->__insert(std::move(e));
+    }
+
+    template <typename T>
+    void container::add_inline(
+        std::string_view key
+    ) {
+        this->add_inline<T>(treecode::key(key));
+    }
+
+
+    /**
+     * @brief Adds an inline slot to the container with a value.
+     * @param key The key for the slot.
+     * @param value The value for the slot.
+     */
+    template <typename T>
+    void container::add_inline(
+        const key& key,
+        const T& value
+    ) {
+        static_assert(is_inline_type<T>, "add_inline requires one of the inline types, use add<T> otherwise");
+        entry e;
+        e.id = key;
+        e.val.set(value);
+        e.tag = type_tag_of<T>::value;
+        e.is_inline = true;
+        /* add the slot to the container, throws if the key already exists */
+        this->__insert(std::move(e));
+    }
+
+    template <typename T>
+    void container::add_inline(
+        std::string_view key,
+        const T& value
+    ) {
+        this->add_inline<T>(treecode::key(key), value);
+    }
+
+
+    /**
+     * @brief Gets the value stored under a key, without materialising inline slots.
+     * @param key The key of the slot.
+     * @return The value, std::nullopt if no value is set.
+     */
+    #define GET_VALUE_IMPL() \
+        const entry& e = this->__slot(key); \
+        if (e.is_inline) { \
+            /* inline slot: compare the tags, no RTTI */ \
+            if (e.tag != type_tag_of<T>::value) Exception::Throw::Invalid(__label(key), Exception::ELEMENT_INVALID_TYPE); \
+            const T* v = e.val.template get_if<T>(); \
+            return v ? std::optional<T>(*v) : std::nullopt; \
+        } \
+        const item<T>* itemPtr = __item<T>(e); \
+        if (!itemPtr) Exception::Throw::Invalid(__label(key), Exception::ELEMENT_INVALID_TYPE); \
+        return itemPtr->data();
+
+    template <typename T>
+    std::optional<T> container::value(
+        const key& key
+    ) const {
+        GET_VALUE_IMPL()
+    }
+
+    template <typename T>
+    std::optional<T> container::value(
+        std::string_view key
+    ) const {
+        GET_VALUE_IMPL()
+    }
+
+
+    /**
+     * @brief Sets the value stored under a key.
+     * @param key The key of the slot.
+     * @param value The new value.
+     */
+    #define SET_VALUE_IMPL() \
+        entry& e = this->__slot(key); \
+        if (e.is_inline) { \
+            if constexpr (is_inline_type<T>) { \
+                if (e.tag == type_tag_of<T>::value) { e.val.set(value); this->__changed(e.id); return; } \
+            } \
+            Exception::Throw::Invalid(__label(key), Exception::ELEMENT_INVALID_TYPE); \
+        } \
+        if (e.shared) { this->__own(e); this->__changed(e.id); } \
+        item<T>* itemPtr = __item<T>(e); \
+        if (!itemPtr) Exception::Throw::Invalid(__label(key), Exception::ELEMENT_INVALID_TYPE); \
+        itemPtr->value(value);
+
+    template <typename T>
+    void container::value(
+        const key& key,
+        const T& value
+    ) {
+        SET_VALUE_IMPL()
+    }
+
+    template <typename T>
+    void container::value(
+        std::string_view key,
+        const T& value
+    ) {
+        SET_VALUE_IMPL()
+    }
+
+    #undef GET_VALUE_IMPL
+    #undef SET_VALUE_IMPL
+
+
+    /**
+     * @brief Gets an item from the container.
+     *        Inline slots are materialised into an item<T> on first access and shared
+     *        items are copied, by the constant version as well.
+     * @param key The key for the item.
+     * @return A shared pointer to the item, null if the item has another type.
+     */
+    #define GET_TYPED_ELEMENT_IMPL(SLOT) \
+        entry& e = SLOT; \
+        if (e.is_inline) { this->__materialise(e); this->__changed(e.id); } \
+        /* shared items are copied before an access that can write to them */ \
+        else if (e.shared) { this->__own(e); this->__changed(e.id); } \
+        /* inline types are resolved by tag, user types fall back to RTTI */ \
+        if constexpr (is_inline_type<T>) { \
+            return e.tag == type_tag_of<T>::value ? std::static_pointer_cast<item<T>>(e.ptr) : nullptr; \
+        } else { \
+            return std::dynamic_pointer_cast<item<T>>(e.ptr); \
+        }
+
     /* non-constant version of the method */
     template <typename T>
     std::shared_ptr<item<T>> container::get(
-        const std::string& key
+        const key& key
+    ) { 
+        GET_TYPED_ELEMENT_IMPL(this->__slot(key))
+    }
+
+    template <typename T>
+    std::shared_ptr<item<T>> container::get(
+        std::string_view key
     ) { 
-        auto basePtr = get(key);
-        return std::dynamic_pointer_cast<item<T>>(basePtr);
+        GET_TYPED_ELEMENT_IMPL(this->__slot(key))
     }
 
     /* constant version of the method */
+    /* the entries are mutable, the slot may be materialised or owned */
     template <typename T>
     std::shared_ptr<item<T>> container::get(
-        const std::string& key
+        const key& key
     ) const { 
-        auto basePtr = get(key);
-        return std::dynamic_pointer_cast<item<T>>(basePtr);
+        GET_TYPED_ELEMENT_IMPL(const_cast<entry&>(this->__slot(key)))
+    }
+
+    template <typename T>
+    std::shared_ptr<item<T>> container::get(
+        std::string_view key
+    ) const { 
+        GET_TYPED_ELEMENT_IMPL(const_cast<entry&>(this->__slot(key)))
+    }
+
+    #undef GET_TYPED_ELEMENT_IMPL
+
+
+    /**
+     * @brief Calls a function for every slot in insertion order.
+     * @param fn Callable invoked as fn(const item_view&).
+     */
+    template <typename F>
+    void container::for_each(
+        F&& fn
+    ) const {
+        for (const auto& e : this->__entries) if (e.live) fn(item_view(e));
+    }
+
+
+    /**
+     * @brief Finds the slot of a key.
+     * @param key The key to find.
+     * @return The slot.
+     * @throws std::out_of_range if the key is not found.
+     */
+    template <typename K>
+    container::entry& container::__slot(
+        const K& key
+    ) {
+        return const_cast<entry&>(static_cast<const container*>(this)->__slot(key));
+    }
+
+    template <typename K>
+    const container::entry& container::__slot(
+        const K& key
+    ) const {
+        const std::size_t pos = this->__find(key);
+        /* throw an exception if the key is not found */
+        if (pos == npos) Exception::Throw::Range(__label(key), Exception::CONTAINER_KEY_NOT_FOUND);
+        return this->__entries[pos];
+    }
+
+
+    /**
+     * @brief Gets the item of an item slot as item<T>.
+     * @param e The slot.
+     * @return The item, null if the slot holds another type.
+     */
+    template <typename T>
+    item<T>* container::__item(
+        const entry& e
+    ) {
+        if constexpr (is_inline_type<T>) return e.tag == type_tag_of<T>::value ? static_cast<item<T>*>(e.ptr.get()) : nullptr;
+        else return dynamic_cast<item<T>*>(e.ptr.get());
+    }
+
+
+    /**
+     * @brief Gets a pointer to the value of the slot if it has the given type.
+     * @return A pointer to the value, null if no value or another type is held.
+     */
+    template <typename T>
+    const T* container::item_view::get_if() const {
+        if (this->__entry->is_inline) return this->__entry->val.template get_if<T>();
+        const item<T>* itemPtr = __item<T>(*this->__entry);
+        return itemPtr ? itemPtr->value_ptr() : nullptr;
     }
 } // namespace treecode
 
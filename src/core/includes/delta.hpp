@@ -0,0 +1,168 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file delta.hpp
+ * @class delta
+ * @brief Header file for the delta class.
+ * @ingroup Core
+ *
+ * This file contains the definition of the delta class, the binary encoded
+ * changes turning one group tree into another, and the diff and apply
+ * functions producing and replaying them.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the delta class
+ */
+#ifndef DELTA_H
+#define DELTA_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "group.hpp"
+
+namespace treecode {
+    /**
+     * @class delta
+     * @brief The changes turning a group tree into another, in a compact binary encoding.
+     *
+     * A delta lists, group by group, the renamed root, the added and removed items,
+     * the changed values and required flags, and the removed, inserted and changed
+     * children. Children are compared in order: the equal subtrees at both ends of the
+     * child lists are skipped, children left in the middle are paired by position when
+     * they have the same name, replaced otherwise. Inserted subtrees are encoded whole.
+     * Shared subtrees are equal by address, others are first ruled out by group::hash,
+     * whose cache makes diffing a tree again after a few changes cost the changed paths
+     * only, and equal hashes are confirmed slot by slot, so a collision is never skipped.
+     *
+     * The encoding is self-contained and independent of the byte order and of the
+     * process, so deltas can be shipped to another process and replayed on its copy of
+     * the source tree. Integers are written as variable length integers, strings with
+     * their length.
+     *
+     * Usage:
+     *      treecode::delta changes = treecode::diff(shipped, current);
+     *      send(changes.bytes());
+     *      ...
+     *      treecode::apply(local_copy, treecode::delta(received));
+     */
+    class delta {
+    public:
+        /**
+         * @brief Encoding version, increased on every incompatible change of the format.
+         */
+        static constexpr std::uint8_t VERSION = 1;
+
+
+        /**
+         * @brief Default constructor, a delta without changes.
+         */
+        delta();
+
+
+        /**
+         * @brief Takes over an encoded delta.
+         * @param bytes The encoding, as returned by bytes().
+         * @throws std::runtime_error if the bytes are not a delta of a supported version.
+         */
+        explicit delta(
+            std::string bytes
+        );
+
+
+        /**
+         * @brief Gets the encoding of the delta.
+         * @return The bytes to ship or store.
+         */
+        const std::string& bytes() const { return this->__bytes; }
+
+
+        /**
+         * @brief Checks if the delta has no changes.
+         * @return True if applying the delta leaves a group unchanged.
+         */
+        bool empty() const;
+
+
+        /**
+         * @brief Computes the changes turning a group tree into another.
+         * @param from The source tree.
+         * @param to The target tree.
+         * @return The delta.
+         * @throws std::invalid_argument if an item has a user type.
+         */
+        static delta diff(
+            const group& from,
+            const group& to
+        );
+
+
+        /**
+         * @brief Replays the delta on a copy of its source tree.
+         *        Replaced and inserted items are added after the existing ones and children
+         *        are allocated from the resource of their parent. A renamed root is renamed
+         *        in place, the name index of its parent, if any, is not updated.
+         * @param target The tree, equal to the source tree of the delta.
+         * @throws std::runtime_error if the delta is corrupt or the tree does not match its source.
+         * @throws std::invalid_argument if a value is not an allowed choice of its item.
+         */
+        void apply(
+            group& target
+        ) const;
+
+    private:
+        /**
+         * @var std::string delta::__bytes
+         * The encoding of the delta.
+         */
+        std::string __bytes;
+    };
+
+
+    /**
+     * @brief Computes the changes turning a group tree into another, see delta::diff.
+     */
+    inline delta diff(
+        const group& from,
+        const group& to
+    ) {
+        return delta::diff(from, to);
+    }
+
+
+    /**
+     * @brief Replays a delta on a copy of its source tree, see delta::apply.
+     */
+    inline void apply(
+        group& target,
+        const delta& changes
+    ) {
+        changes.apply(target);
+    }
+} // namespace treecode
+
+#endif // DELTA_H
@@ -74,8 +74,46 @@ namespace treecode {
         const std::string NULL_GROUP = "Null pointer error: expected a non-null pointer to a group.";
     
     
+        /* Query Errors */
+        const std::string QUERY_EMPTY_STEP = "The query has an empty step.";
+        const std::string QUERY_UNTERMINATED = "The query has an unterminated predicate or quote.";
+        const std::string QUERY_INVALID_STEP = "The query has an invalid step.";
+        const std::string QUERY_INVALID_PREDICATE = "The query has an invalid predicate.";
+
+
         /* File Errors */
         const std::string FILE_OPEN_ERROR = "Unable to open the specified file.";
+        const std::string FILE_WRITE_ERROR = "Unable to write the specified file.";
+        const std::string FILE_MAP_ERROR = "Unable to map the specified file into memory.";
+
+
+        /* Snapshot Errors */
+        const std::string SNAPSHOT_BAD_MAGIC = "The data is not a snapshot.";
+        const std::string SNAPSHOT_BAD_VERSION = "The snapshot version or byte order is not supported.";
+        const std::string SNAPSHOT_CORRUPT = "The snapshot is truncated or corrupt.";
+        const std::string SNAPSHOT_USER_TYPE = "Items of user types cannot be written to a snapshot.";
+        const std::string SNAPSHOT_OUT_OF_RANGE = "The position is out of range of the snapshot record.";
+
+
+        /* JSON Errors */
+        const std::string JSON_SYNTAX = "The JSON text is malformed.";
+        const std::string JSON_NAME_FIRST = "A JSON group must start with its name.";
+        const std::string JSON_TYPE_MISMATCH = "The JSON value does not match the item type.";
+
+
+        /* Persistent Group Errors */
+        const std::string PERSISTENT_USER_TYPE = "Items of user types cannot be frozen.";
+        const std::string PERSISTENT_CHILD_OUT_OF_RANGE = "The child position is out of range.";
+
+
+        /* Delta Errors */
+        const std::string DELTA_CORRUPT = "The delta is truncated or corrupt.";
+        const std::string DELTA_MISMATCH = "The delta does not apply to the group.";
+        const std::string DELTA_USER_TYPE = "Items of user types cannot be compared in a delta.";
+
+
+        /* Group Errors */
+        const std::string GROUP_CHILD_OUT_OF_RANGE = "The child position is out of range of the group.";
     
         struct Throw {
             /**
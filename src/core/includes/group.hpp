@@ -42,30 +42,157 @@
  * @brief Include necessary headers
 */
 #include "container.hpp"
+#include "child_index.hpp"
+#include "pool.hpp"
+#include <atomic>
+#include <unordered_set>
 
 namespace treecode {
+    class group;
+
+
+    /**
+     * @class child_range
+     * @brief A read-only view on the child list of a group, random access over the list
+     *        the group allocates from its memory resource. Adding or removing children
+     *        invalidates it like the iterators of a vector, copy it into a vector to keep
+     *        the list across such changes.
+     */
+    class child_range {
+    public:
+        using value_type = std::shared_ptr<group>;
+        using iterator = const std::shared_ptr<group>*;
+        using const_iterator = iterator;
+
+        child_range() = default;
+
+        child_range(
+            const std::shared_ptr<group>* first,
+            std::size_t size
+        ) : __first(first), __size(size) {}
+
+        iterator begin() const { return this->__first; }
+        iterator end() const { return this->__first + this->__size; }
+        std::size_t size() const { return this->__size; }
+        bool empty() const { return this->__size == 0; }
+        const std::shared_ptr<group>& operator[](std::size_t pos) const { return this->__first[pos]; }
+        const std::shared_ptr<group>& front() const { return this->__first[0]; }
+        const std::shared_ptr<group>& back() const { return this->__first[this->__size - 1]; }
+
+        /**
+         * @brief Copies the children into a vector.
+         */
+        operator std::vector<std::shared_ptr<group>>() const { return {this->begin(), this->end()}; }
+
+    private:
+        const std::shared_ptr<group>* __first = nullptr;
+        std::size_t __size = 0;
+    };
+
+
     /**
      * @class group
      * @brief Represents a node in the tree structure.
      */
     class group {
     public:
-        group() = default;
-        ~group() = default;
+        group();
+        ~group();
         group(const std::string& name);
 
 
+        /**
+         * @brief Constructs a group bound to a memory resource.
+         *        The item container, the child list and the children and items added
+         *        later through this group are allocated from the resource.
+         * @param name The name of the group.
+         * @param resource The memory resource, e.g. a treecode::arena.
+         */
+        group(
+            const std::string& name,
+            std::pmr::memory_resource* resource
+        );
+
+
+        /**
+         * @brief Copies a group into a memory resource.
+         *        Items and children are shared with the source group, as with the copy constructor.
+         * @param other The group to copy.
+         * @param resource The memory resource for the copy.
+         */
+        group(
+            const group& other,
+            std::pmr::memory_resource* resource
+        );
+
+
+        /**
+         * @brief Moves a group into a memory resource.
+         *        Items and children are moved as a block if the resources are equal, one by one otherwise.
+         * @param other The group to move.
+         * @param resource The memory resource of the result.
+         */
+        group(
+            group&& other,
+            std::pmr::memory_resource* resource
+        );
+
+
+        /**
+         * @brief Copy and move operations, a copy allocates from the default resource.
+         *        Child indexes move with the group, copies have none. Copying a group read
+         *        lazily loads its items and children first, moving it keeps them pending.
+         */
+        group(const group& other);
+        group(group&& other);
+        group& operator=(const group& other);
+        group& operator=(group&& other);
+
+
+        /**
+         * @brief Gets the memory resource the group allocates from.
+         * @return The memory resource of the group.
+         */
+        std::pmr::memory_resource* resource() const;
+
+
+        /**
+         * @var group::NAME_INDEX_LIMIT
+         * Up to this many children, names are looked up and duplicates checked by scanning.
+         */
+        static constexpr std::size_t NAME_INDEX_LIMIT = 16U;
+
+
         /**
          * @brief Adds a child group to the current group.
+         *        A child already present is not added again, the check takes constant
+         *        time once the group has more than NAME_INDEX_LIMIT children.
          * @param child The child group to add.
          */
         void add(const std::shared_ptr<group>& child);
 
 
+        /* copies or moves the child, its items are shared with equal items of other
+           trees while interner::enabled(), see interner */
         void add(
             const group& child
         );
 
+        void add(
+            group&& child
+        );
+
+
+        /**
+         * @brief Creates an empty child group in place.
+         *        The child is allocated from the resource of the current group.
+         * @param name The name of the child group.
+         * @return A shared pointer to the child group.
+         */
+        std::shared_ptr<group> emplace_child(
+            const std::string& name
+        );
+
         /**
          * @brief Removes a child group from the current group.
          * @param child The child group to remove.
@@ -73,9 +200,26 @@ namespace treecode {
         void remove(const std::shared_ptr<group>& child);
 
 
+        /**
+         * @brief Gets a child for writing, replacing it by a copy first if other groups share it.
+         *        Children are shared by shallow copies of the group and by dedupe. The copy holds
+         *        clones of the items of the shared child, unlike a copy of the group, and shares
+         *        its children, so writing deeper down goes through own_child again on the way.
+         * @param pos The position of the child.
+         * @return The child, only held by this group.
+         * @throws std::out_of_range if pos is not the position of a child.
+         */
+        std::shared_ptr<group> own_child(
+            std::size_t pos
+        );
+
+
         /**
          * @brief Gets the container for items of the group.
+         *        Groups read lazily from a snapshot load their items and children on the
+         *        first call to this or any other method using them, see snapshot::read_lazy.
          * @return The container of the group.
+         * @throws std::runtime_error if the pending snapshot records are corrupt.
          */
         /* non-constant version of the method */
         container& items();
@@ -84,6 +228,103 @@ namespace treecode {
         const container& items() const;
 
 
+        /**
+         * @brief Indexes the children by the value they hold under a key.
+         *        The index follows children added and removed through the group and values
+         *        set through their containers or items, see child_index. Defining an index
+         *        of another kind on an indexed key replaces it.
+         * @param key The indexed key.
+         * @param kind index_kind::ordered to also support range lookups.
+         */
+        void add_index(
+            const key& key,
+            index_kind kind = index_kind::hash
+        );
+
+        void add_index(
+            std::string_view key,
+            index_kind kind = index_kind::hash
+        );
+
+
+        /**
+         * @brief Drops the index of a key.
+         * @param key The indexed key.
+         * @return True if an index was dropped.
+         */
+        bool drop_index(const key& key);
+
+        bool drop_index(std::string_view key);
+
+
+        /**
+         * @brief Gets the kind of the index of a key.
+         * @param key The indexed key.
+         * @return The kind, empty if the key is not indexed.
+         */
+        std::optional<index_kind> index_of(const key& key) const;
+
+        std::optional<index_kind> index_of(std::string_view key) const;
+
+
+        /**
+         * @brief Finds a child holding a value under a key.
+         *        Indexed keys are looked up in constant time, other keys are scanned.
+         * @param key The key.
+         * @param v The value, compared with its type.
+         * @return A child holding the value, the first one for scanned keys, null if none does.
+         */
+        std::shared_ptr<group> find_child(
+            const key& key,
+            const value& v
+        ) const;
+
+        std::shared_ptr<group> find_child(
+            std::string_view key,
+            const value& v
+        ) const;
+
+
+        /**
+         * @brief Finds the children holding a value under a key.
+         * @param key The key.
+         * @param v The value, compared with its type.
+         * @return The children holding the value, in child order for scanned keys and
+         *         in no particular order for indexed keys.
+         */
+        std::vector<std::shared_ptr<group>> find_children(
+            const key& key,
+            const value& v
+        ) const;
+
+        std::vector<std::shared_ptr<group>> find_children(
+            std::string_view key,
+            const value& v
+        ) const;
+
+
+        /**
+         * @brief Finds the children holding a value in [low, high] under a key.
+         *        Keys with an ordered index are looked up in logarithmic time, other keys are
+         *        scanned. Values are ordered by tag first, so the bounds must have the type of the values.
+         * @param key The key.
+         * @param low The lowest value.
+         * @param high The highest value.
+         * @return The children in the range, in value order for indexed keys and in child order otherwise.
+         */
+        std::vector<std::shared_ptr<group>> find_children(
+            const key& key,
+            const value& low,
+            const value& high
+        ) const;
+
+        std::vector<std::shared_ptr<group>> find_children(
+            std::string_view key,
+            const value& low,
+            const value& high
+        ) const;
+
+
         /**
          * @brief Gets the name of the group.
          * @return The name of the group.
@@ -93,12 +334,90 @@ namespace treecode {
 
         /**
          * @brief Gets the child groups of the current group.
-         * @return The child groups of the current group.
+         *        Children of a group read lazily are themselves pending until used.
+         * @return A view on the child groups of the current group.
+         */
+        child_range children() const;
+
+
+        /**
+         * @brief Gets the first child group with a name.
+         *        Groups with more than NAME_INDEX_LIMIT children look names up in constant time.
+         * @param name The name of the child group.
+         * @return The first child group with the name, null if there is none.
+         */
+        std::shared_ptr<group> child(
+            std::string_view name
+        ) const;
+
+
+        /**
+         * @brief Gets the child groups with a name.
+         * @param name The name of the child groups.
+         * @return The child groups with the name, in child order.
+         */
+        std::vector<std::shared_ptr<group>> children_named(
+            std::string_view name
+        ) const;
+
+
+        /**
+         * @brief Gets the content hash of the group and its subtree.
+         *        The hash covers the name, the items (keys, type tags, values, required and
+         *        inline flags, choices) and the hashes of the children in order, so groups with
+         *        equal content have equal hashes. It is cached and computed again only for the
+         *        groups changed since, and their ancestors: adding or removing children and
+         *        every change made through the container of the group or through one of its
+         *        items, including kept references, item pointers and copies of the group
+         *        sharing the item, drop the cache of the group and of every group above it. Items of user types must call base::__notify or
+         *        base::__touched when they change. The hash does not depend on addresses or on
+         *        the process, it is stable across runs on platforms of the same byte order.
+         *        Safe to call concurrently with other constant methods.
+         * @return The hash, never 0.
+         */
+        std::uint64_t hash() const;
+
+
+        /**
+         * @brief Creates an independent copy of the group and its subtree.
+         *        Items are cloned and every child group is copied, nothing is shared with the source.
+         * @param resource The memory resource of the copy, null for the default resource.
+         * @return The copy of the group.
+         */
+        group deep_copy(
+            std::pmr::memory_resource* resource = nullptr
+        ) const;
+
+
+        /**
+         * @brief Creates an independent copy of the group and its subtree on a thread pool.
+         *        Child subtrees are copied by parallel tasks of at least options.grain groups,
+         *        the copy allocates from the default resource. The source must not be modified
+         *        during the copy.
+         * @param options The pool and grain size of the copy.
+         * @return The copy of the group.
          */
-        const std::vector<std::shared_ptr<group>>& children() const;
+        group deep_copy(
+            const parallel& options
+        ) const;
 
 
     private:
+        /* containers drop the cached hash of the group holding them when they change */
+        friend class container;
+        /* templates attach the instances they create without the duplicate check */
+        friend class tmpl;
+        /* queries compare the names of the children without copying them */
+        friend class query;
+        /* snapshots write and read the names and children directly, and load lazy groups */
+        friend class snapshot;
+        /* deltas rename roots and splice children at positions */
+        friend class delta;
+        /* interners compare groups slot by slot and replace children by shared instances */
+        friend class interner;
+        /* validators match the names of the children to plans without copying them */
+        friend class validator;
+
         /**
          * @var std::string group::__name
          * The name of the group.
@@ -108,14 +427,246 @@ namespace treecode {
         /**
          * @var container group::__container
          * The container of the group.
+         * Mutable so that constant groups read lazily can load it.
          */
-        container __container;
+        mutable container __container;
 
         /**
-         * @var std::vector<std::shared_ptr<group>> group::__children
+         * @var std::pmr::vector<std::shared_ptr<group>> group::__children
          * The child groups of the current group.
+         * Mutable so that constant groups read lazily can load them.
+         */
+        mutable std::pmr::vector<std::shared_ptr<group>> __children;
+
+        /**
+         * @var child_index_ptr group::__indexes
+         * The value indexes over the children, null until an index is defined.
+         * Declared last so it stops observing before the children are released.
+         */
+        child_index_ptr __indexes;
+
+        /**
+         * @struct name_index
+         * @brief The children of a large group by address and by name.
+         */
+        struct name_index {
+            /* the children of one name, in child order, with the name the key views */
+            struct named_children {
+                std::string name;
+                std::vector<std::shared_ptr<group>> groups;
+            };
+
+            std::unordered_set<const group*> members;
+            std::unordered_map<std::string_view, std::unique_ptr<named_children>> named;   /* looked up without copying the name */
+
+            /**
+             * @brief Gets the children of a name, adding an empty list for a new name.
+             */
+            std::vector<std::shared_ptr<group>>& of(
+                const std::string& name
+            );
+        };
+
+        /**
+         * @struct name_index_ptr
+         * @brief The name index, built once the group has more than NAME_INDEX_LIMIT children,
+         *        which copies of the group do not carry over.
+         */
+        struct name_index_ptr {
+            mutable std::atomic<name_index*> ptr{nullptr};
+
+            name_index_ptr() = default;
+            name_index_ptr(const name_index_ptr&) {}
+            name_index_ptr(name_index_ptr&& other) noexcept : ptr(other.ptr.exchange(nullptr)) {}
+            name_index_ptr& operator=(const name_index_ptr&) { delete this->ptr.exchange(nullptr); return *this; }
+            name_index_ptr& operator=(name_index_ptr&& other) noexcept { delete this->ptr.exchange(other.ptr.exchange(nullptr)); return *this; }
+            ~name_index_ptr() { delete this->ptr.load(); }
+        };
+
+        /**
+         * @var name_index_ptr group::__names
+         * The name index over the children, null for small groups.
+         */
+        name_index_ptr __names;
+
+        /**
+         * @struct lazy_node
+         * @brief The snapshot record the items and children of a lazily read group are loaded from.
+         */
+        struct lazy_node {
+            std::shared_ptr<const void> source;     /* the snapshot image and the state shared by its loads */
+            std::uint64_t offset;                   /* the offset of the node record */
+        };
+
+        /**
+         * @struct lazy_ptr
+         * @brief The pending record of the group, null once loaded, which copies do not carry over.
+         */
+        struct lazy_ptr {
+            mutable std::atomic<lazy_node*> ptr{nullptr};
+
+            lazy_ptr() = default;
+            lazy_ptr(const lazy_ptr&) {}
+            lazy_ptr(lazy_ptr&& other) noexcept : ptr(other.ptr.exchange(nullptr)) {}
+            lazy_ptr& operator=(const lazy_ptr&) { delete this->ptr.exchange(nullptr); return *this; }
+            lazy_ptr& operator=(lazy_ptr&& other) noexcept { delete this->ptr.exchange(other.ptr.exchange(nullptr)); return *this; }
+            ~lazy_ptr() { delete this->ptr.load(); }
+        };
+
+        /**
+         * @var lazy_ptr group::__lazy
+         * The pending snapshot record, null for groups that are not read lazily or already loaded.
+         */
+        lazy_ptr __lazy;
+
+        /**
+         * @struct hash_cache
+         * @brief The cached content hash, 0 until computed and after a change, which copies do not carry over.
+         *        The version counts the changes that dropped a cached hash, so it moves on the first
+         *        change after each hash() even when the content hash would come out the same.
+         */
+        struct hash_cache {
+            mutable std::atomic<std::uint64_t> value{0};
+            mutable std::atomic<std::uint64_t> version{0};
+
+            hash_cache() = default;
+            hash_cache(const hash_cache&) {}
+            hash_cache& operator=(const hash_cache&) {
+                this->value.store(0, std::memory_order_relaxed);
+                this->version.fetch_add(1, std::memory_order_release);
+                return *this;
+            }
+        };
+
+        /**
+         * @var hash_cache group::__hash
+         * The cached content hash. A group with a cached hash has the hashes of all its
+         * descendants cached, so dropping caches up the tree stops at the first group without one.
          */
-        std::vector<std::shared_ptr<group>> __children;
+        hash_cache __hash;
+
+        /**
+         * @struct parent_links
+         * @brief The groups holding the group as a child, which copies and moves do not carry over.
+         */
+        struct parent_links {
+            const group* first = nullptr;
+            std::unique_ptr<std::unordered_multiset<const group*>> more;    /* the other parents of a shared child */
+
+            parent_links() = default;
+            parent_links(const parent_links&) {}
+            parent_links& operator=(const parent_links&) { return *this; }
+        };
+
+        /**
+         * @var parent_links group::__parents
+         * The parents of the group, whose cached hashes are dropped when the group changes.
+         */
+        parent_links __parents;
+
+        /**
+         * @brief Loads the items and children of a group read lazily, once.
+         *        Safe to call concurrently with other constant methods.
+         */
+        void __load() const { if (this->__lazy.ptr.load(std::memory_order_acquire)) this->__load_pending(); }
+
+        /**
+         * @brief Loads the pending record under a lock, see __load.
+         */
+        void __load_pending() const;
+
+        /**
+         * @brief Gets the name index, building it for a group that outgrew NAME_INDEX_LIMIT.
+         *        Safe to call concurrently with other constant methods.
+         * @return The name index, null if the group is small enough to be scanned.
+         */
+        const name_index* __name_index() const;
+
+        /**
+         * @brief Files a child appended to __children in the name index and the child indexes.
+         * @param child The child.
+         */
+        void __attached(
+            const std::shared_ptr<group>& child
+        );
+
+        /**
+         * @brief Files the children of a range of __children, already in place, in the name index.
+         * @param names The name index.
+         * @param pos The position of the first child.
+         * @param count The number of children.
+         */
+        void __index_names(
+            name_index& names,
+            std::size_t pos,
+            std::size_t count
+        ) const;
+
+        /**
+         * @brief Takes one occurrence of a child no longer in __children out of the name index.
+         * @param names The name index.
+         * @param child The child.
+         */
+        void __unindex_name(
+            name_index& names,
+            const std::shared_ptr<group>& child
+        ) const;
+
+        /**
+         * @brief Records, forgets or moves a parent of the group.
+         *        Links of a group are guarded by a lock stripe, shallow copies of a shared
+         *        tree made concurrently link the same children.
+         */
+        void __link(const group* parent);
+        void __unlink(const group* parent);
+        void __relink(const group* from, const group* to);
+
+        /**
+         * @brief Checks if the group is held by more than one group.
+         */
+        bool __shared() const;
+
+        /**
+         * @brief Drops the cached hash of the group and of its ancestors that have one,
+         *        and moves the version of each group whose hash it drops.
+         */
+        void __invalidate() const;
+
+        /**
+         * @brief Replaces a child by a group of equal content, the cached hashes stay valid.
+         * @param pos The position of the child.
+         * @param child The group taking its place.
+         */
+        void __replace(
+            std::size_t pos,
+            const std::shared_ptr<group>& child
+        );
+
+        /**
+         * @brief Replaces a range of children, keeping the child indexes up to date.
+         * @param pos The position of the first replaced child.
+         * @param count The number of children removed at pos.
+         * @param inserted The children inserted at pos, in order.
+         */
+        void __splice(
+            std::size_t pos,
+            std::size_t count,
+            const std::vector<std::shared_ptr<group>>& inserted
+        );
+
+        /**
+         * @brief Copies the items and the subtree of a group into an empty group.
+         * @param src The group to copy.
+         * @param dst The group receiving the copy, its resource is used for the whole subtree.
+         * @param tasks The task group forking child subtrees, null for a serial copy.
+         * @param grain The minimum number of groups copied by a forked task.
+         */
+        static void __deep_copy(
+            const group& src,
+            group& dst,
+            task_group* tasks,
+            std::size_t grain
+        );
     };
 } // namespace treecode
 
@@ -0,0 +1,256 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file interner.hpp
+ * @class interner
+ * @brief Header file for the interner class and the dedupe function.
+ * @ingroup Core
+ *
+ * This file contains the definition of the interner class, a table of shared
+ * group and item instances that collapses equal subtrees and items of trees
+ * into one instance, and of the dedupe function running it over a tree.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the interner class
+ */
+#ifndef INTERNER_H
+#define INTERNER_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "group.hpp"
+#include <mutex>
+
+namespace treecode {
+    /**
+     * @struct dedupe_stats
+     * @brief The number of groups and items a pass replaced by a shared instance.
+     */
+    struct dedupe_stats {
+        std::size_t groups = 0;     /* children replaced, the subtrees below them are not counted */
+        std::size_t items = 0;      /* item slots pointed at a shared item */
+    };
+
+
+    /**
+     * @class interner
+     * @brief Table of shared instances of equal subtrees and items.
+     *
+     * Interning a tree replaces, bottom up, every child equal to a subtree seen before
+     * by that subtree, and every item equal to an item seen before by that item. Groups
+     * are looked up by group::hash and confirmed slot by slot, so a hash collision never
+     * merges different subtrees. Items are shared through the copy on write slots of
+     * their containers: a shared item is copied before its first write through any
+     * container. Shared groups are held by several parents and must only be written
+     * through group::own_child, which gives the writing parent a copy first.
+     *
+     * Items of user types, items and groups followed by a child index, and groups
+     * allocated from another resource than the parent of a duplicate are kept apart.
+     * The table only holds weak references, instances no tree uses any more are
+     * released and their entries dropped on a later sweep. An interner is thread-safe.
+     *
+     * With interner::enable(true), group::add copying or moving a subtree shares the
+     * items of the subtree through interner::shared(). The added groups stay its own,
+     * so writing through the children of a group never reaches another tree.
+     *
+     * Usage:
+     *      treecode::dedupe_stats saved = treecode::dedupe(catalogue);
+     *      ...
+     *      catalogue.own_child(3)->items().value<std::string>("VALUE", "RW");
+     */
+    class interner {
+    public:
+        /**
+         * @brief Default constructor, an empty table.
+         */
+        interner() = default;
+
+
+        /**
+         * @brief Interners own their table and can be neither copied nor moved.
+         */
+        interner(const interner&) = delete;
+        interner& operator=(const interner&) = delete;
+
+
+        /**
+         * @brief Interns a subtree: its descendants and items, then the subtree itself.
+         * @param subtree The subtree, its descendants are replaced in place.
+         * @return The shared instance of an equal subtree, the subtree itself if it is the first.
+         */
+        std::shared_ptr<group> intern(
+            const std::shared_ptr<group>& subtree
+        );
+
+
+        /**
+         * @brief Interns the items of a subtree and of its descendants, its groups are kept.
+         * @param subtree The subtree.
+         * @return The number of items pointed at a shared item.
+         */
+        std::size_t intern_items(
+            group& subtree
+        );
+
+
+        /**
+         * @brief Interns the children and items of a tree, the root itself is kept.
+         * @param root The tree.
+         * @return The number of replaced children and items.
+         */
+        dedupe_stats dedupe(
+            group& root
+        );
+
+
+        /**
+         * @brief Gets the number of entries of the table, released instances included until swept.
+         * @return The number of group and item entries.
+         */
+        std::size_t size() const;
+
+
+        /**
+         * @brief Forgets every instance, trees already interned keep sharing theirs.
+         */
+        void clear();
+
+
+        /**
+         * @brief Gets the process wide interner, used by group::add while interning is enabled.
+         * @return The shared interner.
+         */
+        static interner& shared();
+
+
+        /**
+         * @brief Turns the process wide interning of added subtrees on or off.
+         * @param on True to intern the subtrees added by copy or move.
+         */
+        static void enable(
+            bool on
+        );
+
+
+        /**
+         * @brief Checks if added subtrees are interned.
+         * @return True if interning is enabled.
+         */
+        static bool enabled();
+
+    private:
+        /**
+         * @var std::mutex interner::__mutex
+         * Guards the tables, a pass holds it from start to end.
+         */
+        mutable std::mutex __mutex;
+
+        /**
+         * @var std::unordered_multimap<std::uint64_t, std::weak_ptr<group>> interner::__groups
+         * The shared groups by content hash.
+         */
+        std::unordered_multimap<std::uint64_t, std::weak_ptr<group>> __groups;
+
+        /**
+         * @struct shared_item
+         * @brief A shared item and the resource of the containers holding it.
+         */
+        struct shared_item {
+            std::weak_ptr<base> ptr;
+            std::pmr::memory_resource* resource;
+        };
+
+        /**
+         * @var std::unordered_multimap<std::uint64_t, shared_item> interner::__items
+         * The shared items by content hash.
+         */
+        std::unordered_multimap<std::uint64_t, shared_item> __items;
+
+        /**
+         * @var std::size_t interner::__sweep_at
+         * The table size past which released entries are swept.
+         */
+        std::size_t __sweep_at = 1024;
+
+        /**
+         * @brief Interns the items and the descendants of a group, skipping groups already visited.
+         *        Children are replaced by their shared instance unless only items are interned.
+         */
+        void __walk(
+            group& g,
+            std::unordered_set<const group*>& visited,
+            dedupe_stats& stats,
+            bool groups = true
+        );
+
+        /**
+         * @brief Finds or files the shared instance of a group whose descendants are interned.
+         */
+        std::shared_ptr<group> __group(
+            const std::shared_ptr<group>& g
+        );
+
+        /**
+         * @brief Finds or files the shared instance of an item held by containers of a resource.
+         */
+        std::shared_ptr<base> __item(
+            const std::shared_ptr<base>& item,
+            std::pmr::memory_resource* resource
+        );
+
+        /**
+         * @brief Checks if two groups whose descendants and items are interned are equal.
+         *        Children and items are compared by address, inline slots by value.
+         */
+        static bool __same(
+            const group& a,
+            const group& b
+        );
+
+        /**
+         * @brief Drops the entries of released instances once the tables grew past __sweep_at.
+         */
+        void __sweep();
+    };
+
+
+    /**
+     * @brief Collapses the equal subtrees and items of a tree into shared instances.
+     *        Runs a table of its own, see interner::dedupe for a table shared by several trees.
+     * @param root The tree.
+     * @return The number of replaced children and items.
+     */
+    inline dedupe_stats dedupe(
+        group& root
+    ) {
+        interner table;
+        return table.dedupe(root);
+    }
+} // namespace treecode
+
+#endif // INTERNER_H
@@ -44,6 +44,7 @@
 */
 #include "common.hpp"
 #include "base.hpp"
+#include "arena.hpp"
 
 /**
  * @def FIRST_ITEM
@@ -75,6 +76,10 @@ namespace treecode
             const T& value
         );
 
+        item(
+            T&& value
+        );
+
 
         /**
          * @brief Constructs an item with multi choice values.
@@ -84,6 +89,15 @@ namespace treecode
             const std::vector<T>& choices
         );
 
+        item(
+            std::vector<T>&& choices
+        );
+
+        /* shares the choice list with other items */
+        item(
+            std::shared_ptr<const std::vector<T>> choices
+        );
+
 
         /**
          * @brief Sets the value of the item.
@@ -101,6 +115,28 @@ namespace treecode
         std::optional<T> data() const;
 
 
+        /**
+         * @brief Gets a pointer to the current value without copying it.
+         * @return A pointer to the value, null if no value is set.
+         */
+        const T* value_ptr() const;
+
+
+        /**
+         * @brief Gets the multi choice values without copying them.
+         *        Items cloned from one another share the same list.
+         * @return A pointer to the choices, null if the item has none.
+         */
+        const std::vector<T>* choices_ptr() const;
+
+
+        /**
+         * @brief Gets the type tag of the item.
+         * @return The tag of T, type_tag::user for types without inline storage.
+         */
+        type_tag tag() const override;
+
+
         /**
          * @brief Gets the multi choice values for the item.
          * @return A vector of multi choice  values.
@@ -128,11 +164,21 @@ namespace treecode
         std::shared_ptr<base> clone() const override;
 
 
-                /**
+        /**
+         * @brief Clone the item into a memory resource.
+         * @param resource The memory resource to allocate the clone from.
+         * @return A shared pointer to the cloned item.
+         */
+        std::shared_ptr<base> clone(
+            std::pmr::memory_resource* resource
+        ) const override;
+
+
+        /**
          * @brief Checks if the value is set.
          * @return True if the value is set, false otherwise.
          */
-        bool is_value_set() const;
+        bool is_value_set() const override;
 
 
         /**
@@ -149,10 +195,10 @@ namespace treecode
         std::optional<T> __value;
 
         /**
-         * @var std::vector<T> item::__choices
-         * The allowed values for the item.
+         * @var std::shared_ptr<const std::vector<T>> item::__choices
+         * The allowed values for the item, immutable and shared by the clones of the item.
          */
-        std::vector<T> __choices;
+        std::shared_ptr<const std::vector<T>> __choices;
 
         /**
          * @var bool item::__isChoices
@@ -186,6 +232,11 @@ namespace treecode
         const T& value
     ) : item() { this->__value = value; }
 
+    template <typename T>
+    item<T>::item(
+        T&& value
+    ) : item() { this->__value = std::move(value); }
+
 
     /**
      * @brief Constructs an item with multi choice values.
@@ -194,11 +245,22 @@ namespace treecode
     template <typename T>
     item<T>::item(
         const std::vector<T>& choices
-    ) : __choices(choices),
-        __isChoices(true) {
-        if (!choices.empty()) {
+    ) : item(std::vector<T>(choices)) {}
+
+    template <typename T>
+    item<T>::item(
+        std::vector<T>&& choices
+    ) : item(std::make_shared<const std::vector<T>>(std::move(choices))) {}
+
+    template <typename T>
+    item<T>::item(
+        std::shared_ptr<const std::vector<T>> choices
+    ) : __choices(std::move(choices)),
+        __isChoices(true),
+        __isRequired(false) {
+        if (this->__choices && !this->__choices->empty()) {
             /* Set the default value to the first allowed value */
-            this->__value = choices[FIRST_ITEM];
+            this->__value = (*this->__choices)[FIRST_ITEM];
             /* Set the required flag */
             this->__isRequired = true;
         } else Exception::Throw::Invalid("Multivalue Element", Exception::ELEMENT_ALLOWED_VALUES_EMPTY); /* Throw an exception if the allowed values list is empty */
@@ -215,7 +277,7 @@ namespace treecode
     ) {
         if (this->__isChoices) {
             /* check if value is in the allowed values list */
-            if (std::find(this->__choices.begin(), this->__choices.end(), value) != this->__choices.end()) {
+            if (std::find(this->__choices->begin(), this->__choices->end(), value) != this->__choices->end()) {
                 /* set the value and the value set flag */
                 this->__value = value;
             }
@@ -227,6 +289,7 @@ namespace treecode
             /* set the value */
             this->__value = value;
         }
+        this->__notify();
     }
 
 
@@ -240,6 +303,34 @@ namespace treecode
     }
 
 
+    /**
+     * @brief Gets a pointer to the current value without copying it.
+     * @return A pointer to the value, null if no value is set.
+     */
+    template <typename T>
+    const T* item<T>::value_ptr() const {
+        return this->__value.has_value() ? &*this->__value : nullptr;
+    }
+
+
+    /**
+     * @brief Gets the multi choice values without copying them.
+     * @return A pointer to the choices, null if the item has none.
+     */
+    template <typename T>
+    const std::vector<T>* item<T>::choices_ptr() const {
+        return this->__isChoices ? this->__choices.get() : nullptr;
+    }
+
+
+    /**
+     * @brief Gets the type tag of the item.
+     * @return The tag of T, type_tag::user for types without inline storage.
+     */
+    template <typename T>
+    type_tag item<T>::tag() const { return type_tag_of<T>::value; }
+
+
     /**
      * @brief Gets the multi choice values for the item.
      * @return A vector of multi choice  values.
@@ -252,7 +343,7 @@ namespace treecode
             return {}; // Return an empty vector to satisfy the return type
         }
         /* return the allowed values */
-        else return this->__choices;
+        else return *this->__choices;
     }
 
 
@@ -269,7 +360,10 @@ namespace treecode
      * @return void
      */
     template <typename T>
-    void item<T>::required() { this->__isRequired = true; }
+    void item<T>::required() {
+        this->__isRequired = true;
+        this->__touched();
+    }
 
 
     /**
@@ -282,6 +376,19 @@ namespace treecode
     }
 
 
+    /**
+     * @brief Clone the item into a memory resource.
+     * @param resource The memory resource to allocate the clone from.
+     * @return A shared pointer to the cloned item.
+     */
+    template <typename T>
+    std::shared_ptr<base> item<T>::clone(
+        std::pmr::memory_resource* resource
+    ) const {
+        return make_shared_in<item<T>>(resource, *this);
+    }
+
+
         /**
      * @brief Checks if the value is set.
      * @return True if the value is set, false otherwise.
@@ -299,6 +406,7 @@ namespace treecode
     template <typename T>
     void item<T>::clear_value() {
         this->__value.reset();
+        this->__notify();
     }
 } // namespace treecode
 
@@ -0,0 +1,200 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file json.hpp
+ * @class json
+ * @brief Header file for the json class.
+ * @ingroup Core
+ *
+ * This file contains the json class, which streams group trees to JSON text
+ * and reads JSON text back as events or as a tree typed by a template.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the json class
+ */
+#ifndef JSON_H
+#define JSON_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "tmpl.hpp"
+#include <iosfwd>
+
+namespace treecode {
+    /**
+     * @struct json_options
+     * @brief The layout of the text written by json::write.
+     */
+    struct json_options {
+        bool pretty = false;                /* indent the text, one item or group per line */
+        std::size_t buffer = 1U << 16;      /* the number of bytes formatted before each write to the stream */
+    };
+
+
+    /**
+     * @class json
+     * @brief Streams group trees to and from JSON text.
+     *
+     * A group is written as an object holding its name first, then its items by key
+     * and its children in order:
+     *      {"name":"DID","items":{"ID":"FD01","SIZE":4},"children":[{"name":"ELEMENT",...}]}
+     * Items without a value and items of user types are written as null, non finite
+     * floating point values as null as well.
+     *
+     * Writing walks the tree without recursion and formats values straight into a
+     * fixed size buffer flushed to the stream, no string is built per item. Reading
+     * pulls characters from the stream and reports groups and items to a handler as
+     * they are parsed, so the memory used besides the handler's is bounded by the
+     * nesting depth and the longest string.
+     *
+     * Usage:
+     *      treecode::json::write(did_tree, std::cout);
+     *      treecode::group did_tree = treecode::json::read(file, did_tmpl);
+     */
+    class json {
+    public:
+        /**
+         * @typedef options
+         * The layout of the written text.
+         */
+        using options = json_options;
+
+
+        /**
+         * @class handler
+         * @brief Receives the groups and items of a JSON text in document order.
+         */
+        class handler {
+        public:
+            virtual ~handler() = default;
+
+            /**
+             * @brief Called when a group starts, before its items and children.
+             * @param name The name of the group, valid during the call.
+             */
+            virtual void begin_group(std::string_view name) = 0;
+
+            /**
+             * @brief Called for every item of the current group.
+             * @param key The key of the item, valid during the call.
+             * @param v The value, strings as std::string, integers as int64 or uint64 if
+             *          they do not fit, other numbers as double, no value for null.
+             */
+            virtual void item(std::string_view key, const value& v) = 0;
+
+            /**
+             * @brief Called when the current group ends, after its children.
+             */
+            virtual void end_group() = 0;
+        };
+
+
+        /**
+         * @brief Writes a tree to a stream.
+         * @param root The root group.
+         * @param out The stream.
+         * @param opts The layout of the text.
+         * @throws std::runtime_error if the stream fails.
+         */
+        static void write(
+            const group& root,
+            std::ostream& out,
+            const options& opts = options()
+        );
+
+
+        /**
+         * @brief Writes a tree to a file.
+         * @param root The root group.
+         * @param path The path of the file, replaced if it exists.
+         * @param opts The layout of the text.
+         * @throws std::runtime_error if the file cannot be written.
+         */
+        static void write(
+            const group& root,
+            const std::string& path,
+            const options& opts = options()
+        );
+
+
+        /**
+         * @brief Parses a JSON group from a stream and reports it to a handler.
+         *        Keys other than name, items and children are skipped.
+         * @param in The stream, read up to the end of the group.
+         * @param events The handler.
+         * @throws std::runtime_error if the text is malformed.
+         */
+        static void parse(
+            std::istream& in,
+            handler& events
+        );
+
+
+        /**
+         * @brief Reads a tree from a stream, typed by a template.
+         *        A group named like a group of the template is cloned from it, so its items
+         *        keep their types, choices and required flags and only receive the values of
+         *        the text. Its children in the text are matched in order with the cloned
+         *        children of the same name, children missing from the text keep the values
+         *        of the template. Other groups and items are created with the type of their
+         *        JSON value, std::string, std::int64_t, std::uint64_t, double or bool, and
+         *        null items without a slot are skipped.
+         * @param in The stream.
+         * @param schema The template.
+         * @param resource The memory resource of the tree, null for the default resource.
+         * @return The root group.
+         * @throws std::runtime_error if the text is malformed.
+         * @throws std::invalid_argument if a value does not fit the type of its item or its choices.
+         * @throws std::out_of_range if an integer is out of the range of the type of its item.
+         */
+        static group read(
+            std::istream& in,
+            const tmpl& schema,
+            std::pmr::memory_resource* resource = nullptr
+        );
+
+
+        /**
+         * @brief Reads a tree from a file, typed by a template.
+         * @param path The path of the file.
+         * @param schema The template.
+         * @param resource The memory resource of the tree, null for the default resource.
+         * @return The root group.
+         * @throws std::runtime_error if the file cannot be opened or the text is malformed.
+         * @throws std::invalid_argument if a value does not fit the type of its item or its choices.
+         * @throws std::out_of_range if an integer is out of the range of the type of its item.
+         */
+        static group read(
+            const std::string& path,
+            const tmpl& schema,
+            std::pmr::memory_resource* resource = nullptr
+        );
+    };
+} // namespace treecode
+
+#endif // JSON_H
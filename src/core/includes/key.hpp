@@ -0,0 +1,151 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file key.hpp
+ * @class key
+ * @brief Header file for the key class.
+ * @ingroup Core
+ *
+ * This file contains the definition of the key class, an interned item key.
+ * Every distinct key string is stored once in a process wide atom table and
+ * containers hold a pointer sized handle to it, with its hash precomputed.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the key class
+ */
+#ifndef KEY_H
+#define KEY_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "common.hpp"
+#include <string_view>
+
+namespace treecode {
+    /**
+     * @class key
+     * @brief Represents an interned item key.
+     *
+     * Two keys are equal if and only if they refer to the same atom, so comparing
+     * keys is a pointer comparison. Atoms are never released; the table only grows
+     * with the number of distinct key strings used by the process.
+     */
+    class key {
+    public:
+        /**
+         * @brief Default constructor, refers to the empty key.
+         */
+        key();
+
+
+        /**
+         * @brief Interns a key string.
+         * @param name The key string.
+         */
+        explicit key(
+            std::string_view name
+        );
+
+
+        /**
+         * @brief Gets the key string.
+         * @return The interned string.
+         */
+        const std::string& str() const;
+
+
+        /**
+         * @brief Gets the key string as a view.
+         * @return A view on the interned string.
+         */
+        std::string_view view() const;
+
+
+        /**
+         * @brief Gets the precomputed hash of the key.
+         * @return The hash of the key, equal to key::hash_of(view()).
+         */
+        std::uint32_t hash() const;
+
+
+        /**
+         * @brief Hashes a key string the same way interned keys are hashed.
+         * @param name The key string.
+         * @return The hash of the key string.
+         */
+        static std::uint32_t hash_of(
+            std::string_view name
+        );
+
+
+        /**
+         * @brief Compares two keys.
+         * @return True if both keys refer to the same atom.
+         */
+        bool operator==(const key& other) const { return this->__atom == other.__atom; }
+        bool operator!=(const key& other) const { return this->__atom != other.__atom; }
+
+    private:
+        /**
+         * @struct atom
+         * @brief An entry of the atom table.
+         */
+        struct atom {
+            std::string text;
+            std::uint32_t hash;
+        };
+
+        /**
+         * @var const atom* key::__atom
+         * The interned atom of the key.
+         */
+        const atom* __atom;
+
+        /**
+         * @brief Finds or creates the atom of a key string.
+         * @param name The key string.
+         * @return The interned atom.
+         */
+        static const atom* __intern(
+            std::string_view name
+        );
+    };
+} // namespace treecode
+
+
+/**
+ * @brief Hash support so keys can be used in standard unordered containers.
+ */
+namespace std {
+    template <>
+    struct hash<treecode::key> {
+        std::size_t operator()(const treecode::key& k) const noexcept { return k.hash(); }
+    };
+} // namespace std
+
+#endif // KEY_H
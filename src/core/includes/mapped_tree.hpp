@@ -0,0 +1,331 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file mapped_tree.hpp
+ * @class mapped_tree
+ * @brief Header file for the mapped_tree class.
+ * @ingroup Core
+ *
+ * This file contains the mapped_tree class, a read-only view of a snapshot
+ * file mapped into memory, and the views on its groups and items.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the mapped_tree class
+ */
+#ifndef MAPPED_TREE_H
+#define MAPPED_TREE_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "snapshot.hpp"
+
+namespace treecode {
+    /**
+     * @class mapped_tree
+     * @brief Read-only access to a snapshot file without building the tree.
+     *
+     * The file is mapped read-only into memory and the views read the records in
+     * place: groups and items are offsets into the mapping and strings are views into
+     * its string table. Nothing is allocated until a subtree is materialised, and
+     * processes mapping the same file share its pages through the page cache.
+     *
+     * Views are valid as long as the mapped_tree they come from, which can be read
+     * from any number of threads. Records are bounds checked when a view is created,
+     * so a corrupt file raises std::runtime_error rather than reading out of bounds.
+     *
+     * Usage:
+     *      treecode::mapped_tree catalogue("catalogue.tcs");
+     *      auto did = catalogue.root().child("DID");
+     *      if (did) std::cout << did->find("ID")->get<std::string>().value_or("");
+     */
+    class mapped_tree {
+    public:
+        /**
+         * @class item_view
+         * @brief Read-only view on a slot of a mapped group.
+         */
+        class item_view {
+        public:
+            /**
+             * @brief Gets the key of the slot.
+             * @return A view into the mapping.
+             */
+            std::string_view id() const { return this->__image->string(this->__record.key); }
+
+
+            /**
+             * @brief Gets the type tag of the slot.
+             * @return The type tag of the stored value.
+             */
+            type_tag tag() const { return static_cast<type_tag>(this->__record.tag); }
+
+
+            /**
+             * @brief Checks the flags of the slot, as written from the container.
+             */
+            bool is_inline() const { return this->__record.flags & snapshot::ITEM_INLINE; }
+            bool is_required() const { return this->__record.flags & snapshot::ITEM_REQUIRED; }
+            bool has_value() const { return this->__record.flags & snapshot::ITEM_VALUE; }
+
+
+            /**
+             * @brief Gets the value of the slot if it has the given type.
+             * @return The value, strings as views into the mapping, no value if none is set or T does not match the tag.
+             */
+            template <typename T>
+            auto get() const -> std::optional<decltype(std::declval<const snapshot::image&>().template decode<T>(0))> {
+                if (this->tag() != type_tag_of<T>::value || !this->has_value()) return std::nullopt;
+                return this->__image->template decode<T>(this->__record.value);
+            }
+
+
+            /**
+             * @brief Gets a copy of the value of the slot.
+             * @return The value, no value if none is set.
+             */
+            treecode::value value() const;
+
+
+            /**
+             * @brief Gets the number of choices of the item.
+             * @return The number of choices, 0 for slots without choices.
+             */
+            std::size_t choice_count() const { return this->__record.flags & snapshot::ITEM_CHOICES ? this->__record.choice_count : 0U; }
+
+
+            /**
+             * @brief Gets a choice of the item if the item has the given type.
+             * @param pos The position of the choice, below choice_count().
+             * @return The choice, strings as views into the mapping, no value if T does not match the tag.
+             * @throws std::out_of_range if the position is out of range.
+             */
+            template <typename T>
+            auto choice(
+                std::size_t pos
+            ) const -> std::optional<decltype(std::declval<const snapshot::image&>().template decode<T>(0))> {
+                if (pos >= this->choice_count()) Exception::Throw::Range(std::string(this->id()), Exception::SNAPSHOT_OUT_OF_RANGE);
+                if (this->tag() != type_tag_of<T>::value) return std::nullopt;
+                return this->__image->template decode<T>(this->__image->choice(this->__record, static_cast<std::uint32_t>(pos)));
+            }
+
+        private:
+            friend class mapped_tree;
+
+            item_view(
+                const snapshot::image* image,
+                const snapshot::item_record& record
+            ) : __image(image), __record(record) {}
+
+            const snapshot::image* __image;
+            snapshot::item_record __record;
+        };
+
+
+        /**
+         * @class group_view
+         * @brief Read-only view on a mapped group.
+         */
+        class group_view {
+        public:
+            /**
+             * @brief Gets the name of the group.
+             * @return A view into the mapping.
+             */
+            std::string_view name() const { return this->__image->string(this->__record.name); }
+
+
+            /**
+             * @brief Gets the number of items and of children of the group.
+             */
+            std::size_t item_count() const { return this->__record.item_count; }
+            std::size_t child_count() const { return this->__record.child_count; }
+
+
+            /**
+             * @brief Gets the number of groups in the subtree of the group.
+             * @return The number of groups, the group included.
+             */
+            std::uint64_t subtree_size() const { return this->__record.subtree_nodes; }
+
+
+            /**
+             * @brief Gets an item by position.
+             * @param pos The position of the item, in insertion order.
+             * @return The item.
+             * @throws std::out_of_range if the position is out of range.
+             */
+            item_view item(
+                std::size_t pos
+            ) const;
+
+
+            /**
+             * @brief Finds an item by key.
+             * @param key The key of the item.
+             * @return The item, no value if the group has no such item.
+             */
+            std::optional<item_view> find(
+                std::string_view key
+            ) const;
+
+
+            /**
+             * @brief Gets a child by position.
+             * @param pos The position of the child.
+             * @return The child.
+             * @throws std::out_of_range if the position is out of range.
+             */
+            group_view child(
+                std::size_t pos
+            ) const;
+
+
+            /**
+             * @brief Finds the first child with a given name.
+             * @param name The name of the child.
+             * @return The child, no value if the group has no such child.
+             */
+            std::optional<group_view> child(
+                std::string_view name
+            ) const;
+
+
+            /**
+             * @brief Calls a function for every item, then for every child.
+             * @param fn Callable invoked as fn(const item_view&) or fn(const group_view&).
+             */
+            template <typename F>
+            void for_each_item(F&& fn) const { for (std::size_t i = 0; i < this->item_count(); ++i) fn(this->item(i)); }
+
+            template <typename F>
+            void for_each_child(F&& fn) const { for (std::size_t i = 0; i < this->child_count(); ++i) fn(this->child(i)); }
+
+
+            /**
+             * @brief Builds the subtree of the group.
+             * @param resource The memory resource of the subtree, null for the default resource.
+             * @return The group and its subtree.
+             */
+            group materialise(
+                std::pmr::memory_resource* resource = nullptr
+            ) const { return snapshot::read(*this->__image, this->__offset, resource); }
+
+        private:
+            friend class mapped_tree;
+
+            group_view(
+                const snapshot::image* image,
+                std::uint64_t offset
+            ) : __image(image), __offset(offset), __record(image->node(offset)) {}
+
+            const snapshot::image* __image;
+            std::uint64_t __offset;
+            snapshot::node_record __record;
+        };
+
+
+        /**
+         * @brief Maps a snapshot file.
+         * @param path The path of the file.
+         * @throws std::runtime_error if the file cannot be mapped or is not a valid snapshot.
+         */
+        explicit mapped_tree(
+            const std::string& path
+        );
+
+
+        /**
+         * @brief Mappings can be moved, views stay valid, but not copied.
+         */
+        mapped_tree(mapped_tree&&) noexcept = default;
+        mapped_tree& operator=(mapped_tree&&) noexcept = default;
+        mapped_tree(const mapped_tree&) = delete;
+        mapped_tree& operator=(const mapped_tree&) = delete;
+
+
+        /**
+         * @brief Gets the root group.
+         * @return The view on the root group.
+         */
+        group_view root() const { return group_view(this->__image.get(), this->__image->info().root); }
+
+
+        /**
+         * @brief Gets the number of groups in the tree.
+         * @return The number of groups.
+         */
+        std::uint64_t size() const { return this->__image->info().node_count; }
+
+
+        /**
+         * @brief Gets the image over the mapping.
+         * @return The image.
+         */
+        const snapshot::image& image() const { return *this->__image; }
+
+
+        /**
+         * @brief Builds the whole tree.
+         * @param resource The memory resource of the tree, null for the default resource.
+         * @return The root group.
+         */
+        group materialise(
+            std::pmr::memory_resource* resource = nullptr
+        ) const { return this->root().materialise(resource); }
+
+    private:
+        /**
+         * @struct region
+         * @brief A read-only file mapping, unmapped on destruction.
+         */
+        struct region {
+            const char* data = nullptr;
+            std::size_t size = 0;
+            void* handle = nullptr;     /* the file mapping object on Windows */
+
+            explicit region(const std::string& path);
+            region(region&& other) noexcept;
+            region& operator=(region&& other) noexcept;
+            ~region();
+        };
+
+        /**
+         * @var region mapped_tree::__region
+         * The mapping of the file.
+         */
+        region __region;
+
+        /**
+         * @var std::unique_ptr<snapshot::image> mapped_tree::__image
+         * The image over the mapping, held by pointer so views survive moves of the tree.
+         */
+        std::unique_ptr<snapshot::image> __image;
+    };
+} // namespace treecode
+
+#endif // MAPPED_TREE_H
@@ -0,0 +1,253 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file parallel.hpp
+ * @brief Header file for the parallel tree visitors.
+ * @ingroup Core
+ *
+ * This file contains parallel_for_each and parallel_reduce, which visit the
+ * groups of a tree concurrently on a pool, splitting the tree at the children
+ * of its groups according to the size of their subtrees.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the parallel tree visitors
+ */
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "traversal.hpp"
+#include "pool.hpp"
+
+namespace treecode {
+    /**
+     * @class parallel_walker
+     * @brief Walks a tree on a task group, the engine of parallel_for_each and parallel_reduce.
+     *
+     * Each task visits its groups into an accumulator created by make() and hands it
+     * to flush() when done. At every group the subtree of each child is sized, counting
+     * at most grain groups; children are forked in chunks of at least grain groups, small
+     * subtrees are walked iteratively and large ones are split again. Below
+     * MAX_SPLIT_DEPTH subtrees are no longer split, which bounds the recursion.
+     */
+    template <typename Make, typename Visit, typename Flush>
+    class parallel_walker {
+    public:
+        using node_type = tree_node<const group>;
+
+        /**
+         * @var parallel_walker::MAX_SPLIT_DEPTH
+         * Groups deeper than this are walked serially with their subtree.
+         */
+        static constexpr std::size_t MAX_SPLIT_DEPTH = 64U;
+
+        /**
+         * @brief Constructs a walker.
+         * @param tasks The task group the subtrees are forked on.
+         * @param grain The minimum number of groups visited by a task.
+         * @param make Callable creating an accumulator, as make().
+         * @param visit Callable visiting a group into an accumulator, as visit(acc, node).
+         * @param flush Callable receiving the accumulator of a finished task, as flush(acc).
+         */
+        parallel_walker(
+            task_group& tasks,
+            std::size_t grain,
+            Make& make,
+            Visit& visit,
+            Flush& flush
+        ) : __tasks(tasks), __grain(std::max<std::size_t>(grain, 1U)), __make(make), __visit(visit), __flush(flush) {}
+
+
+        /**
+         * @brief Visits a tree, the forked tasks must be waited for on the task group.
+         * @param root The root group.
+         */
+        void run(
+            const group& root
+        ) {
+            auto acc = this->__make();
+            this->__subtree({&root, nullptr, 0, 0}, acc);
+            this->__flush(acc);
+        }
+
+    private:
+        task_group& __tasks;
+        std::size_t __grain;
+        Make& __make;
+        Visit& __visit;
+        Flush& __flush;
+
+        /* visits a group, then splits its children */
+        template <typename A>
+        void __subtree(
+            const node_type& at,
+            A& acc
+        ) {
+            this->__visit(acc, at);
+            const auto& children = at.node->children();
+            if (children.empty()) return;
+            if (at.depth >= MAX_SPLIT_DEPTH) {
+                for (std::size_t i = 0; i < children.size(); ++i)
+                    if (children[i]) this->__serial({children[i].get(), at.node, at.depth + 1, i}, acc);
+                return;
+            }
+
+            /* the subtree sizes are capped at grain, a capped child is large and split again */
+            auto sizes = std::make_shared<std::vector<std::size_t>>(children.size(), 0U);
+            for (std::size_t i = 0; i < children.size(); ++i) (*sizes)[i] = children[i] ? this->__count(*children[i]) : 0U;
+
+            auto body = [this, sizes, at](std::size_t begin, std::size_t end) {
+                const auto& kids = at.node->children();
+                auto chunk = this->__make();
+                for (std::size_t i = begin; i < end; ++i) {
+                    if (!kids[i]) continue;
+                    const node_type child{kids[i].get(), at.node, at.depth + 1, i};
+                    if ((*sizes)[i] < this->__grain) this->__serial(child, chunk);
+                    else this->__subtree(child, chunk);
+                }
+                this->__flush(chunk);
+            };
+            fork_chunks(this->__tasks, children.size(), this->__grain, [&sizes](std::size_t i) { return (*sizes)[i]; }, body);
+        }
+
+        /* visits a subtree iteratively on the calling thread */
+        template <typename A>
+        void __serial(
+            const node_type& at,
+            A& acc
+        ) {
+            for (auto n : walk(*at.node)) {
+                if (!n.parent) {
+                    n.parent = at.parent;
+                    n.index = at.index;
+                }
+                n.depth += at.depth;
+                this->__visit(acc, n);
+            }
+        }
+
+        /* counts the groups of a subtree, stopping at grain */
+        std::size_t __count(
+            const group& root
+        ) const {
+            std::size_t count = 0;
+            for (const auto& n : walk(root)) {
+                (void)n;
+                if (++count == this->__grain) break;
+            }
+            return count;
+        }
+    };
+
+
+    /**
+     * @brief Visits every group of a tree concurrently.
+     *        The visitor is called once per group, from several threads at once, and
+     *        gets the group as const. Constant methods never write to the tree, except
+     *        the constant get/get<T>, which materialise and copy slots: visitors read the
+     *        items through find, value<T> and item_view::get_if, which do not race.
+     *        Children reached from a node must be held as constant groups as well, and
+     *        the tree must not be modified during the walk.
+     * @param root The root group.
+     * @param visitor Callable invoked as visitor(const tree_node<const group>&).
+     * @param options The pool and grain size of the walk.
+     * @throws The first exception thrown by the visitor.
+     */
+    template <typename V>
+    void parallel_for_each(
+        const group& root,
+        V&& visitor,
+        const parallel& options = parallel()
+    ) {
+        struct none {};
+        auto make = [] { return none(); };
+        auto visit = [&visitor](none&, const tree_node<const group>& n) { visitor(n); };
+        auto flush = [](none&) {};
+
+        task_group tasks(options.workers ? *options.workers : pool::shared());
+        parallel_walker<decltype(make), decltype(visit), decltype(flush)> walker(tasks, options.grain, make, visit, flush);
+        try {
+            walker.run(root);
+        } catch (...) {
+            /* the forked tasks still use the walker */
+            try { tasks.wait(); } catch (...) {}
+            throw;
+        }
+        tasks.wait();
+    }
+
+
+    /**
+     * @brief Reduces the groups of a tree concurrently.
+     *        Every task folds its groups into a copy of identity with combine(acc, map(node)),
+     *        then the partial results are combined in an unspecified order, so combine must be
+     *        associative and commutative. map follows the rules of the parallel_for_each visitor.
+     * @param root The root group.
+     * @param identity The neutral element of combine.
+     * @param map Callable invoked as map(const tree_node<const group>&), returning a T.
+     * @param combine Callable invoked as combine(T, T), returning a T.
+     * @param options The pool and grain size of the walk.
+     * @return The combination of the mapped groups.
+     * @throws The first exception thrown by map or combine.
+     */
+    template <typename T, typename M, typename C>
+    T parallel_reduce(
+        const group& root,
+        T identity,
+        M&& map,
+        C&& combine,
+        const parallel& options = parallel()
+    ) {
+        std::mutex mutex;
+        std::vector<T> partials;
+        auto make = [&identity] { return identity; };
+        auto visit = [&map, &combine](T& acc, const tree_node<const group>& n) { acc = combine(std::move(acc), map(n)); };
+        auto flush = [&mutex, &partials](T& acc) {
+            std::lock_guard<std::mutex> lock(mutex);
+            partials.push_back(std::move(acc));
+        };
+
+        task_group tasks(options.workers ? *options.workers : pool::shared());
+        parallel_walker<decltype(make), decltype(visit), decltype(flush)> walker(tasks, options.grain, make, visit, flush);
+        try {
+            walker.run(root);
+        } catch (...) {
+            /* the forked tasks still use the walker */
+            try { tasks.wait(); } catch (...) {}
+            throw;
+        }
+        tasks.wait();
+
+        T result = std::move(identity);
+        for (auto& partial : partials) result = combine(std::move(result), std::move(partial));
+        return result;
+    }
+} // namespace treecode
+
+#endif // PARALLEL_H
@@ -0,0 +1,437 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file persistent_group.hpp
+ * @class persistent_group
+ * @brief Header file for the persistent_group class.
+ * @ingroup Core
+ *
+ * This file contains the definition of the persistent_group class, an
+ * immutable group whose modifications return new versions sharing every
+ * untouched subtree and item with the previous one.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the persistent_group class
+ */
+#ifndef PERSISTENT_GROUP_H
+#define PERSISTENT_GROUP_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "group.hpp"
+
+namespace treecode {
+    /**
+     * @class persistent_group
+     * @brief An immutable group with structural sharing between versions.
+     *
+     * A persistent_group is a handle on an immutable node: copying it is a pointer copy,
+     * so keeping a version costs nothing. Every modification returns a new version that
+     * copies the modified node and the path from the root to it, the child pointers and
+     * item slots of the copied nodes are shared with the previous version, so a change
+     * deep in a large tree costs the depth times the fan out, not the tree size.
+     *
+     * Items hold values of the inline types, with their required flag and choices, and
+     * modifications check the type and the choices like the items of a group do. Nodes
+     * are never modified once built, versions can be handed to any number of threads.
+     *
+     * Usage:
+     *      auto v1 = treecode::persistent_group::freeze(config);
+     *      auto v2 = v1.update({0, 3}, [](const treecode::persistent_group& did) {
+     *          return did.with_value("SIZE", std::uint32_t(8));
+     *      });
+     *      treecode::group current = v2.thaw();
+     */
+    class persistent_group {
+        struct slot;
+        struct node;
+
+    public:
+        /**
+         * @class item_view
+         * @brief Read-only view on an item of a version.
+         */
+        class item_view {
+        public:
+            /**
+             * @brief Gets the key of the item.
+             */
+            const key& id() const;
+
+
+            /**
+             * @brief Gets the type tag of the item.
+             */
+            type_tag tag() const;
+
+
+            /**
+             * @brief Checks the flags of the item, as frozen from the container.
+             */
+            bool is_inline() const;
+            bool is_required() const;
+            bool has_value() const;
+
+
+            /**
+             * @brief Gets the value of the item.
+             * @return The value, no value if none is set.
+             */
+            const treecode::value& value() const;
+
+
+            /**
+             * @brief Gets a pointer to the value if it has the given type.
+             * @return A pointer to the value, null if no value or another type is held.
+             */
+            template <typename T>
+            const T* get_if() const { return this->value().template get_if<T>(); }
+
+        private:
+            friend class persistent_group;
+
+            explicit item_view(
+                const slot* item
+            ) : __slot(item) {}
+
+            const slot* __slot;
+        };
+
+
+        /**
+         * @brief Constructs an empty group.
+         * @param name The name of the group.
+         */
+        explicit persistent_group(
+            const std::string& name
+        );
+
+
+        /**
+         * @brief Builds a version from a group and its subtree.
+         *        Choice lists shared by items of the source stay shared in the version.
+         * @param source The group.
+         * @return The version.
+         * @throws std::invalid_argument if an item has a user type.
+         */
+        static persistent_group freeze(
+            const group& source
+        );
+
+
+        /**
+         * @brief Builds a mutable group from the version.
+         * @param resource The memory resource of the group, null for the default resource.
+         * @return The group, independent of the version.
+         */
+        group thaw(
+            std::pmr::memory_resource* resource = nullptr
+        ) const;
+
+
+        /**
+         * @brief Gets the name of the group.
+         */
+        const std::string& name() const;
+
+
+        /**
+         * @brief Gets the number of items and of children of the group.
+         */
+        std::size_t item_count() const;
+        std::size_t child_count() const;
+
+
+        /**
+         * @brief Finds an item by key.
+         * @param key The key of the item.
+         * @return The item, no value if the group has no such item.
+         */
+        std::optional<item_view> find(const key& key) const;
+
+        std::optional<item_view> find(std::string_view key) const { return this->find(treecode::key(key)); }
+
+
+        /**
+         * @brief Calls a function for every item, in insertion order.
+         * @param fn Callable invoked as fn(const item_view&).
+         */
+        template <typename F>
+        void for_each_item(F&& fn) const;
+
+
+        /**
+         * @brief Gets a child by position.
+         * @param pos The position of the child.
+         * @return The child.
+         * @throws std::out_of_range if the position is out of range.
+         */
+        persistent_group child(
+            std::size_t pos
+        ) const;
+
+
+        /**
+         * @brief Gets the first child with a name.
+         * @param name The name of the child.
+         * @return The child, no value if the group has no such child.
+         */
+        std::optional<persistent_group> child(
+            std::string_view name
+        ) const;
+
+
+        /**
+         * @brief Calls a function for every child, in order.
+         * @param fn Callable invoked as fn(const persistent_group&).
+         */
+        template <typename F>
+        void for_each_child(F&& fn) const;
+
+
+        /**
+         * @brief Checks if two versions share the same node.
+         *        Shared nodes are equal, equal nodes built separately are not shared.
+         */
+        bool identical(const persistent_group& other) const { return this->__node == other.__node; }
+
+
+        /**
+         * @brief Returns a version with the value of an item replaced.
+         * @param key The key of the item.
+         * @param v The value, of the type of the item, no value to clear it.
+         * @return The new version, this one if the value is unchanged.
+         * @throws std::out_of_range if the key does not exist.
+         * @throws std::invalid_argument if the type does not match or the value is not an allowed choice.
+         */
+        persistent_group with_value(
+            const key& key,
+            const treecode::value& v
+        ) const;
+
+        persistent_group with_value(
+            std::string_view key,
+            const treecode::value& v
+        ) const { return this->with_value(treecode::key(key), v); }
+
+
+        /**
+         * @brief Returns a version with an inline item added.
+         * @param key The key of the item.
+         * @param v The value, its type is the type of the item.
+         * @param required True if the item is required.
+         * @return The new version.
+         * @throws std::invalid_argument if the key already exists or the value is empty.
+         */
+        persistent_group with_item(
+            const key& key,
+            const treecode::value& v,
+            bool required = false
+        ) const;
+
+        persistent_group with_item(
+            std::string_view key,
+            const treecode::value& v,
+            bool required = false
+        ) const { return this->with_item(treecode::key(key), v, required); }
+
+
+        /**
+         * @brief Returns a version with the required flag of an item set or cleared.
+         * @param key The key of the item.
+         * @param required The flag.
+         * @return The new version, this one if the flag is unchanged.
+         * @throws std::out_of_range if the key does not exist.
+         */
+        persistent_group with_required(
+            const key& key,
+            bool required = true
+        ) const;
+
+        persistent_group with_required(
+            std::string_view key,
+            bool required = true
+        ) const { return this->with_required(treecode::key(key), required); }
+
+
+        /**
+         * @brief Returns a version without an item.
+         * @param key The key of the item.
+         * @return The new version, this one if the key does not exist.
+         */
+        persistent_group without_item(
+            const key& key
+        ) const;
+
+        persistent_group without_item(
+            std::string_view key
+        ) const { return this->without_item(treecode::key(key)); }
+
+
+        /**
+         * @brief Returns a version with a child replaced.
+         * @param pos The position of the child.
+         * @param child The new child.
+         * @return The new version, this one if the child is unchanged.
+         * @throws std::out_of_range if the position is out of range.
+         */
+        persistent_group with_child(
+            std::size_t pos,
+            const persistent_group& child
+        ) const;
+
+
+        /**
+         * @brief Returns a version with a child appended.
+         * @param child The child.
+         * @return The new version.
+         */
+        persistent_group with_added_child(
+            const persistent_group& child
+        ) const;
+
+
+        /**
+         * @brief Returns a version without a child.
+         * @param pos The position of the child.
+         * @return The new version.
+         * @throws std::out_of_range if the position is out of range.
+         */
+        persistent_group without_child(
+            std::size_t pos
+        ) const;
+
+
+        /**
+         * @brief Returns a version with a descendant replaced, copying only the path to it.
+         * @param path The child positions from this group down to the descendant, empty for this group.
+         * @param fn Callable invoked as fn(const persistent_group&) on the descendant, returning its replacement.
+         * @return The new version.
+         * @throws std::out_of_range if a position is out of range.
+         */
+        template <typename F>
+        persistent_group update(
+            const std::vector<std::size_t>& path,
+            F&& fn
+        ) const;
+
+    private:
+        /**
+         * @struct slot
+         * @brief An immutable item, shared between the versions that did not modify it.
+         */
+        struct slot {
+            key id;
+            treecode::value value;
+            type_tag tag;
+            bool required;
+            bool is_inline;
+            /* a std::vector of the item type, null for items without choices */
+            std::shared_ptr<const void> choices;
+        };
+
+        /**
+         * @struct node
+         * @brief An immutable group, shared between the versions that did not modify it.
+         */
+        struct node {
+            std::string name;
+            std::vector<std::shared_ptr<const slot>> items;
+            std::vector<std::shared_ptr<const node>> children;
+        };
+
+        /**
+         * @var std::shared_ptr<const node> persistent_group::__node
+         * The node of the version.
+         */
+        std::shared_ptr<const node> __node;
+
+        explicit persistent_group(
+            std::shared_ptr<const node> n
+        ) : __node(std::move(n)) {}
+
+        /**
+         * @brief Finds the position of an item, the number of items if the key does not exist.
+         */
+        std::size_t __find(
+            const key& key
+        ) const;
+
+        /**
+         * @brief Gets the nodes from this group down to the end of a path.
+         */
+        std::vector<std::shared_ptr<const node>> __path(
+            const std::vector<std::size_t>& path
+        ) const;
+    };
+
+
+    /**
+     * @brief Calls a function for every item, in insertion order.
+     * @param fn Callable invoked as fn(const item_view&).
+     */
+    template <typename F>
+    void persistent_group::for_each_item(
+        F&& fn
+    ) const {
+        for (const auto& item : this->__node->items) fn(item_view(item.get()));
+    }
+
+
+    /**
+     * @brief Calls a function for every child, in order.
+     * @param fn Callable invoked as fn(const persistent_group&).
+     */
+    template <typename F>
+    void persistent_group::for_each_child(
+        F&& fn
+    ) const {
+        for (const auto& child : this->__node->children) fn(persistent_group(child));
+    }
+
+
+    /**
+     * @brief Returns a version with a descendant replaced, copying only the path to it.
+     * @param path The child positions from this group down to the descendant.
+     * @param fn Callable invoked on the descendant, returning its replacement.
+     * @return The new version.
+     */
+    template <typename F>
+    persistent_group persistent_group::update(
+        const std::vector<std::size_t>& path,
+        F&& fn
+    ) const {
+        const auto nodes = this->__path(path);
+        persistent_group result = fn(persistent_group(nodes.back()));
+        /* rebuild the ancestors bottom up, each one pointing to its new child */
+        for (std::size_t i = path.size(); i-- > 0;) result = persistent_group(nodes[i]).with_child(path[i], result);
+        return result;
+    }
+} // namespace treecode
+
+#endif // PERSISTENT_GROUP_H
@@ -0,0 +1,320 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file pool.hpp
+ * @class pool
+ * @brief Header file for the pool and task_group classes.
+ * @ingroup Core
+ *
+ * This file contains the definition of the pool class, a work-stealing thread
+ * pool, of the task_group class used to fork and join tasks on it, and of the
+ * parallel options taken by the parallel tree operations.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the pool and task_group classes
+ */
+#ifndef POOL_H
+#define POOL_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "common.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace treecode {
+    class task_group;
+
+
+    /**
+     * @class pool
+     * @brief Work-stealing thread pool.
+     *
+     * Every worker owns a task queue: it runs its own tasks last in first out and
+     * steals the oldest tasks of the other queues when its queue is empty. Tasks
+     * forked by a thread that is not a worker go to a shared queue. Threads waiting
+     * on a task_group run pending tasks instead of blocking, so nested forks never
+     * deadlock and a pool without workers runs everything on the waiting thread.
+     */
+    class pool {
+    public:
+        /**
+         * @brief Constructs a pool.
+         * @param threads The number of worker threads.
+         */
+        explicit pool(
+            std::size_t threads
+        );
+
+
+        /**
+         * @brief Stops and joins the workers, pending tasks must have been waited for.
+         */
+        ~pool();
+
+
+        /**
+         * @brief Pools own their threads and can be neither copied nor moved.
+         */
+        pool(const pool&) = delete;
+        pool& operator=(const pool&) = delete;
+
+
+        /**
+         * @brief Gets the process wide pool, created on first use with one worker
+         *        less than the hardware threads since the waiting thread also runs tasks.
+         * @return The shared pool.
+         */
+        static pool& shared();
+
+
+        /**
+         * @brief Gets the number of worker threads.
+         * @return The number of workers.
+         */
+        std::size_t size() const;
+
+    private:
+        friend class task_group;
+
+        /**
+         * @struct queue
+         * @brief A task queue, the owner works at the back, thieves at the front.
+         */
+        struct queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        /**
+         * @var std::vector<std::unique_ptr<queue>> pool::__queues
+         * One queue per worker, followed by the shared queue of the other threads.
+         */
+        std::vector<std::unique_ptr<queue>> __queues;
+
+        /**
+         * @var std::vector<std::thread> pool::__workers
+         * The worker threads.
+         */
+        std::vector<std::thread> __workers;
+
+        /**
+         * @var std::atomic<std::size_t> pool::__queued
+         * The number of tasks waiting in the queues.
+         */
+        std::atomic<std::size_t> __queued{0};
+
+        /**
+         * @var bool pool::__stop
+         * Set when the pool is destroyed, guarded by __sleep_mutex.
+         */
+        bool __stop = false;
+
+        /**
+         * @var std::mutex pool::__sleep_mutex
+         * @var std::condition_variable pool::__wake
+         * Idle workers sleep until a task is pushed.
+         */
+        std::mutex __sleep_mutex;
+        std::condition_variable __wake;
+
+        /**
+         * @brief Pushes a task to the queue of the calling thread.
+         * @param task The task.
+         */
+        void __push(
+            std::function<void()> task
+        );
+
+        /**
+         * @brief Runs one pending task, from the queue of the calling thread first.
+         * @return True if a task was run, false if all queues were empty.
+         */
+        bool __run_one();
+
+        /**
+         * @brief Gets the queue of the calling thread.
+         * @return The position of the worker queue, or of the shared queue.
+         */
+        std::size_t __home() const;
+
+        /**
+         * @brief The loop of a worker thread.
+         * @param index The position of the worker.
+         */
+        void __work(
+            std::size_t index
+        );
+    };
+
+
+    /**
+     * @class task_group
+     * @brief Forks tasks on a pool and joins them.
+     *
+     * Tasks may fork further tasks on the same group. wait() runs pending tasks
+     * until every task of the group finished, then rethrows the first exception
+     * thrown by a task. The destructor waits as well.
+     */
+    class task_group {
+    public:
+        /**
+         * @brief Constructs a task group on a pool.
+         * @param workers The pool running the tasks.
+         */
+        explicit task_group(
+            pool& workers
+        ) : __pool(workers) {}
+
+
+        /**
+         * @brief Waits for the pending tasks.
+         */
+        ~task_group();
+
+
+        task_group(const task_group&) = delete;
+        task_group& operator=(const task_group&) = delete;
+
+
+        /**
+         * @brief Forks a task.
+         * @param fn The task, a callable taking no argument.
+         */
+        template <typename F>
+        void run(
+            F&& fn
+        );
+
+
+        /**
+         * @brief Runs pending tasks until every task of the group finished.
+         * @throws The first exception thrown by a task of the group.
+         */
+        void wait();
+
+    private:
+        /**
+         * @var pool& task_group::__pool
+         * The pool running the tasks.
+         */
+        pool& __pool;
+
+        /**
+         * @var std::atomic<std::size_t> task_group::__pending
+         * The number of forked tasks that did not finish yet.
+         */
+        std::atomic<std::size_t> __pending{0};
+
+        /**
+         * @var std::exception_ptr task_group::__error
+         * The first exception thrown by a task, guarded by __error_mutex.
+         */
+        std::exception_ptr __error;
+        std::mutex __error_mutex;
+    };
+
+
+    /**
+     * @struct parallel
+     * @brief Options of the parallel tree operations.
+     */
+    struct parallel {
+        /**
+         * @var std::size_t parallel::grain
+         * The minimum number of nodes handed to one task, smaller subtrees stay serial.
+         */
+        std::size_t grain = 1024;
+
+        /**
+         * @var pool* parallel::workers
+         * The pool running the tasks, null for pool::shared().
+         */
+        pool* workers = nullptr;
+    };
+
+
+    /**
+     * @brief Forks a sequence of subtrees in chunks of at least grain nodes.
+     *        The last chunk, lighter than grain, runs on the calling thread.
+     * @param tasks The task group the chunks are forked on.
+     * @param count The number of subtrees.
+     * @param grain The minimum weight of a forked chunk.
+     * @param weight Callable returning the weight of subtree i, as weight(i).
+     * @param body Callable processing subtrees [begin, end), as body(begin, end). It is
+     *        copied into the forked tasks, which may outlive the caller, so it must
+     *        only capture data that lives until the task group is waited for.
+     */
+    template <typename W, typename B>
+    void fork_chunks(
+        task_group& tasks,
+        std::size_t count,
+        std::size_t grain,
+        W&& weight,
+        B&& body
+    ) {
+        std::size_t begin = 0;
+        std::size_t load = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            load += weight(i);
+            if (load < grain) continue;
+            /* the chunk is heavy enough to pay for a task */
+            tasks.run([body, begin, end = i + 1]() mutable { body(begin, end); });
+            begin = i + 1;
+            load = 0;
+        }
+        if (begin < count) body(begin, count);
+    }
+
+
+    /**
+     * @brief Forks a task.
+     * @param fn The task.
+     */
+    template <typename F>
+    void task_group::run(
+        F&& fn
+    ) {
+        this->__pending.fetch_add(1, std::memory_order_relaxed);
+        this->__pool.__push([this, fn = std::forward<F>(fn)]() mutable {
+            try {
+                fn();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(this->__error_mutex);
+                if (!this->__error) this->__error = std::current_exception();
+            }
+            this->__pending.fetch_sub(1, std::memory_order_release);
+        });
+    }
+} // namespace treecode
+
+#endif // POOL_H
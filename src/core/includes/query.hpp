@@ -0,0 +1,337 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file query.hpp
+ * @class query
+ * @brief Header file for the query class.
+ * @ingroup Core
+ *
+ * This file contains the definition of the query class, a path expression
+ * selecting groups and items of a tree that is parsed once and can then be
+ * run against any number of groups.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the query class
+ */
+#ifndef QUERY_H
+#define QUERY_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "traversal.hpp"
+#include "pool.hpp"
+
+namespace treecode {
+    /**
+     * @class query
+     * @brief A compiled path expression over groups and items.
+     *
+     * A query is a list of steps separated by '/', run relative to a group:
+     *      NAME        the child groups named NAME; as the last step, also the item NAME
+     *      *           every child group
+     *      **          the group itself and all of its descendants, cannot be the last step
+     *      @NAME       the item NAME, only as the last step
+     *
+     * Group steps (NAME and *) may be followed by predicates, applied in order:
+     *      [KEY]           the group holds a value under KEY
+     *      [KEY=VALUE]     the value under KEY equals VALUE
+     *      [KEY!=VALUE]    the group holds a value under KEY that differs from VALUE
+     *      [N]             the N-th group, from 0, of those that passed the previous predicates
+     *
+     * VALUE may be quoted with '"' or '\''. It is compared to the value as its type:
+     * strings as text, integers as decimal or 0x prefixed hexadecimal numbers, floating
+     * point values as numbers and booleans as true, false, 1 or 0.
+     *
+     * Matches are produced in pre-order, child groups before the items of their parent.
+     * Running a query only reads the tree, keys and literals are resolved at compilation.
+     *
+     * Usage:
+     *      treecode::query q("DID[ID=FD10]/ELEMENT[TYPE=uint16]/VALUE");
+     *      for (const auto& m : q.select(did_tree)) std::cout << *m.item->get_if<int>();
+     */
+    class query {
+    public:
+        /**
+         * @struct basic_match
+         * @brief A selected group, or a selected item with the group holding it.
+         */
+        template <typename G>
+        struct basic_match {
+            G* node = nullptr;                              /* the selected group, or the owner of the selected item */
+            std::optional<container::item_view> item;       /* the selected item, empty for groups */
+        };
+
+        using match = basic_match<group>;
+        using const_match = basic_match<const group>;
+
+
+        /**
+         * @brief Compiles a query.
+         * @param text The query text.
+         * @throws std::invalid_argument if the query is malformed.
+         */
+        explicit query(
+            std::string_view text
+        );
+
+
+        /**
+         * @brief Gets the text the query was compiled from.
+         * @return The query text.
+         */
+        const std::string& text() const;
+
+
+        /**
+         * @brief Selects every match below a group.
+         * @param root The group the query is run from.
+         * @return The matches in pre-order.
+         */
+        std::vector<match> select(
+            group& root
+        ) const;
+
+        /* constant version of the method */
+        std::vector<const_match> select(
+            const group& root
+        ) const;
+
+
+        /**
+         * @brief Selects every match below a group on a thread pool.
+         *        The groups matched by the first step are split in tasks of at least
+         *        options.grain groups, the matches keep the order of the serial select.
+         *        The tree must not be modified during the query.
+         * @param root The group the query is run from.
+         * @param options The pool and grain size of the query.
+         * @return The matches in pre-order.
+         */
+        std::vector<const_match> select(
+            const group& root,
+            const parallel& options
+        ) const;
+
+
+        /**
+         * @brief Selects the first match below a group, the search stops there.
+         * @param root The group the query is run from.
+         * @return The first match in pre-order, empty if nothing matches.
+         */
+        std::optional<match> first(
+            group& root
+        ) const;
+
+        /* constant version of the method */
+        std::optional<const_match> first(
+            const group& root
+        ) const;
+
+
+        /**
+         * @brief Calls a function with the matches below a group until it returns false.
+         * @param root The group the query is run from.
+         * @param fn Callable invoked as fn(const const_match&), returning false to stop.
+         * @return False if the function stopped the search, true otherwise.
+         */
+        template <typename F>
+        bool for_each(
+            const group& root,
+            F&& fn
+        ) const {
+            return this->__run(root, 0, fn);
+        }
+
+    private:
+        /**
+         * @struct literal
+         * @brief A predicate value, parsed once for every type it can be compared to.
+         */
+        struct literal {
+            std::string text;
+            std::optional<std::int64_t> signed_value;
+            std::optional<std::uint64_t> unsigned_value;
+            std::optional<double> real_value;
+            std::optional<bool> bool_value;
+        };
+
+        /**
+         * @struct predicate
+         * @brief A compiled predicate of a group step.
+         */
+        struct predicate {
+            enum class kind : std::uint8_t { exists, equal, not_equal, index } op;
+            key id;
+            std::size_t index = 0;
+            literal value;
+        };
+
+        /**
+         * @struct step
+         * @brief A compiled step of the query.
+         */
+        struct step {
+            enum class kind : std::uint8_t { child, any, descendants, item } op;
+            std::string name;
+            key id;
+            std::vector<predicate> predicates;
+            bool indexed = false;       /* has index predicates, which need counters */
+        };
+
+        /**
+         * @var std::string query::__text
+         * The query text.
+         */
+        std::string __text;
+
+        /**
+         * @var std::vector<step> query::__steps
+         * The compiled steps.
+         */
+        std::vector<step> __steps;
+
+        /**
+         * @brief Compiles a step.
+         * @param text The text of the step.
+         * @return The compiled step.
+         * @throws std::invalid_argument if the step is malformed.
+         */
+        step __compile_step(
+            std::string_view text
+        ) const;
+
+        /**
+         * @brief Compiles a predicate.
+         * @param text The text between the brackets.
+         * @return The compiled predicate.
+         * @throws std::invalid_argument if the predicate is malformed.
+         */
+        predicate __compile_predicate(
+            std::string_view text
+        ) const;
+
+        /**
+         * @brief Checks if a value equals a literal.
+         * @param view The slot holding the value.
+         * @param value The literal.
+         * @return True if the slot holds a value equal to the literal.
+         */
+        static bool __equals(
+            const container::item_view& view,
+            const literal& value
+        );
+
+        /**
+         * @brief Checks if a group passes the value predicates of a step.
+         *        Index predicates are counted by the caller, counters holds one counter per predicate.
+         * @param node The candidate group.
+         * @param s The step.
+         * @param counters The counters of the index predicates.
+         * @return True if the group passes every predicate.
+         */
+        static bool __accept(
+            const group& node,
+            const step& s,
+            std::vector<std::size_t>& counters
+        );
+
+        /**
+         * @brief Calls a function with the child groups matched by a group step.
+         * @param root The parent group.
+         * @param s The step.
+         * @param fn Callable invoked as fn(const group&), returning false to stop.
+         * @return False if the function stopped the enumeration, true otherwise.
+         */
+        template <typename F>
+        static bool __children(
+            const group& root,
+            const step& s,
+            F&& fn
+        ) {
+            std::vector<std::size_t> counters(s.indexed ? s.predicates.size() : 0U, 0U);
+            /* large groups hand out their children of a name directly */
+            if (s.op == step::kind::child) {
+                if (const group::name_index* names = root.__name_index()) {
+                    auto it = names->named.find(s.name);
+                    if (it == names->named.end()) return true;
+                    for (const auto& child : it->second->groups) {
+                        if (!__accept(*child, s, counters)) continue;
+                        if (!fn(static_cast<const group&>(*child))) return false;
+                    }
+                    return true;
+                }
+            }
+            for (const auto& child : root.children()) {
+                if (!child) continue;
+                if (s.op == step::kind::child && child->__name != s.name) continue;
+                if (!__accept(*child, s, counters)) continue;
+                if (!fn(static_cast<const group&>(*child))) return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Runs the steps from a position against a group.
+         * @param root The group the step is applied to.
+         * @param pos The position of the step.
+         * @param emit Callable invoked as emit(const const_match&), returning false to stop.
+         * @return False if emit stopped the search, true otherwise.
+         */
+        template <typename F>
+        bool __run(
+            const group& root,
+            std::size_t pos,
+            F& emit
+        ) const {
+            const step& s = this->__steps[pos];
+            const bool last = pos + 1 == this->__steps.size();
+
+            if (s.op == step::kind::descendants) {
+                for (const auto& n : walk(root))
+                    if (!this->__run(*n.node, pos + 1, emit)) return false;
+                return true;
+            }
+
+            if (s.op != step::kind::item) {
+                const bool more = __children(root, s, [&](const group& child) {
+                    if (last) return static_cast<bool>(emit(const_match{&child, std::nullopt}));
+                    return this->__run(child, pos + 1, emit);
+                });
+                if (!more) return false;
+            }
+
+            /* a plain last step also names an item of the group */
+            if (last && (s.op == step::kind::item || (s.op == step::kind::child && s.predicates.empty()))) {
+                auto view = root.items().find(s.id);
+                if (view) return static_cast<bool>(emit(const_match{&root, view}));
+            }
+            return true;
+        }
+    };
+} // namespace treecode
+
+#endif // QUERY_H
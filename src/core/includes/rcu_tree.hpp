@@ -0,0 +1,281 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file rcu_tree.hpp
+ * @class rcu_tree
+ * @brief Header file for the rcu_tree class.
+ * @ingroup Core
+ *
+ * This file contains the definition of the rcu_tree class, a tree published
+ * as immutable versions that readers traverse without locks while writers
+ * replace the root atomically.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the rcu_tree class
+ */
+#ifndef RCU_TREE_H
+#define RCU_TREE_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "group.hpp"
+#include <atomic>
+#include <mutex>
+
+/**
+ * @brief The number of reader counters of a tree, readers are spread over them by thread
+ */
+#define RCU_TREE_SLOTS 64U
+
+namespace treecode {
+    /**
+     * @class rcu_tree
+     * @brief A tree shared by concurrent readers and writers through versioned publication.
+     *
+     * The published root is never modified in place. Readers pin the current version
+     * with read(), which increments a counter of their thread's slot and loads the root
+     * pointer, without locks, retries or waiting on writers. Writers are serialised:
+     * they build a new root, swap it in with one atomic store, then wait for a grace
+     * period, until every reader that could still see the old version has released it,
+     * before dropping it. Counters are split by epoch parity and the epoch is flipped
+     * twice per grace period, so a steady stream of readers cannot stall a writer.
+     *
+     * Readers may keep a version beyond their read with hold(), which shares ownership
+     * of the root, the tree is then only released once the last holder drops it. The
+     * published tree must not be modified by anyone: publish a new root instead.
+     *
+     * Readers may call every constant method of the groups and containers of a version
+     * concurrently, except the constant get/get<T>, which materialise and copy slots:
+     * items are read through find, value<T> and item_view::get_if, which never write to
+     * the tree. update() copies the current version while readers use it, which is safe
+     * for the same reason. Child
+     * lookups return std::shared_ptr<group>, readers hold them as std::shared_ptr<const group>
+     * so that the non-constant accessors, which write, cannot be reached by mistake.
+     *
+     * Usage:
+     *      treecode::rcu_tree config(std::move(root));
+     *      {
+     *          auto view = config.read();
+     *          lookup(view->child("DID"));
+     *      }
+     *      config.update([](treecode::group& next) { next.items().value<int>("LIMIT", 8); });
+     */
+    class rcu_tree {
+        struct published;
+
+    public:
+        /**
+         * @class reader
+         * @brief Pins a published version for the lifetime of the reader.
+         */
+        class reader {
+        public:
+            reader(reader&& other) noexcept;
+            reader& operator=(reader&&) = delete;
+            reader(const reader&) = delete;
+            reader& operator=(const reader&) = delete;
+
+            /**
+             * @brief Releases the pinned version.
+             */
+            ~reader();
+
+
+            /**
+             * @brief Gets the root of the pinned version.
+             */
+            const group& operator*() const { return *this->__published->root; }
+            const group* operator->() const { return this->__published->root.get(); }
+
+
+            /**
+             * @brief Gets the number of the pinned version, 1 for the initial root.
+             */
+            std::uint64_t version() const { return this->__published->number; }
+
+
+            /**
+             * @brief Shares ownership of the pinned root beyond the reader.
+             * @return The root, kept alive as long as the pointer is held.
+             */
+            std::shared_ptr<const group> hold() const { return this->__published->root; }
+
+        private:
+            friend class rcu_tree;
+
+            reader(
+                std::atomic<std::uint64_t>* counter,
+                const published* version
+            ) : __counter(counter), __published(version) {}
+
+            /* the counter is released by the destructor, null once moved from */
+            std::atomic<std::uint64_t>* __counter;
+            const published* __published;
+        };
+
+
+        /**
+         * @brief Publishes an initial root.
+         * @param root The root, not modified afterwards.
+         * @throws std::invalid_argument if the root is null.
+         */
+        explicit rcu_tree(
+            std::shared_ptr<const group> root
+        );
+
+
+        /**
+         * @brief Publishes an initial root, taken over by the tree.
+         * @param root The root.
+         */
+        explicit rcu_tree(
+            group&& root
+        );
+
+
+        /**
+         * @brief Releases the current version, no reader may be left.
+         */
+        ~rcu_tree();
+
+        rcu_tree(const rcu_tree&) = delete;
+        rcu_tree& operator=(const rcu_tree&) = delete;
+
+
+        /**
+         * @brief Pins the current version, wait-free.
+         * @return The reader, releasing the version when destroyed.
+         */
+        reader read() const;
+
+
+        /**
+         * @brief Gets the current root, kept alive as long as the pointer is held.
+         * @return The root.
+         */
+        std::shared_ptr<const group> load() const { return this->read().hold(); }
+
+
+        /**
+         * @brief Gets the number of the current version, 1 for the initial root.
+         */
+        std::uint64_t version() const;
+
+
+        /**
+         * @brief Replaces the root, then waits until no reader sees the previous one.
+         * @param root The new root, not modified afterwards.
+         * @return The number of the new version.
+         * @throws std::invalid_argument if the root is null.
+         */
+        std::uint64_t publish(
+            std::shared_ptr<const group> root
+        );
+
+        std::uint64_t publish(
+            group&& root
+        );
+
+
+        /**
+         * @brief Publishes a modified copy of the current root.
+         *        The copy is deep, every group and item of the current version is cloned
+         *        before the function runs, and writers are serialised for the whole update.
+         *        Readers keep reading the current version during the copy.
+         * @param fn Callable invoked as fn(group&) on the copy.
+         * @return The number of the new version.
+         */
+        template <typename F>
+        std::uint64_t update(
+            F&& fn
+        ) {
+            std::lock_guard<std::mutex> lock(this->__writer);
+            auto next = std::make_shared<group>(this->__current.load()->root->deep_copy());
+            fn(*next);
+            return this->__publish(std::move(next));
+        }
+
+
+        /**
+         * @brief Waits until every reader pinning a version at the call has released it.
+         */
+        void synchronize();
+
+    private:
+        /**
+         * @struct published
+         * @brief A published version, the root and its number.
+         */
+        struct published {
+            std::shared_ptr<const group> root;
+            std::uint64_t number;
+        };
+
+        /**
+         * @struct slot
+         * @brief The reader counters of a group of threads, one per epoch parity, on their own cache line.
+         */
+        struct alignas(64) slot {
+            std::atomic<std::uint64_t> readers[2] = {};
+        };
+
+        /**
+         * @var std::atomic<published*> rcu_tree::__current
+         * The current version.
+         */
+        std::atomic<published*> __current;
+
+        /**
+         * @var std::atomic<std::uint64_t> rcu_tree::__epoch
+         * The grace period counter, readers register under its parity.
+         */
+        std::atomic<std::uint64_t> __epoch{0};
+
+        mutable slot __slots[RCU_TREE_SLOTS];
+
+        /**
+         * @var std::mutex rcu_tree::__writer
+         * Serialises the writers.
+         */
+        std::mutex __writer;
+
+        /**
+         * @brief Swaps in a new root and drops the old one after a grace period, the writer lock is held.
+         */
+        std::uint64_t __publish(
+            std::shared_ptr<const group> root
+        );
+
+        /**
+         * @brief Waits for a grace period, the writer lock is held.
+         */
+        void __synchronize();
+    };
+} // namespace treecode
+
+#endif // RCU_TREE_H
@@ -0,0 +1,476 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file snapshot.hpp
+ * @class snapshot
+ * @brief Header file for the snapshot class.
+ * @ingroup Core
+ *
+ * This file contains the snapshot class, which writes a group tree to a
+ * versioned binary image and reads it back, and the layout of that image.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the snapshot class
+ */
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "group.hpp"
+#include <cstring>
+#include <iosfwd>
+
+namespace treecode {
+    /**
+     * @class snapshot
+     * @brief Writes group trees to binary images and reads them back.
+     *
+     * An image is written in one sequential pass and holds, in this order:
+     *      header          magic, format version and byte order
+     *      records         for each group in post-order: the choice lists first used by its
+     *                      items, then its node_record, its item_records and its child offsets
+     *      string table    every distinct name, key and string value once
+     *      footer          offsets of the root record and of the string table
+     *
+     * Records refer to each other by byte offsets from the start of the image and to
+     * strings by their index in the string table, all fields are 8-byte aligned, so an
+     * image can be used in place (see mapped_tree). The subtree of a group occupies the
+     * contiguous range [subtree_begin, record end). Items of user types cannot be written.
+     *
+     * Usage:
+     *      treecode::snapshot::write(did_tree, "catalogue.tcs");
+     *      treecode::group did_tree = treecode::snapshot::read("catalogue.tcs");
+     */
+    class snapshot {
+    public:
+        /**
+         * @var snapshot::VERSION
+         * The format version written, images of other versions are rejected.
+         */
+        static constexpr std::uint32_t VERSION = 1U;
+
+        /**
+         * @var snapshot::ENDIAN_MARK
+         * Written as is, reads back differently on a host of the other byte order.
+         */
+        static constexpr std::uint32_t ENDIAN_MARK = 0x01020304U;
+
+        /**
+         * @brief The flags of an item_record.
+         */
+        static constexpr std::uint8_t ITEM_REQUIRED = 1U;      /* the slot is required */
+        static constexpr std::uint8_t ITEM_VALUE = 2U;         /* the slot holds a value */
+        static constexpr std::uint8_t ITEM_INLINE = 4U;        /* the slot stores its value inline */
+        static constexpr std::uint8_t ITEM_CHOICES = 8U;       /* the item has a choice list */
+
+        /**
+         * @struct header
+         * @brief The first bytes of an image.
+         */
+        struct header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byte_order;
+        };
+
+        /**
+         * @struct footer
+         * @brief The last bytes of an image.
+         */
+        struct footer {
+            std::uint64_t root;             /* offset of the root node_record */
+            std::uint64_t strings;          /* offset of the string table */
+            std::uint64_t string_count;     /* number of strings */
+            std::uint64_t node_count;       /* number of groups */
+        };
+
+        /**
+         * @struct node_record
+         * @brief A group, followed by its item_records and its child offsets.
+         */
+        struct node_record {
+            std::uint32_t name;             /* string index of the name */
+            std::uint32_t item_count;
+            std::uint32_t child_count;
+            std::uint32_t reserved;
+            std::uint64_t subtree_begin;    /* offset of the first byte of the subtree */
+            std::uint64_t subtree_nodes;    /* number of groups in the subtree, the group included */
+        };
+
+        /**
+         * @struct item_record
+         * @brief A slot of a group.
+         *        Values are stored as 64 bit payloads: integers widened, booleans as 0 or 1,
+         *        floating point values by their bits and strings by their string index.
+         */
+        struct item_record {
+            std::uint32_t key;              /* string index of the key */
+            std::uint8_t tag;               /* the type_tag of the value */
+            std::uint8_t flags;             /* ITEM_* flags */
+            std::uint16_t reserved;
+            std::uint32_t choice_count;
+            std::uint32_t reserved2;
+            std::uint64_t value;            /* the payload of the value, if ITEM_VALUE is set */
+            std::uint64_t choices;          /* offset of the payloads of the choices, if ITEM_CHOICES is set */
+        };
+
+        static_assert(sizeof(header) == 16 && sizeof(footer) == 32 && sizeof(node_record) == 32 && sizeof(item_record) == 32,
+            "snapshot records must keep their on-disk size");
+
+
+        /**
+         * @class image
+         * @brief Bounds checked, read-only access to the records of an image in memory.
+         *
+         * Every accessor checks that the record lies within the image and throws
+         * std::runtime_error otherwise, so corrupt images are rejected rather than read
+         * out of bounds. Children are always written before their parent, child offsets
+         * pointing forward are rejected as well.
+         */
+        class image {
+        public:
+            /**
+             * @brief Checks the header, footer and string table of an image.
+             * @param data The image, which must outlive this object.
+             * @param size The size of the image in bytes.
+             * @throws std::runtime_error if the data is not a valid image.
+             */
+            image(
+                const void* data,
+                std::size_t size
+            );
+
+
+            /**
+             * @brief Gets the footer of the image.
+             * @return The footer.
+             */
+            const footer& info() const { return this->__footer; }
+
+
+            /**
+             * @brief Gets the bytes of the image.
+             * @return The first byte of the image.
+             */
+            const char* data() const { return this->__data; }
+
+
+            /**
+             * @brief Gets the size of the image.
+             * @return The size in bytes.
+             */
+            std::size_t size() const { return this->__size; }
+
+
+            /**
+             * @brief Reads a node record.
+             * @param offset The offset of the record.
+             * @return The record.
+             */
+            node_record node(
+                std::uint64_t offset
+            ) const;
+
+
+            /**
+             * @brief Reads an item record of a node.
+             * @param node The offset of the node record.
+             * @param count The item count of the node.
+             * @param pos The position of the item.
+             * @return The record.
+             */
+            item_record item(
+                std::uint64_t node,
+                std::uint32_t count,
+                std::uint32_t pos
+            ) const;
+
+
+            /**
+             * @brief Reads a child offset of a node.
+             * @param node The offset of the node record.
+             * @param record The node record.
+             * @param pos The position of the child.
+             * @return The offset of the child record, before the node record.
+             */
+            std::uint64_t child(
+                std::uint64_t node,
+                const node_record& record,
+                std::uint32_t pos
+            ) const;
+
+
+            /**
+             * @brief Reads the payload of a choice.
+             * @param record The item record.
+             * @param pos The position of the choice.
+             * @return The payload.
+             */
+            std::uint64_t choice(
+                const item_record& record,
+                std::uint32_t pos
+            ) const;
+
+
+            /**
+             * @brief Gets a string of the string table.
+             * @param id The string index.
+             * @return A view into the image.
+             */
+            std::string_view string(
+                std::uint64_t id
+            ) const;
+
+
+            /**
+             * @brief Decodes a payload.
+             * @param payload The payload.
+             * @return The value, strings are returned as views into the image.
+             */
+            template <typename T>
+            auto decode(
+                std::uint64_t payload
+            ) const {
+                if constexpr (std::is_same_v<T, std::string>) return this->string(payload);
+                else if constexpr (std::is_same_v<T, bool>) return payload != 0;
+                else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) return static_cast<T>(static_cast<std::int64_t>(payload));
+                else if constexpr (std::is_integral_v<T>) return static_cast<T>(payload);
+                else {
+                    T v;
+                    std::memcpy(&v, &payload, sizeof(T));
+                    return v;
+                }
+            }
+
+        private:
+            const char* __data;
+            std::size_t __size;
+            footer __footer;
+
+            /**
+             * @brief Copies a record out of the image.
+             * @param offset The offset of the record.
+             * @return The record.
+             * @throws std::runtime_error if the record is not within the image.
+             */
+            template <typename T>
+            T __load(
+                std::uint64_t offset
+            ) const {
+                if (offset > this->__size || this->__size - offset < sizeof(T))
+                    Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_CORRUPT);
+                T record;
+                std::memcpy(&record, this->__data + offset, sizeof(T));
+                return record;
+            }
+        };
+
+
+        /**
+         * @brief Writes a tree to a stream.
+         * @param root The root group.
+         * @param out The binary stream.
+         * @throws std::invalid_argument if the tree holds items of user types.
+         * @throws std::runtime_error if the stream fails.
+         */
+        static void write(
+            const group& root,
+            std::ostream& out
+        );
+
+
+        /**
+         * @brief Writes a tree to a file.
+         * @param root The root group.
+         * @param path The path of the file, replaced if it exists.
+         * @throws std::invalid_argument if the tree holds items of user types.
+         * @throws std::runtime_error if the file cannot be written.
+         */
+        static void write(
+            const group& root,
+            const std::string& path
+        );
+
+
+        /**
+         * @brief Reads a tree from an image in memory.
+         *        Choice lists are shared by the items that shared them when written.
+         * @param data The image.
+         * @param size The size of the image in bytes.
+         * @param resource The memory resource of the tree, null for the default resource.
+         * @return The root group.
+         * @throws std::runtime_error if the data is not a valid image.
+         */
+        static group read(
+            const void* data,
+            std::size_t size,
+            std::pmr::memory_resource* resource = nullptr
+        );
+
+
+        /**
+         * @brief Reads the subtree of a node record of an image.
+         * @param source The image.
+         * @param node The offset of the node record, e.g. image::info().root.
+         * @param resource The memory resource of the subtree, null for the default resource.
+         * @return The group of the node record.
+         * @throws std::runtime_error if the records are corrupt.
+         */
+        static group read(
+            const image& source,
+            std::uint64_t node,
+            std::pmr::memory_resource* resource = nullptr
+        );
+
+
+        /**
+         * @brief Reads a tree from a stream, which is read to its end.
+         * @param in The binary stream.
+         * @param resource The memory resource of the tree, null for the default resource.
+         * @return The root group.
+         * @throws std::runtime_error if the data is not a valid image.
+         */
+        static group read(
+            std::istream& in,
+            std::pmr::memory_resource* resource = nullptr
+        );
+
+
+        /**
+         * @brief Reads a tree from a file.
+         * @param path The path of the file.
+         * @param resource The memory resource of the tree, null for the default resource.
+         * @return The root group.
+         * @throws std::runtime_error if the file cannot be opened or is not a valid image.
+         */
+        static group read(
+            const std::string& path,
+            std::pmr::memory_resource* resource = nullptr
+        );
+
+        /**
+         * @brief Reads a tree lazily from a file, which is mapped into memory.
+         *        Only the root group is created, the items and children of a group are read
+         *        when first used, see group::items(), and its children are pending in turn.
+         *        Loading is thread-safe as long as the memory resource is (an arena is not).
+         *        The mapping stays open until every group read from it is loaded or destroyed.
+         * @param path The path of the file.
+         * @param resource The memory resource of the tree, null for the default resource.
+         * @return The root group, pending.
+         * @throws std::runtime_error if the file cannot be mapped or is not a valid image.
+         */
+        static group read_lazy(
+            const std::string& path,
+            std::pmr::memory_resource* resource = nullptr
+        );
+
+
+        /**
+         * @brief Reads a tree lazily from a stream, which is read to its end and kept in memory.
+         * @param in The binary stream.
+         * @param resource The memory resource of the tree, null for the default resource.
+         * @return The root group, pending.
+         * @throws std::runtime_error if the data is not a valid image.
+         */
+        static group read_lazy(
+            std::istream& in,
+            std::pmr::memory_resource* resource = nullptr
+        );
+
+    private:
+        /* groups read lazily load themselves through __load */
+        friend class group;
+
+        /* the state of a write and of a read, defined in the implementation file */
+        struct __writer;
+        struct __reader;
+        struct __source;
+
+        /**
+         * @brief Writes the records of a subtree, children first.
+         * @param node The root of the subtree.
+         * @param out The state of the write.
+         * @return The offset of the node record.
+         */
+        static std::uint64_t __write(
+            const group& node,
+            __writer& out
+        );
+
+        /**
+         * @brief Reads the items and the subtree of a node record into an empty group.
+         * @param offset The offset of the node record.
+         * @param dst The group receiving the node, its resource is used for the whole subtree.
+         * @param in The state of the read.
+         */
+        static void __read(
+            std::uint64_t offset,
+            group& dst,
+            __reader& in
+        );
+
+        /**
+         * @brief Reads the item records of a node record into a container.
+         * @param offset The offset of the node record.
+         * @param record The node record.
+         * @param items The container receiving the items.
+         * @param in The state of the read.
+         */
+        static void __read_items(
+            std::uint64_t offset,
+            const node_record& record,
+            container& items,
+            __reader& in
+        );
+
+        /**
+         * @brief Creates the pending root group of an image.
+         * @param source The image, shared by every group read from it.
+         * @param resource The memory resource of the tree.
+         * @return The root group.
+         */
+        static group __lazy_root(
+            std::shared_ptr<const image> source,
+            std::pmr::memory_resource* resource
+        );
+
+        /**
+         * @brief Loads the items of a pending group and creates its children, pending in turn.
+         *        Called by the group under its lock, the group is left empty if the records are corrupt.
+         * @param node The pending group.
+         * @param pending The record of the group.
+         */
+        static void __load(
+            const group& node,
+            const group::lazy_node& pending
+        );
+    };
+} // namespace treecode
+
+#endif // SNAPSHOT_H
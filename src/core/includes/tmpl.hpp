@@ -43,6 +43,8 @@
  * @brief Include necessary headers
  */
 #include "group.hpp"
+#include <mutex>
+#include <shared_mutex>
 
 namespace treecode {
     /**
@@ -51,6 +53,21 @@ namespace treecode {
      * 
      * The tmpl class provides methods to manage and clone groups within a template.
      * It allows adding groups, retrieving the name and groups, and cloning the template or specific groups.
+     *
+     * Groups are found by name through a hash index. The first time a group is cloned it
+     * is compiled into an immutable clone plan: a compacted prototype of its items and
+     * the plans of its children. Instances are then produced by copying the prototype
+     * slots in bulk. A plan records the version of its group, which the first write to the
+     * subtree of the group after the compilation moves on, so changes made through groups()
+     * or a held group are seen by the next clone, which compiles the group again. This holds
+     * for changes the content hash cannot see, as items of user types hash by address, as
+     * long as the items report them with base::__notify or base::__touched; call invalidate()
+     * after an edit that does not. Cloning is thread-safe, as long as the template groups are
+     * not written at the same time.
+     *
+     * Instances cloned with clone_mode::shared reference the items of the plan and only
+     * copy an item on its first write, see container. Inline slots are always copied.
+     * get/get<T> copy the plan item first, find and value<T> read it in place.
      */
     class tmpl {
     public:
@@ -66,6 +83,15 @@ namespace treecode {
         ~tmpl() = default;
 
 
+        /**
+         * @brief Copy and move operations, compiled plans are immutable and shared by copies.
+         */
+        tmpl(const tmpl& other);
+        tmpl(tmpl&& other);
+        tmpl& operator=(const tmpl& other);
+        tmpl& operator=(tmpl&& other);
+
+
         /**
          * @brief Constructor for the groupTemplate class.
          * @param name The name of the template.
@@ -95,6 +121,10 @@ namespace treecode {
             const group& grp
         );
 
+        void add(
+            group&& grp
+        );
+
 
         /**
          * @brief Method to get the name of the template.
@@ -110,6 +140,16 @@ namespace treecode {
         const std::vector<std::shared_ptr<group>>& groups() const;
 
 
+        /**
+         * @brief Method to check if the template has a group.
+         * @param name The name of the group.
+         * @return True if a group of the template has the name.
+         */
+        bool has(
+            const std::string& name
+        ) const;
+
+
         /**
          * @brief Method to create an instance of the template.
          * @return The created instance of the template.
@@ -126,7 +166,144 @@ namespace treecode {
             const std::string& name
         ) const;
 
+
+        /**
+         * @brief Method to create an instance of a specific group within the template
+         *        allocated from a memory resource.
+         * @param name The name of the group to create an instance of.
+         * @param resource The memory resource of the instance, e.g. a treecode::arena.
+         * @return The created instance of the group, bound to the resource.
+         */
+        group clone(
+            const std::string& name,
+            std::pmr::memory_resource* resource
+        ) const;
+
+
+        /**
+         * @brief Method to create an instance of a specific group within the template
+         *        with the given clone mode.
+         * @param name The name of the group to create an instance of.
+         * @param mode clone_mode::shared to share the items with the template until their first write.
+         * @param resource The memory resource of the instance, null for the default resource.
+         * @return The created instance of the group.
+         */
+        group clone(
+            const std::string& name,
+            clone_mode mode,
+            std::pmr::memory_resource* resource = nullptr
+        ) const;
+
+
+        /**
+         * @brief Method to create an instance of a specific group within the template on a thread pool.
+         *        Child subtrees are instantiated by parallel tasks of at least options.grain groups,
+         *        the instance allocates from the default resource.
+         * @param name The name of the group to create an instance of.
+         * @param options The pool and grain size of the instantiation.
+         * @param mode The clone mode of the items.
+         * @return The created instance of the group.
+         */
+        group clone(
+            const std::string& name,
+            const parallel& options,
+            clone_mode mode = clone_mode::deep
+        ) const;
+
+
+        /**
+         * @brief Method to create a shared instance of a specific group within the template.
+         *        The instance is built in its node, without the copy of group::add(const group&).
+         * @param name The name of the group to create an instance of.
+         * @param mode The clone mode of the items.
+         * @param resource The memory resource of the instance, null for the default resource.
+         * @return A shared pointer to the created instance.
+         */
+        std::shared_ptr<group> clone_ptr(
+            const std::string& name,
+            clone_mode mode = clone_mode::deep,
+            std::pmr::memory_resource* resource = nullptr
+        ) const;
+
+
+        /**
+         * @brief Method to create many instances of a specific group within the template.
+         *        The group is resolved once and the instances are allocated in one block,
+         *        which lives as long as any of them.
+         * @param name The name of the group to create instances of.
+         * @param count The number of instances.
+         * @param mode The clone mode of the items.
+         * @param resource The memory resource of the instances, null for the default resource.
+         * @return The created instances.
+         */
+        std::vector<std::shared_ptr<group>> clone_n(
+            const std::string& name,
+            std::size_t count,
+            clone_mode mode = clone_mode::deep,
+            std::pmr::memory_resource* resource = nullptr
+        ) const;
+
+
+        /**
+         * @brief Method to create many instances of a specific group within the template
+         *        and attach them as children of a group.
+         *        The instances are allocated from the resource of the target group.
+         * @param name The name of the group to create instances of.
+         * @param count The number of instances.
+         * @param target The group receiving the instances as children.
+         * @param mode The clone mode of the items.
+         */
+        void clone_n(
+            const std::string& name,
+            std::size_t count,
+            group& target,
+            clone_mode mode = clone_mode::deep
+        ) const;
+
+
+        /**
+         * @brief Method to create many instances of a specific group within the template
+         *        and pass them to a function.
+         * @param name The name of the group to create instances of.
+         * @param count The number of instances.
+         * @param fn Callable invoked as fn(const std::shared_ptr<group>&) for every instance.
+         * @param mode The clone mode of the items.
+         * @param resource The memory resource of the instances, null for the default resource.
+         */
+        template <typename F>
+        void clone_n(
+            const std::string& name,
+            std::size_t count,
+            F&& fn,
+            clone_mode mode = clone_mode::deep,
+            std::pmr::memory_resource* resource = nullptr
+        ) const;
+
+
+        /**
+         * @brief Drops the compiled clone plans, releasing their memory.
+         *        Changed groups are compiled again without it, unless an item of a user type
+         *        was edited without base::__notify or base::__touched.
+         */
+        void invalidate();
+
     private:
+        /* validators check instances against the compiled plans */
+        friend class validator;
+
+        /**
+         * @struct plan
+         * @brief The compiled form of a template group.
+         */
+        struct plan {
+            std::string name;
+            container items;
+            std::vector<std::shared_ptr<const plan>> children;
+            std::size_t nodes = 1;      /* the number of groups of the subtree */
+            std::uint64_t version = 0;  /* the group::__hash version of the group when compiled */
+        };
+
+
         /**
          * @var std::string tmpl::__name
          * The name of the template.
@@ -140,14 +317,119 @@ namespace treecode {
         std::vector<std::shared_ptr<group>> __groups;
 
         /**
-         * @brief Clone the group.
-         * @param instance The instance to clone.
-         * @return A shared pointer to the cloned group.
+         * @var std::unordered_map<std::string, std::size_t> tmpl::__index
+         * The position of the first group of each name.
          */
-        group __clone_group(
-            const std::shared_ptr<group>& grp
+        std::unordered_map<std::string, std::size_t> __index;
+
+        /**
+         * @var std::vector<std::shared_ptr<const plan>> tmpl::__plans
+         * The compiled plan of each group, null until the group is first cloned.
+         */
+        mutable std::vector<std::shared_ptr<const plan>> __plans;
+
+        /**
+         * @var std::shared_mutex tmpl::__mutex
+         * Guards the compiled plans.
+         */
+        mutable std::shared_mutex __mutex;
+
+        /**
+         * @brief Gets the plan of a group, compiling it on first use and after a change.
+         * @param pos The position of the group.
+         * @return The plan of the group.
+         */
+        std::shared_ptr<const plan> __plan(
+            std::size_t pos
+        ) const;
+
+        /**
+         * @brief Gets the plan of a group by name, compiling it on first use.
+         * @param name The name of the group.
+         * @return The plan of the group.
+         * @throws std::invalid_argument if the group is not found.
+         */
+        std::shared_ptr<const plan> __plan(
+            const std::string& name
+        ) const;
+
+        /**
+         * @brief Compiles a group and its children into a plan.
+         * @param grp The group to compile.
+         * @return The plan of the group.
+         */
+        static std::shared_ptr<const plan> __compile(
+            const group& grp
+        );
+
+        /**
+         * @brief Creates a group from a plan.
+         * @param p The plan to instantiate.
+         * @param resource The memory resource of the instance.
+         * @param mode The clone mode of the items.
+         * @return The created group.
+         */
+        static group __instantiate(
+            const plan& p,
+            std::pmr::memory_resource* resource,
+            clone_mode mode
+        );
+
+        /**
+         * @brief Fills an empty group from a plan.
+         * @param p The plan to instantiate.
+         * @param instance The group receiving the items and children, its resource is used for the subtree.
+         * @param mode The clone mode of the items.
+         * @param tasks The task group forking child subtrees, null for a serial instantiation.
+         * @param grain The minimum number of groups instantiated by a forked task.
+         */
+        static void __instantiate_into(
+            const plan& p,
+            group& instance,
+            clone_mode mode,
+            task_group* tasks,
+            std::size_t grain
+        );
+
+        /**
+         * @brief Creates a block of instances of a group.
+         * @param name The name of the group.
+         * @param count The number of instances.
+         * @param mode The clone mode of the items.
+         * @param resource The memory resource of the block and the instances.
+         * @return The block of instances.
+         * @throws std::invalid_argument if the group is not found.
+         */
+        std::shared_ptr<std::pmr::vector<group>> __instantiate_n(
+            const std::string& name,
+            std::size_t count,
+            clone_mode mode,
+            std::pmr::memory_resource* resource
         ) const;
     };
+
+
+    /**
+     * @brief Method to create many instances of a specific group within the template
+     *        and pass them to a function.
+     * @param name The name of the group to create instances of.
+     * @param count The number of instances.
+     * @param fn The function receiving the instances.
+     * @param mode The clone mode of the items.
+     * @param resource The memory resource of the instances.
+     */
+    template <typename F>
+    void tmpl::clone_n(
+        const std::string& name,
+        std::size_t count,
+        F&& fn,
+        clone_mode mode,
+        std::pmr::memory_resource* resource
+    ) const {
+        auto block = this->__instantiate_n(name, count, mode, resource);
+        /* every instance shares the ownership of the block */
+        for (auto& instance : *block) fn(std::shared_ptr<group>(block, &instance));
+    }
 } // namespace treecode
 
 #endif // TMPL_H
\ No newline at end of file
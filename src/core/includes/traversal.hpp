@@ -0,0 +1,354 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file traversal.hpp
+ * @brief Header file for the tree traversal ranges.
+ * @ingroup Core
+ *
+ * This file contains the iterative pre-order, post-order and breadth-first
+ * traversals of a group tree, over its groups or over the items of its groups.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the tree traversal ranges
+ */
+#ifndef TRAVERSAL_H
+#define TRAVERSAL_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "group.hpp"
+#include <iterator>
+
+namespace treecode {
+    /**
+     * @enum traversal
+     * @brief The order groups are visited in.
+     */
+    enum class traversal : std::uint8_t {
+        pre_order,      /* a group before its children */
+        post_order,     /* a group after its children */
+        breadth_first   /* all groups of a depth before the next depth */
+    };
+
+
+    /**
+     * @struct tree_node
+     * @brief A visited group with its position in the tree.
+     */
+    template <typename G>
+    struct tree_node {
+        G* node = nullptr;          /* the visited group */
+        G* parent = nullptr;        /* its parent, null for the root */
+        std::size_t depth = 0;      /* 0 for the root */
+        std::size_t index = 0;      /* its position among the children of its parent */
+    };
+
+
+    /**
+     * @struct tree_item
+     * @brief A visited item with the group holding it.
+     */
+    struct tree_item {
+        const group* owner;             /* the group holding the item */
+        std::size_t depth;              /* the depth of the group */
+        const key& id;                  /* the key of the item */
+        container::item_view item;      /* the slot of the item */
+    };
+
+
+    /**
+     * @class tree_range
+     * @brief Range over the groups of a tree, walked with an explicit stack or queue.
+     *
+     * The iterators are single pass and hold the pending groups, so walking a tree
+     * uses heap memory proportional to its depth times its fanout (its width for
+     * breadth_first) and constant stack. The tree must not be modified while it is walked. G is group
+     * or const group.
+     */
+    template <typename G>
+    class tree_range {
+    public:
+        /**
+         * @class iterator
+         * @brief Input iterator yielding tree_node<G>.
+         */
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = tree_node<G>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const tree_node<G>*;
+            using reference = const tree_node<G>&;
+
+            iterator() = default;
+
+            reference operator*() const { return this->__current; }
+            pointer operator->() const { return &this->__current; }
+
+            iterator& operator++() {
+                this->__advance();
+                return *this;
+            }
+
+            void operator++(int) { this->__advance(); }
+
+            bool operator==(const iterator& other) const { return this->__current.node == other.__current.node; }
+            bool operator!=(const iterator& other) const { return this->__current.node != other.__current.node; }
+
+        private:
+            friend class tree_range;
+
+            /**
+             * @struct frame
+             * @brief A pending group, next is the next child to descend into (post_order).
+             */
+            struct frame {
+                tree_node<G> at;
+                std::size_t next = 0;
+            };
+
+            iterator(
+                G* root,
+                traversal order
+            ) : __order(order) {
+                if (!root) return;
+                this->__stack.push_back({{root, nullptr, 0, 0}, 0});
+                this->__advance();
+            }
+
+            /* moves to the next group, or to the end */
+            void __advance() {
+                switch (this->__order) {
+                    case traversal::pre_order: this->__next_pre(); break;
+                    case traversal::post_order: this->__next_post(); break;
+                    case traversal::breadth_first: this->__next_breadth(); break;
+                }
+            }
+
+            void __next_pre() {
+                if (this->__stack.empty()) {
+                    this->__current = {};
+                    return;
+                }
+                this->__current = this->__stack.back().at;
+                this->__stack.pop_back();
+                /* children are pushed last to first so the first child is visited next */
+                const auto& children = this->__current.node->children();
+                for (std::size_t i = children.size(); i-- > 0;) {
+                    if (children[i]) this->__stack.push_back({{children[i].get(), this->__current.node, this->__current.depth + 1, i}, 0});
+                }
+            }
+
+            void __next_post() {
+                while (!this->__stack.empty()) {
+                    frame& top = this->__stack.back();
+                    const auto& children = top.at.node->children();
+                    if (top.next < children.size()) {
+                        const std::size_t i = top.next++;
+                        if (children[i]) {
+                            const tree_node<G> child{children[i].get(), top.at.node, top.at.depth + 1, i};
+                            this->__stack.push_back({child, 0});
+                        }
+                        continue;
+                    }
+                    /* every child was visited */
+                    this->__current = top.at;
+                    this->__stack.pop_back();
+                    return;
+                }
+                this->__current = {};
+            }
+
+            /* the stack is used as a queue, consumed from __head */
+            void __next_breadth() {
+                if (this->__head == this->__stack.size()) {
+                    this->__current = {};
+                    return;
+                }
+                this->__current = this->__stack[this->__head++].at;
+                /* drop the consumed front once it dominates the queue */
+                if (this->__head > 1024 && this->__head * 2 > this->__stack.size()) {
+                    this->__stack.erase(this->__stack.begin(), this->__stack.begin() + static_cast<std::ptrdiff_t>(this->__head));
+                    this->__head = 0;
+                }
+                const auto& children = this->__current.node->children();
+                for (std::size_t i = 0; i < children.size(); ++i) {
+                    if (children[i]) this->__stack.push_back({{children[i].get(), this->__current.node, this->__current.depth + 1, i}, 0});
+                }
+            }
+
+            traversal __order = traversal::pre_order;
+            tree_node<G> __current;
+            std::vector<frame> __stack;
+            std::size_t __head = 0;
+        };
+
+        /**
+         * @brief Constructs a range over a tree.
+         * @param root The root group.
+         * @param order The traversal order.
+         */
+        tree_range(
+            G& root,
+            traversal order
+        ) : __root(&root), __order(order) {}
+
+        iterator begin() const { return iterator(this->__root, this->__order); }
+        iterator end() const { return iterator(); }
+
+    private:
+        G* __root;
+        traversal __order;
+    };
+
+
+    /**
+     * @class item_range
+     * @brief Range over the items of the groups of a tree, in the order of their groups
+     *        and in insertion order within a group. Keys and items are not copied.
+     */
+    class item_range {
+    public:
+        /**
+         * @class iterator
+         * @brief Input iterator yielding tree_item by value.
+         */
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = tree_item;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = tree_item;
+
+            iterator() = default;
+
+            tree_item operator*() const {
+                return {this->__groups->node, this->__groups->depth, *this->__item, this->__item.item()};
+            }
+
+            iterator& operator++() {
+                ++this->__item;
+                this->__settle();
+                return *this;
+            }
+
+            void operator++(int) { ++*this; }
+
+            bool operator==(const iterator& other) const { return this->__at_end() == other.__at_end() && (this->__at_end() || this->__item == other.__item); }
+            bool operator!=(const iterator& other) const { return !(*this == other); }
+
+        private:
+            friend class item_range;
+
+            iterator(
+                const group& root,
+                traversal order
+            ) : __groups(tree_range<const group>(root, order).begin()) {
+                this->__enter();
+                this->__settle();
+            }
+
+            bool __at_end() const { return this->__groups->node == nullptr; }
+
+            /* starts on the items of the current group */
+            void __enter() {
+                if (this->__at_end()) return;
+                const auto keys = this->__groups->node->items().keys_view();
+                this->__item = keys.begin();
+                this->__last = keys.end();
+            }
+
+            /* skips groups without items left */
+            void __settle() {
+                while (!this->__at_end() && this->__item == this->__last) {
+                    ++this->__groups;
+                    this->__enter();
+                }
+            }
+
+            tree_range<const group>::iterator __groups;
+            container::key_view::iterator __item;
+            container::key_view::iterator __last;
+        };
+
+        /**
+         * @brief Constructs a range over the items of a tree.
+         * @param root The root group.
+         * @param order The traversal order of the groups.
+         */
+        item_range(
+            const group& root,
+            traversal order
+        ) : __root(&root), __order(order) {}
+
+        iterator begin() const { return iterator(*this->__root, this->__order); }
+        iterator end() const { return iterator(); }
+
+    private:
+        const group* __root;
+        traversal __order;
+    };
+
+
+    /**
+     * @brief Walks the groups of a tree.
+     * @param root The root group.
+     * @param order The traversal order, pre_order by default.
+     * @return A range of tree_node, e.g. for (const auto& n : walk(root)) n.node->name();
+     */
+    inline tree_range<group> walk(
+        group& root,
+        traversal order = traversal::pre_order
+    ) {
+        return tree_range<group>(root, order);
+    }
+
+    inline tree_range<const group> walk(
+        const group& root,
+        traversal order = traversal::pre_order
+    ) {
+        return tree_range<const group>(root, order);
+    }
+
+
+    /**
+     * @brief Walks the items of the groups of a tree.
+     * @param root The root group.
+     * @param order The traversal order of the groups, pre_order by default.
+     * @return A range of tree_item, e.g. for (auto i : walk_items(root)) i.id.str();
+     */
+    inline item_range walk_items(
+        const group& root,
+        traversal order = traversal::pre_order
+    ) {
+        return item_range(root, order);
+    }
+} // namespace treecode
+
+#endif // TRAVERSAL_H
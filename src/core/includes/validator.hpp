@@ -0,0 +1,229 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file validator.hpp
+ * @class validator
+ * @brief Header file for the validator class and the validate function.
+ * @ingroup Core
+ *
+ * This file contains the definition of the validator class, which checks
+ * whole trees against the groups of a template and reports the problems it
+ * finds as diagnostics instead of exceptions.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the validator class
+ */
+#ifndef VALIDATOR_H
+#define VALIDATOR_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "tmpl.hpp"
+
+namespace treecode {
+    /**
+     * @enum issue
+     * @brief The kind of a problem found by a validator.
+     */
+    enum class issue : std::uint8_t {
+        missing_item,       /* an item of the template group is absent */
+        unexpected_item,    /* an item is not in the template group */
+        wrong_type,         /* an item has another type than in the template group */
+        required_unset,     /* a required item has no value */
+        invalid_choice,     /* a value is not one of the choices of its item */
+        missing_group,      /* no child has the name of a child of the template group */
+        unexpected_group,   /* a child of a checked group matches no template group */
+        unreadable          /* the group could not be loaded from its snapshot */
+    };
+
+
+    /**
+     * @struct diagnostic
+     * @brief A problem found in a tree.
+     */
+    struct diagnostic {
+        issue kind = issue::missing_item;
+        std::vector<std::size_t> position;  /* the child positions leading from the root to the group */
+        std::string path;                   /* the same route as a query, e.g. DID[3]/ELEMENT[0], empty for the root */
+        std::string key;                    /* the item key, or the group name for missing groups */
+    };
+
+
+    /**
+     * @struct validation
+     * @brief The outcome of validating a tree.
+     */
+    struct validation {
+        std::vector<diagnostic> diagnostics;    /* in pre-order of the groups, then in template order */
+        std::size_t groups = 0;                 /* the number of groups checked against a template group */
+
+        /**
+         * @brief Checks if no problem was found.
+         * @return True if the tree matches the template.
+         */
+        bool ok() const { return this->diagnostics.empty(); }
+    };
+
+
+    /**
+     * @class validator
+     * @brief Checks trees against the groups of a template.
+     *
+     * A group named after a group of the template is checked against it. The checks
+     * are these:
+     *  - every item of the template group is present with the same type;
+     *  - an item required in the template group or in the group has a value;
+     *  - a value is one of the choices of its item;
+     *  - the group holds no other item;
+     *  - a child with the name of a child of the template group is checked against it;
+     *  - every child name of the template group has a child.
+     * Other children are checked against the template group of their name. Children
+     * with no template group are reported, and their own children are still visited.
+     * Groups outside of any checked group, such as a root holding instances, are only
+     * visited.
+     *
+     * The checklists are the clone plans of the template, compiled once per template
+     * group and shared with its clones. Each run looks them up in the template, so a
+     * template group changed between runs is compiled again and checked as it is now.
+     * Checks read the trees only and never throw. Subtrees are checked in parallel, one
+     * task per subtree of at least the grain size. The template must outlive the
+     * validator and must not be modified during a run.
+     *
+     * Usage:
+     *      treecode::validation result = treecode::validate(did_tree, did_template);
+     *      for (const auto& d : result.diagnostics) std::cerr << d.path << " " << d.key << "\n";
+     */
+    class validator {
+    public:
+        /**
+         * @brief Keeps the template whose plans the runs check against.
+         * @param source The template, which must outlive the validator.
+         */
+        explicit validator(
+            const tmpl& source
+        );
+
+
+        /**
+         * @brief Checks a tree on the calling thread.
+         * @param root The tree.
+         * @return The diagnostics and the number of checked groups.
+         */
+        validation run(
+            const group& root
+        ) const;
+
+
+        /**
+         * @brief Checks a tree on a thread pool.
+         * @param root The tree.
+         * @param options The pool and grain size of the subtree tasks.
+         * @return The diagnostics and the number of checked groups.
+         */
+        validation run(
+            const group& root,
+            const parallel& options
+        ) const;
+
+    private:
+        /* the findings of one task, merged into the shared outcome once it ends */
+        struct batch;
+        /* the state of a run shared by its tasks */
+        struct session;
+
+        /**
+         * @var const tmpl* validator::__source
+         * The template, its plans are looked up at the start of each run.
+         */
+        const tmpl* __source;
+
+        /**
+         * @brief Runs the checks of a tree, forking subtrees on tasks when given.
+         */
+        validation __run(
+            const group& root,
+            task_group* tasks,
+            std::size_t grain
+        ) const;
+
+        /**
+         * @brief Checks a group against its plan, if any, and visits its children.
+         */
+        void __check(
+            const group& g,
+            const tmpl::plan* p,
+            std::vector<std::size_t>& where,
+            session& state,
+            batch& out
+        ) const;
+
+        /**
+         * @brief Checks the items of a group against the prototype of its plan.
+         */
+        static void __items(
+            const container& items,
+            const tmpl::plan& p,
+            const std::vector<std::size_t>& where,
+            batch& out
+        );
+
+        /**
+         * @brief Finds the plan of a child, by the children of the parent plan then by the template.
+         */
+        static const tmpl::plan* __match(
+            const std::string& name,
+            const tmpl::plan* parent,
+            const session& state
+        );
+    };
+
+
+    /**
+     * @brief Checks a tree against a template on the shared pool, see validator.
+     */
+    inline validation validate(
+        const group& root,
+        const tmpl& source
+    ) {
+        return validator(source).run(root, parallel{});
+    }
+
+
+    /**
+     * @brief Checks a tree against a template on a thread pool, see validator.
+     */
+    inline validation validate(
+        const group& root,
+        const tmpl& source,
+        const parallel& options
+    ) {
+        return validator(source).run(root, options);
+    }
+} // namespace treecode
+
+#endif // VALIDATOR_H
@@ -0,0 +1,275 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file value.hpp
+ * @class value
+ * @brief Header file for the type tags and the value class.
+ * @ingroup Core
+ *
+ * This file contains the type tags identifying the common item types and the
+ * value class, a tagged value of one of those types that containers store
+ * inline instead of allocating an item.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the type tags and the value class
+ */
+#ifndef VALUE_H
+#define VALUE_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include "common.hpp"
+#include <variant>
+
+namespace treecode {
+    /**
+     * @enum type_tag
+     * @brief Identifies the value type of an item.
+     *
+     * The order of the tags matches the alternatives of value::storage, user marks
+     * any other type (items of user types are only accessible through RTTI).
+     */
+    enum class type_tag : std::uint8_t {
+        none = 0,
+        boolean,
+        int8,
+        uint8,
+        int16,
+        uint16,
+        int32,
+        uint32,
+        int64,
+        uint64,
+        float32,
+        float64,
+        string,
+        user
+    };
+
+
+    /**
+     * @struct type_tag_of
+     * @brief Maps a type to its tag, type_tag::user for types without inline storage.
+     */
+    template <typename T> struct type_tag_of { static constexpr type_tag value = type_tag::user; };
+    template <> struct type_tag_of<bool> { static constexpr type_tag value = type_tag::boolean; };
+    template <> struct type_tag_of<std::int8_t> { static constexpr type_tag value = type_tag::int8; };
+    template <> struct type_tag_of<std::uint8_t> { static constexpr type_tag value = type_tag::uint8; };
+    template <> struct type_tag_of<std::int16_t> { static constexpr type_tag value = type_tag::int16; };
+    template <> struct type_tag_of<std::uint16_t> { static constexpr type_tag value = type_tag::uint16; };
+    template <> struct type_tag_of<std::int32_t> { static constexpr type_tag value = type_tag::int32; };
+    template <> struct type_tag_of<std::uint32_t> { static constexpr type_tag value = type_tag::uint32; };
+    template <> struct type_tag_of<std::int64_t> { static constexpr type_tag value = type_tag::int64; };
+    template <> struct type_tag_of<std::uint64_t> { static constexpr type_tag value = type_tag::uint64; };
+    template <> struct type_tag_of<float> { static constexpr type_tag value = type_tag::float32; };
+    template <> struct type_tag_of<double> { static constexpr type_tag value = type_tag::float64; };
+    template <> struct type_tag_of<std::string> { static constexpr type_tag value = type_tag::string; };
+
+
+    /**
+     * @brief Checks if a type can be stored inline.
+     */
+    template <typename T>
+    constexpr bool is_inline_type = type_tag_of<T>::value != type_tag::user;
+
+
+    /**
+     * @struct tag_type
+     * @brief Carries the type of a tag to the function passed to dispatch_tag.
+     */
+    template <typename T>
+    struct tag_type { using type = T; };
+
+
+    /**
+     * @brief Calls a function with the type matching a tag.
+     * @param tag The type tag.
+     * @param fn Callable invoked as fn(tag_type<T>{}), with T = void for type_tag::none and type_tag::user.
+     * @return The result of the function.
+     */
+    template <typename F>
+    decltype(auto) dispatch_tag(
+        type_tag tag,
+        F&& fn
+    ) {
+        switch (tag) {
+            case type_tag::boolean: return fn(tag_type<bool>{});
+            case type_tag::int8: return fn(tag_type<std::int8_t>{});
+            case type_tag::uint8: return fn(tag_type<std::uint8_t>{});
+            case type_tag::int16: return fn(tag_type<std::int16_t>{});
+            case type_tag::uint16: return fn(tag_type<std::uint16_t>{});
+            case type_tag::int32: return fn(tag_type<std::int32_t>{});
+            case type_tag::uint32: return fn(tag_type<std::uint32_t>{});
+            case type_tag::int64: return fn(tag_type<std::int64_t>{});
+            case type_tag::uint64: return fn(tag_type<std::uint64_t>{});
+            case type_tag::float32: return fn(tag_type<float>{});
+            case type_tag::float64: return fn(tag_type<double>{});
+            case type_tag::string: return fn(tag_type<std::string>{});
+            default: return fn(tag_type<void>{});
+        }
+    }
+
+
+    /**
+     * @class value
+     * @brief A tagged value of one of the inline types, or no value.
+     */
+    class value {
+    public:
+        /**
+         * @typedef storage
+         * The alternatives, in type_tag order, std::monostate meaning no value.
+         */
+        using storage = std::variant<
+            std::monostate, bool,
+            std::int8_t, std::uint8_t, std::int16_t, std::uint16_t,
+            std::int32_t, std::uint32_t, std::int64_t, std::uint64_t,
+            float, double, std::string
+        >;
+
+
+        /**
+         * @brief Default constructor, holds no value.
+         */
+        value() = default;
+
+
+        /**
+         * @brief Constructs a value of an inline type.
+         * @param v The value.
+         */
+        template <typename T, typename = std::enable_if_t<is_inline_type<std::decay_t<T>>>>
+        value(T&& v) : __storage(std::in_place_type<std::decay_t<T>>, std::forward<T>(v)) {}
+
+        /* string literals are held as std::string */
+        value(const char* v) : __storage(std::in_place_type<std::string>, v) {}
+
+
+        /**
+         * @brief Gets the tag of the held value.
+         * @return The tag, type_tag::none if no value is held.
+         */
+        type_tag tag() const { return static_cast<type_tag>(this->__storage.index()); }
+
+
+        /**
+         * @brief Checks if a value is held.
+         * @return True if a value is held, false otherwise.
+         */
+        bool has_value() const { return this->__storage.index() != 0; }
+
+
+        /**
+         * @brief Gets a pointer to the held value if it has the given type.
+         * @return A pointer to the value, null if no value or another type is held.
+         */
+        template <typename T>
+        const T* get_if() const {
+            if constexpr (is_inline_type<T>) return std::get_if<T>(&this->__storage);
+            else return nullptr;
+        }
+
+        template <typename T>
+        T* get_if() {
+            if constexpr (is_inline_type<T>) return std::get_if<T>(&this->__storage);
+            else return nullptr;
+        }
+
+
+        /**
+         * @brief Replaces the held value.
+         * @param v The new value.
+         */
+        template <typename T>
+        void set(T&& v) { this->__storage.template emplace<std::decay_t<T>>(std::forward<T>(v)); }
+
+
+        /**
+         * @brief Drops the held value.
+         */
+        void reset() { this->__storage.template emplace<std::monostate>(); }
+
+
+        /**
+         * @brief Calls a function with the held value, or with std::monostate if none.
+         * @param fn The function to call.
+         * @return The result of the function.
+         */
+        template <typename F>
+        decltype(auto) visit(F&& fn) const { return std::visit(std::forward<F>(fn), this->__storage); }
+
+
+        /**
+         * @brief Compares two values, values of different tags are never equal.
+         */
+        bool operator==(const value& other) const { return this->__storage == other.__storage; }
+        bool operator!=(const value& other) const { return this->__storage != other.__storage; }
+
+
+        /**
+         * @brief Orders values by tag, then by value within a tag.
+         */
+        bool operator<(const value& other) const { return this->__storage < other.__storage; }
+
+
+        /**
+         * @brief Hashes the value, equal values have equal hashes.
+         * @return The hash of the value.
+         */
+        std::size_t hash() const {
+            return std::visit([this](const auto& v) -> std::size_t {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<T, std::monostate>) return 0;
+                else return std::hash<T>{}(v) ^ (this->__storage.index() * 0x9e3779b97f4a7c15ULL);
+            }, this->__storage);
+        }
+
+    private:
+        /**
+         * @var storage value::__storage
+         * The held value.
+         */
+        storage __storage;
+    };
+
+    static_assert(std::is_same_v<std::variant_alternative_t<static_cast<std::size_t>(type_tag::string), value::storage>, std::string>,
+        "type_tag order must match the alternatives of value::storage");
+} // namespace treecode
+
+
+/**
+ * @brief Hash support so values can be used in standard unordered containers.
+ */
+namespace std {
+    template <>
+    struct hash<treecode::value> {
+        std::size_t operator()(const treecode::value& v) const noexcept { return v.hash(); }
+    };
+} // namespace std
+
+#endif // VALUE_H
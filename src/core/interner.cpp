@@ -0,0 +1,364 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file interner.cpp
+ * @class interner
+ * @brief Implementation file for the interner class.
+ * @ingroup Core
+ *
+ * This file contains the implementation of the interner class: the content
+ * hashes and comparison of items, the bottom up walk replacing equal subtrees
+ * and items by shared instances, and the process wide interner.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the interner class
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/interner.hpp"
+
+namespace treecode {
+    namespace {
+        /**
+         * @brief Set while group::add interns the subtrees it adds.
+         */
+        std::atomic<bool> interning{false};
+
+
+        /**
+         * @brief Mixes a hash into a running hash.
+         */
+        void combine(
+            std::uint64_t& h,
+            std::uint64_t w
+        ) {
+            h ^= w + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        }
+
+
+        /**
+         * @brief Checks if an item can be shared: a typed item no child index follows.
+         */
+        bool internable(
+            const std::shared_ptr<base>& item
+        ) {
+            return item && item->tag() != type_tag::user && !item->observed();
+        }
+
+
+        /**
+         * @brief Hashes the content of a typed item: type, required flag, value and choices.
+         */
+        std::uint64_t item_hash(
+            const base& b
+        ) {
+            std::uint64_t h = static_cast<std::uint64_t>(b.tag()) | (b.is_required() ? 0x100U : 0U);
+            dispatch_tag(b.tag(), [&h, &b](auto t) {
+                using T = typename decltype(t)::type;
+                if constexpr (!std::is_void_v<T>) {
+                    /* the tag of an item is the tag of its item<T> */
+                    const auto& typed = static_cast<const item<T>&>(b);
+                    const T* v = typed.value_ptr();
+                    combine(h, v ? std::hash<T>{}(*v) + 1U : 0U);
+                    if (const std::vector<T>* list = typed.choices_ptr()) {
+                        combine(h, list->size());
+                        for (const T& choice : *list) combine(h, std::hash<T>{}(choice));
+                    }
+                }
+            });
+            return h;
+        }
+
+
+        /**
+         * @brief Checks if two typed items have the same type, required flag, value and choices.
+         */
+        bool item_equal(
+            const base& a,
+            const base& b
+        ) {
+            if (a.tag() != b.tag() || a.is_required() != b.is_required()) return false;
+            return dispatch_tag(a.tag(), [&a, &b](auto t) {
+                using T = typename decltype(t)::type;
+                if constexpr (std::is_void_v<T>) {
+                    return false;
+                } else {
+                    const auto& x = static_cast<const item<T>&>(a);
+                    const auto& y = static_cast<const item<T>&>(b);
+                    const T* vx = x.value_ptr();
+                    const T* vy = y.value_ptr();
+                    if (!vx != !vy || (vx && !(*vx == *vy))) return false;
+                    const std::vector<T>* cx = x.choices_ptr();
+                    const std::vector<T>* cy = y.choices_ptr();
+                    return cx == cy || (cx && cy && *cx == *cy);
+                }
+            });
+        }
+    }
+
+
+    /**
+     * @brief Interns a subtree: its descendants and items, then the subtree itself.
+     * @param subtree The subtree, its descendants are replaced in place.
+     * @return The shared instance of an equal subtree, the subtree itself if it is the first.
+     */
+    std::shared_ptr<group> interner::intern(
+        const std::shared_ptr<group>& subtree
+    ) {
+        if (!subtree) return subtree;
+        std::lock_guard<std::mutex> lock(this->__mutex);
+        std::unordered_set<const group*> visited;
+        dedupe_stats stats;
+        this->__walk(*subtree, visited, stats);
+        return this->__group(subtree);
+    }
+
+
+    /**
+     * @brief Interns the items of a subtree and of its descendants, its groups are kept.
+     * @param subtree The subtree.
+     * @return The number of items pointed at a shared item.
+     */
+    std::size_t interner::intern_items(
+        group& subtree
+    ) {
+        std::lock_guard<std::mutex> lock(this->__mutex);
+        std::unordered_set<const group*> visited;
+        dedupe_stats stats;
+        this->__walk(subtree, visited, stats, false);
+        return stats.items;
+    }
+
+
+    /**
+     * @brief Interns the children and items of a tree, the root itself is kept.
+     * @param root The tree.
+     * @return The number of replaced children and items.
+     */
+    dedupe_stats interner::dedupe(
+        group& root
+    ) {
+        std::lock_guard<std::mutex> lock(this->__mutex);
+        std::unordered_set<const group*> visited;
+        dedupe_stats stats;
+        this->__walk(root, visited, stats);
+        return stats;
+    }
+
+
+    /**
+     * @brief Gets the number of entries of the table, released instances included until swept.
+     * @return The number of group and item entries.
+     */
+    std::size_t interner::size() const {
+        std::lock_guard<std::mutex> lock(this->__mutex);
+        return this->__groups.size() + this->__items.size();
+    }
+
+
+    /**
+     * @brief Forgets every instance, trees already interned keep sharing theirs.
+     */
+    void interner::clear() {
+        std::lock_guard<std::mutex> lock(this->__mutex);
+        this->__groups.clear();
+        this->__items.clear();
+        this->__sweep_at = 1024;
+    }
+
+
+    /**
+     * @brief Gets the process wide interner.
+     * @return The shared interner.
+     */
+    interner& interner::shared() {
+        static interner instance;
+        return instance;
+    }
+
+
+    /**
+     * @brief Turns the process wide interning of added subtrees on or off.
+     * @param on True to intern the subtrees added by copy or move.
+     */
+    void interner::enable(
+        bool on
+    ) {
+        interning.store(on, std::memory_order_relaxed);
+    }
+
+
+    /**
+     * @brief Checks if added subtrees are interned.
+     * @return True if interning is enabled.
+     */
+    bool interner::enabled() { return interning.load(std::memory_order_relaxed); }
+
+
+    /**
+     * @brief Interns the items and the descendants of a group, skipping groups already visited.
+     * @param g The group.
+     * @param visited The groups already interned by the pass.
+     * @param stats The counts of the pass.
+     * @param groups False to keep the children, only their items are interned.
+     */
+    void interner::__walk(
+        group& g,
+        std::unordered_set<const group*>& visited,
+        dedupe_stats& stats,
+        bool groups
+    ) {
+        if (!visited.insert(&g).second) return;
+        g.__load();
+
+        /* equal items share one instance, copied by a container before its first write */
+        std::pmr::memory_resource* resource = g.__container.resource();
+        for (auto& e : g.__container.__entries) {
+            if (!e.live || e.is_inline || !internable(e.ptr)) continue;
+            std::shared_ptr<base> shared = this->__item(e.ptr, resource);
+            /* a shared slot does not own its item, the container copies it before a write */
+            if (!e.shared) g.__container.__disown(e.ptr);
+            if (shared != e.ptr) {
+                e.ptr = std::move(shared);
+                ++stats.items;
+            }
+            e.shared = true;
+        }
+
+        for (std::size_t i = 0; i < g.__children.size(); ++i) {
+            const std::shared_ptr<group> child = g.__children[i];
+            if (!child) continue;
+            this->__walk(*child, visited, stats, groups);
+            /* the children of an indexed group are followed by its index, they stay its own */
+            if (!groups || g.__indexes.ptr) continue;
+            std::shared_ptr<group> shared = this->__group(child);
+            if (shared == child) continue;
+            g.__replace(i, shared);
+            ++stats.groups;
+        }
+    }
+
+
+    /**
+     * @brief Finds or files the shared instance of a group whose descendants are interned.
+     * @param g The group.
+     * @return The shared instance, g if it is the first of its content.
+     */
+    std::shared_ptr<group> interner::__group(
+        const std::shared_ptr<group>& g
+    ) {
+        /* indexes follow the containers of their groups, indexed groups and their children are not shared */
+        if (g->__indexes.ptr || g->__container.observed()) return g;
+        const std::uint64_t h = g->hash();
+        auto range = this->__groups.equal_range(h);
+        for (auto it = range.first; it != range.second; ++it) {
+            std::shared_ptr<group> candidate = it->second.lock();
+            if (candidate == g) return g;
+            if (!candidate || candidate->__indexes.ptr || candidate->__container.observed()) continue;
+            /* the hash only selects the candidates, equality is checked slot by slot */
+            if (__same(*candidate, *g)) return candidate;
+        }
+        this->__groups.emplace(h, g);
+        this->__sweep();
+        return g;
+    }
+
+
+    /**
+     * @brief Finds or files the shared instance of an item held by containers of a resource.
+     * @param item The item.
+     * @param resource The resource of the container holding it.
+     * @return The shared instance, item if it is the first of its content.
+     */
+    std::shared_ptr<base> interner::__item(
+        const std::shared_ptr<base>& item,
+        std::pmr::memory_resource* resource
+    ) {
+        const std::uint64_t h = item_hash(*item);
+        auto range = this->__items.equal_range(h);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.resource != resource) continue;
+            std::shared_ptr<base> candidate = it->second.ptr.lock();
+            if (candidate == item) return item;
+            if (candidate && !candidate->observed() && item_equal(*candidate, *item)) return candidate;
+        }
+        this->__items.emplace(h, shared_item{item, resource});
+        this->__sweep();
+        return item;
+    }
+
+
+    /**
+     * @brief Checks if two groups whose descendants and items are interned are equal.
+     * @param a The first group.
+     * @param b The second group.
+     * @return True if the groups have the same name, resource, slots and children.
+     */
+    bool interner::__same(
+        const group& a,
+        const group& b
+    ) {
+        a.__load();
+        b.__load();
+        if (a.__name != b.__name || a.resource() != b.resource()) return false;
+        if (a.__children.size() != b.__children.size() || a.__container.size() != b.__container.size()) return false;
+        if (!std::equal(a.__children.begin(), a.__children.end(), b.__children.begin())) return false;
+
+        /* the live slots are compared in order, holes are skipped on both sides */
+        const auto& ea = a.__container.__entries;
+        const auto& eb = b.__container.__entries;
+        std::size_t i = 0;
+        std::size_t j = 0;
+        for (;;) {
+            while (i < ea.size() && !ea[i].live) ++i;
+            while (j < eb.size() && !eb[j].live) ++j;
+            if (i == ea.size() || j == eb.size()) return i == ea.size() && j == eb.size();
+            const auto& x = ea[i++];
+            const auto& y = eb[j++];
+            if (x.id != y.id || x.is_inline != y.is_inline) return false;
+            if (x.is_inline ? (x.required != y.required || x.val != y.val) : x.ptr != y.ptr) return false;
+        }
+    }
+
+
+    /**
+     * @brief Drops the entries of released instances once the tables grew past __sweep_at.
+     */
+    void interner::__sweep() {
+        if (this->__groups.size() + this->__items.size() < this->__sweep_at) return;
+        for (auto it = this->__groups.begin(); it != this->__groups.end();) {
+            it = it->second.expired() ? this->__groups.erase(it) : std::next(it);
+        }
+        for (auto it = this->__items.begin(); it != this->__items.end();) {
+            it = it->second.ptr.expired() ? this->__items.erase(it) : std::next(it);
+        }
+        /* the next sweep waits for the live entries to double */
+        this->__sweep_at = std::max<std::size_t>(1024U, 2U * (this->__groups.size() + this->__items.size()));
+    }
+} // namespace treecode
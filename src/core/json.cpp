@@ -0,0 +1,846 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file json.cpp
+ * @class json
+ * @brief Implementation file for the json class.
+ * @ingroup Core
+ *
+ * This file contains the buffered JSON writer, the pull parser reporting
+ * groups and items to a handler and the handler building a tree against
+ * a template.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the json class
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/json.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+/**
+ * @brief The smallest flush threshold of the writer
+ */
+#define JSON_MIN_BUFFER 256U
+
+/**
+ * @brief The longest number token accepted by the parser
+ */
+#define JSON_MAX_NUMBER 64U
+
+namespace treecode {
+    namespace {
+        /**
+         * @class writer
+         * @brief Formats a tree into a buffer flushed to a stream.
+         */
+        class writer {
+        public:
+            writer(
+                std::ostream& out,
+                const json::options& opts
+            ) : __out(out),
+                __pretty(opts.pretty),
+                __limit(std::max<std::size_t>(opts.buffer, JSON_MIN_BUFFER)) {
+                this->__buffer.reserve(this->__limit + JSON_MIN_BUFFER);
+            }
+
+
+            /**
+             * @brief Writes a tree, depth first with an explicit stack.
+             * @param root The root group.
+             */
+            void tree(
+                const group& root
+            ) {
+                struct frame {
+                    const group* node;
+                    std::size_t next;
+                    std::size_t depth;
+                    bool separate;
+                };
+                std::vector<frame> stack;
+                if (this->__open(root, 0)) stack.push_back({&root, 0, 0, false});
+
+                while (!stack.empty()) {
+                    frame& top = stack.back();
+                    const auto& children = top.node->children();
+                    if (top.next < children.size()) {
+                        const group* child = children[top.next++].get();
+                        if (!child) continue;
+                        if (top.separate) this->__buffer.push_back(',');
+                        top.separate = true;
+                        this->__indent(top.depth + 2);
+                        const std::size_t depth = top.depth + 2;
+                        /* top is invalidated by the push */
+                        if (this->__open(*child, depth)) stack.push_back({child, 0, depth, false});
+                    } else {
+                        this->__indent(top.depth + 1);
+                        this->__buffer.push_back(']');
+                        this->__indent(top.depth);
+                        this->__buffer.push_back('}');
+                        stack.pop_back();
+                    }
+                    if (this->__buffer.size() >= this->__limit) this->flush();
+                }
+                if (this->__pretty) this->__buffer.push_back('\n');
+                this->flush();
+            }
+
+
+            /**
+             * @brief Writes the buffered text to the stream.
+             */
+            void flush() {
+                this->__out.write(this->__buffer.data(), static_cast<std::streamsize>(this->__buffer.size()));
+                this->__buffer.clear();
+            }
+
+        private:
+            std::ostream& __out;
+            bool __pretty;
+            std::size_t __limit;
+            std::string __buffer;
+
+            /**
+             * @brief Starts a line at a depth, pretty text only.
+             */
+            void __indent(
+                std::size_t depth
+            ) {
+                if (!this->__pretty) return;
+                this->__buffer.push_back('\n');
+                this->__buffer.append(2 * depth, ' ');
+            }
+
+
+            /**
+             * @brief Writes an object key and its colon.
+             */
+            void __key(
+                std::string_view text
+            ) {
+                this->__string(text);
+                this->__buffer.push_back(':');
+                if (this->__pretty) this->__buffer.push_back(' ');
+            }
+
+
+            /**
+             * @brief Writes an escaped string, runs of plain characters are appended at once.
+             */
+            void __string(
+                std::string_view text
+            ) {
+                static const char hex[] = "0123456789abcdef";
+                this->__buffer.push_back('"');
+                std::size_t run = 0;
+                for (std::size_t i = 0; i < text.size(); ++i) {
+                    const unsigned char c = static_cast<unsigned char>(text[i]);
+                    if (c >= 0x20 && c != '"' && c != '\\') continue;
+                    this->__buffer.append(text.data() + run, i - run);
+                    run = i + 1;
+                    this->__buffer.push_back('\\');
+                    switch (c) {
+                        case '"': this->__buffer.push_back('"'); break;
+                        case '\\': this->__buffer.push_back('\\'); break;
+                        case '\n': this->__buffer.push_back('n'); break;
+                        case '\r': this->__buffer.push_back('r'); break;
+                        case '\t': this->__buffer.push_back('t'); break;
+                        case '\b': this->__buffer.push_back('b'); break;
+                        case '\f': this->__buffer.push_back('f'); break;
+                        default:
+                            this->__buffer.append("u00");
+                            this->__buffer.push_back(hex[c >> 4]);
+                            this->__buffer.push_back(hex[c & 0xF]);
+                    }
+                }
+                this->__buffer.append(text.data() + run, text.size() - run);
+                this->__buffer.push_back('"');
+            }
+
+
+            /**
+             * @brief Writes a value, null for values JSON cannot hold.
+             */
+            template <typename T>
+            void __value(
+                const T& v
+            ) {
+                if constexpr (std::is_same_v<T, std::string>) this->__string(v);
+                else if constexpr (std::is_same_v<T, bool>) this->__buffer.append(v ? "true" : "false");
+                else {
+                    if constexpr (std::is_floating_point_v<T>) {
+                        if (!std::isfinite(v)) {
+                            this->__buffer.append("null");
+                            return;
+                        }
+                    }
+                    char digits[JSON_MAX_NUMBER];
+                    /* 8 bit integers are written as numbers, not characters */
+                    using U = std::conditional_t<std::is_integral_v<T> && sizeof(T) == 1, int, T>;
+                    const auto written = std::to_chars(digits, digits + sizeof(digits), static_cast<U>(v));
+                    this->__buffer.append(digits, static_cast<std::size_t>(written.ptr - digits));
+                }
+            }
+
+
+            /**
+             * @brief Writes a group up to its children.
+             * @return True if the children array is left open, false if the group is closed.
+             */
+            bool __open(
+                const group& node,
+                std::size_t depth
+            ) {
+                this->__buffer.push_back('{');
+                this->__indent(depth + 1);
+                this->__key("name");
+                this->__string(node.name());
+
+                const container& items = node.items();
+                if (items.size()) {
+                    this->__buffer.push_back(',');
+                    this->__indent(depth + 1);
+                    this->__key("items");
+                    this->__buffer.push_back('{');
+                    bool separate = false;
+                    items.for_each([this, depth, &separate](const container::item_view& view) {
+                        if (separate) this->__buffer.push_back(',');
+                        separate = true;
+                        this->__indent(depth + 2);
+                        this->__key(view.id().view());
+                        dispatch_tag(view.tag(), [this, &view](auto t) {
+                            using T = typename decltype(t)::type;
+                            if constexpr (std::is_void_v<T>) this->__buffer.append("null");
+                            else if (const T* v = view.get_if<T>()) this->__value(*v);
+                            else this->__buffer.append("null");
+                        });
+                    });
+                    this->__indent(depth + 1);
+                    this->__buffer.push_back('}');
+                }
+
+                if (!node.children().empty()) {
+                    this->__buffer.push_back(',');
+                    this->__indent(depth + 1);
+                    this->__key("children");
+                    this->__buffer.push_back('[');
+                    return true;
+                }
+                this->__indent(depth);
+                this->__buffer.push_back('}');
+                return false;
+            }
+        };
+
+
+        /**
+         * @class parser
+         * @brief Pulls the tokens of a JSON group from a stream buffer.
+         */
+        class parser {
+        public:
+            explicit parser(
+                std::istream& in
+            ) : __in(in.rdbuf()) {}
+
+
+            /**
+             * @brief Parses a group and its subtree, depth first with an explicit stack.
+             * @param events The handler receiving the groups and items.
+             */
+            void document(
+                json::handler& events
+            ) {
+                /* one entry per open group, true while its children array is open */
+                std::vector<bool> stack;
+                auto open = [this, &events, &stack] {
+                    this->__expect('{');
+                    this->__string(this->__key);
+                    if (this->__key != "name") Exception::Throw::Runtime(this->__where(), Exception::JSON_NAME_FIRST);
+                    this->__expect(':');
+                    this->__string(this->__text);
+                    events.begin_group(this->__text);
+                    stack.push_back(false);
+                };
+
+                open();
+                while (!stack.empty()) {
+                    const int c = this->__next();
+                    if (!stack.back()) {
+                        if (c == '}') {
+                            events.end_group();
+                            stack.pop_back();
+                            continue;
+                        }
+                        if (c != ',') this->__fail();
+                        this->__string(this->__key);
+                        this->__expect(':');
+                        if (this->__key == "items") {
+                            this->__items(events);
+                        } else if (this->__key == "children") {
+                            this->__expect('[');
+                            if (this->__peek() == ']') {
+                                this->__next();
+                                continue;
+                            }
+                            stack.back() = true;
+                            open();
+                        } else {
+                            this->__skip();
+                        }
+                    } else if (c == ',') {
+                        open();
+                    } else if (c == ']') {
+                        stack.back() = false;
+                    } else {
+                        this->__fail();
+                    }
+                }
+            }
+
+        private:
+            std::streambuf* __in;
+            std::uint64_t __pos = 0;
+            std::string __key;
+            std::string __text;
+
+            /**
+             * @brief Describes the current position for error messages.
+             */
+            std::string __where() const { return "json at byte " + std::to_string(this->__pos); }
+
+            void __fail() const { Exception::Throw::Runtime(this->__where(), Exception::JSON_SYNTAX); }
+
+
+            /**
+             * @brief Reads the next character, whitespace included.
+             */
+            int __raw() {
+                const int c = this->__in->sbumpc();
+                if (c == std::char_traits<char>::eof()) this->__fail();
+                ++this->__pos;
+                return c;
+            }
+
+
+            /**
+             * @brief Skips whitespace and peeks at the next character.
+             */
+            int __peek() {
+                int c = this->__in->sgetc();
+                while (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+                    ++this->__pos;
+                    c = this->__in->snextc();
+                }
+                return c;
+            }
+
+
+            /**
+             * @brief Skips whitespace and reads the next character.
+             */
+            int __next() {
+                this->__peek();
+                return this->__raw();
+            }
+
+            void __expect(
+                char c
+            ) {
+                if (this->__next() != c) this->__fail();
+            }
+
+
+            /**
+             * @brief Reads the four hexadecimal digits of a \u escape.
+             */
+            std::uint32_t __hex() {
+                std::uint32_t code = 0;
+                for (int i = 0; i < 4; ++i) {
+                    const int c = this->__raw();
+                    code <<= 4;
+                    if (c >= '0' && c <= '9') code |= static_cast<std::uint32_t>(c - '0');
+                    else if (c >= 'a' && c <= 'f') code |= static_cast<std::uint32_t>(c - 'a' + 10);
+                    else if (c >= 'A' && c <= 'F') code |= static_cast<std::uint32_t>(c - 'A' + 10);
+                    else this->__fail();
+                }
+                return code;
+            }
+
+
+            /**
+             * @brief Reads a string into a reused buffer, escapes decoded to UTF-8.
+             */
+            void __string(
+                std::string& out
+            ) {
+                this->__expect('"');
+                out.clear();
+                for (;;) {
+                    const int c = this->__raw();
+                    if (c == '"') return;
+                    if (static_cast<unsigned char>(c) < 0x20) this->__fail();
+                    if (c != '\\') {
+                        out.push_back(static_cast<char>(c));
+                        continue;
+                    }
+                    switch (this->__raw()) {
+                        case '"': out.push_back('"'); break;
+                        case '\\': out.push_back('\\'); break;
+                        case '/': out.push_back('/'); break;
+                        case 'b': out.push_back('\b'); break;
+                        case 'f': out.push_back('\f'); break;
+                        case 'n': out.push_back('\n'); break;
+                        case 'r': out.push_back('\r'); break;
+                        case 't': out.push_back('\t'); break;
+                        case 'u': {
+                            std::uint32_t code = this->__hex();
+                            /* a high surrogate must be followed by the escape of its low surrogate */
+                            if (code >= 0xD800 && code <= 0xDBFF) {
+                                if (this->__raw() != '\\' || this->__raw() != 'u') this->__fail();
+                                const std::uint32_t low = this->__hex();
+                                if (low < 0xDC00 || low > 0xDFFF) this->__fail();
+                                code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                            } else if (code >= 0xDC00 && code <= 0xDFFF) {
+                                this->__fail();
+                            }
+                            if (code < 0x80) {
+                                out.push_back(static_cast<char>(code));
+                            } else if (code < 0x800) {
+                                out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                            } else if (code < 0x10000) {
+                                out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                                out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                            } else {
+                                out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                                out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                                out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                            }
+                            break;
+                        }
+                        default: this->__fail();
+                    }
+                }
+            }
+
+
+            /**
+             * @brief Reads a literal word.
+             */
+            void __literal(
+                std::string_view word
+            ) {
+                for (char c : word) if (this->__raw() != c) this->__fail();
+            }
+
+
+            /**
+             * @brief Reads a number, integers as int64 or uint64 while they fit, others as double.
+             */
+            value __number() {
+                char digits[JSON_MAX_NUMBER];
+                std::size_t size = 0;
+                bool integral = true;
+                for (int c = this->__in->sgetc(); (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'; c = this->__in->sgetc()) {
+                    if (size == sizeof(digits)) this->__fail();
+                    integral = integral && c != '.' && c != 'e' && c != 'E';
+                    digits[size++] = static_cast<char>(this->__raw());
+                }
+                const char* end = digits + size;
+                if (!number_grammar(digits, end)) this->__fail();
+                if (integral) {
+                    if (digits[0] == '-') {
+                        std::int64_t v = 0;
+                        const auto parsed = std::from_chars(digits, end, v);
+                        if (parsed.ec == std::errc() && parsed.ptr == end) return value(v);
+                    } else {
+                        std::uint64_t v = 0;
+                        const auto parsed = std::from_chars(digits, end, v);
+                        if (parsed.ec == std::errc() && parsed.ptr == end) {
+                            if (v <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) return value(static_cast<std::int64_t>(v));
+                            return value(v);
+                        }
+                    }
+                }
+                /* fractions, exponents and integers out of range */
+                double v = 0;
+                const auto parsed = std::from_chars(digits, end, v);
+                if (parsed.ec != std::errc() || parsed.ptr != end) this->__fail();
+                return value(v);
+            }
+
+
+            /**
+             * @brief Checks a number against the grammar of RFC 8259, no sign, leading zero or bare point.
+             */
+            static bool number_grammar(
+                const char* p,
+                const char* end
+            ) {
+                const auto digits = [&p, end]() {
+                    const char* first = p;
+                    while (p != end && *p >= '0' && *p <= '9') ++p;
+                    return p != first;
+                };
+                if (p != end && *p == '-') ++p;
+                if (p == end) return false;
+                if (*p == '0') ++p;
+                else if (!digits()) return false;
+                if (p != end && *p == '.') {
+                    ++p;
+                    if (!digits()) return false;
+                }
+                if (p != end && (*p == 'e' || *p == 'E')) {
+                    ++p;
+                    if (p != end && (*p == '+' || *p == '-')) ++p;
+                    if (!digits()) return false;
+                }
+                return p == end;
+            }
+
+
+            /**
+             * @brief Reads a string, number, boolean or null.
+             */
+            value __scalar() {
+                switch (this->__peek()) {
+                    case '"':
+                        this->__string(this->__text);
+                        return value(this->__text);
+                    case 't': this->__literal("true"); return value(true);
+                    case 'f': this->__literal("false"); return value(false);
+                    case 'n': this->__literal("null"); return value();
+                    default: return this->__number();
+                }
+            }
+
+
+            /**
+             * @brief Reads the items object of a group.
+             */
+            void __items(
+                json::handler& events
+            ) {
+                this->__expect('{');
+                if (this->__peek() == '}') {
+                    this->__next();
+                    return;
+                }
+                for (;;) {
+                    this->__string(this->__key);
+                    this->__expect(':');
+                    events.item(this->__key, this->__scalar());
+                    const int c = this->__next();
+                    if (c == '}') return;
+                    if (c != ',') this->__fail();
+                }
+            }
+
+
+            /**
+             * @brief Skips a value of any kind, nested values included.
+             */
+            void __skip() {
+                /* the brackets of the open arrays and objects */
+                std::string open;
+                for (;;) {
+                    const int c = this->__peek();
+                    if (c == '{' || c == '[') {
+                        this->__next();
+                        const char close = c == '{' ? '}' : ']';
+                        if (this->__peek() != close) {
+                            open.push_back(close);
+                            if (close == '}') this->__member();
+                            continue;
+                        }
+                        this->__next();
+                    } else if (c == '"') {
+                        this->__string(this->__text);
+                    } else {
+                        this->__scalar();
+                    }
+                    /* a value is followed by the next member or element, or closes its parent */
+                    for (;;) {
+                        if (open.empty()) return;
+                        const int n = this->__next();
+                        if (n == ',') {
+                            if (open.back() == '}') this->__member();
+                            break;
+                        }
+                        if (n != open.back()) this->__fail();
+                        open.pop_back();
+                    }
+                }
+            }
+
+
+            /**
+             * @brief Reads the key of a member of a skipped object.
+             */
+            void __member() {
+                this->__string(this->__text);
+                this->__expect(':');
+            }
+        };
+
+
+        /**
+         * @class builder
+         * @brief Builds a tree from the events of a JSON text, typed by a template.
+         */
+        class builder : public json::handler {
+        public:
+            builder(
+                const tmpl& schema,
+                std::pmr::memory_resource* resource
+            ) : __schema(schema),
+                __resource(resource ? resource : std::pmr::get_default_resource()) {}
+
+
+            /**
+             * @brief Takes the built tree.
+             * @return The root group.
+             */
+            group result() { return std::move(*this->__root); }
+
+
+            void begin_group(
+                std::string_view name
+            ) override {
+                const std::string text(name);
+                if (this->__stack.empty()) {
+                    this->__root = this->__make(text);
+                    this->__push(this->__root.get());
+                    return;
+                }
+
+                frame& parent = this->__stack.back();
+                const auto& children = parent.node->children();
+                group* node = nullptr;
+                /* the next cloned child of that name takes the values of the text */
+                for (std::size_t i = parent.cursor; i < parent.cloned; ++i) {
+                    if (children[i] && children[i]->name() == text) {
+                        node = children[i].get();
+                        parent.cursor = i + 1;
+                        break;
+                    }
+                }
+                if (!node) {
+                    auto created = this->__make(text);
+                    node = created.get();
+                    parent.node->add(created);
+                }
+                this->__push(node);
+            }
+
+
+            void item(
+                std::string_view name,
+                const value& v
+            ) override {
+                container& items = this->__stack.back().node->items();
+                const key id(name);
+                if (auto view = items.find(id)) {
+                    if (!v.has_value()) {
+                        items.clear_value(id);
+                        return;
+                    }
+                    dispatch_tag(view->tag(), [&](auto t) {
+                        using T = typename decltype(t)::type;
+                        if constexpr (std::is_void_v<T>) Exception::Throw::Invalid(id.str(), Exception::JSON_TYPE_MISMATCH);
+                        else items.value<T>(id, convert<T>(id, v));
+                    });
+                    return;
+                }
+                /* slots the template does not know take the type of the value */
+                v.visit([&items, &id](const auto& x) {
+                    using X = std::decay_t<decltype(x)>;
+                    if constexpr (!std::is_same_v<X, std::monostate>) items.add_inline<X>(id, x);
+                });
+            }
+
+
+            void end_group() override { this->__stack.pop_back(); }
+
+        private:
+            /**
+             * @struct frame
+             * @brief An open group and the first of its cloned children not matched yet.
+             */
+            struct frame {
+                group* node;
+                std::size_t cursor;
+                std::size_t cloned;
+            };
+
+            const tmpl& __schema;
+            std::pmr::memory_resource* __resource;
+            std::shared_ptr<group> __root;
+            std::vector<frame> __stack;
+
+            std::shared_ptr<group> __make(
+                const std::string& name
+            ) const {
+                if (this->__schema.has(name)) return this->__schema.clone_ptr(name, clone_mode::deep, this->__resource);
+                return make_shared_in<group>(this->__resource, name, this->__resource);
+            }
+
+            void __push(
+                group* node
+            ) {
+                this->__stack.push_back({node, 0, node->children().size()});
+            }
+
+
+            /**
+             * @brief Converts a JSON value to the type of a slot.
+             */
+            template <typename T>
+            static T convert(
+                const key& id,
+                const value& v
+            ) {
+                if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, bool>) {
+                    if (const T* x = v.get_if<T>()) return *x;
+                } else if constexpr (std::is_floating_point_v<T>) {
+                    if (const double* x = v.get_if<double>()) return static_cast<T>(*x);
+                    if (const std::int64_t* x = v.get_if<std::int64_t>()) return static_cast<T>(*x);
+                    if (const std::uint64_t* x = v.get_if<std::uint64_t>()) return static_cast<T>(*x);
+                } else {
+                    /* integers must fit the slot type */
+                    if (const std::int64_t* x = v.get_if<std::int64_t>()) {
+                        if (*x < static_cast<std::int64_t>(std::numeric_limits<T>::min()) ||
+                            (*x > 0 && static_cast<std::uint64_t>(*x) > static_cast<std::uint64_t>(std::numeric_limits<T>::max())))
+                            Exception::Throw::Range(id.str(), Exception::JSON_TYPE_MISMATCH);
+                        return static_cast<T>(*x);
+                    }
+                    if (const std::uint64_t* x = v.get_if<std::uint64_t>()) {
+                        if (*x > static_cast<std::uint64_t>(std::numeric_limits<T>::max())) Exception::Throw::Range(id.str(), Exception::JSON_TYPE_MISMATCH);
+                        return static_cast<T>(*x);
+                    }
+                }
+                Exception::Throw::Invalid(id.str(), Exception::JSON_TYPE_MISMATCH);
+                return T();
+            }
+        };
+    } // namespace
+
+
+    /**
+     * @brief Writes a tree to a stream.
+     * @param root The root group.
+     * @param out The stream.
+     * @param opts The layout of the text.
+     */
+    void json::write(
+        const group& root,
+        std::ostream& out,
+        const options& opts
+    ) {
+        writer(out, opts).tree(root);
+        if (!out) Exception::Throw::Runtime("json", Exception::FILE_WRITE_ERROR);
+    }
+
+
+    /**
+     * @brief Writes a tree to a file.
+     * @param root The root group.
+     * @param path The path of the file.
+     * @param opts The layout of the text.
+     */
+    void json::write(
+        const group& root,
+        const std::string& path,
+        const options& opts
+    ) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) Exception::Throw::Runtime(path, Exception::FILE_OPEN_ERROR);
+        write(root, out, opts);
+        out.close();
+        if (!out) Exception::Throw::Runtime(path, Exception::FILE_WRITE_ERROR);
+    }
+
+
+    /**
+     * @brief Parses a JSON group from a stream and reports it to a handler.
+     * @param in The stream.
+     * @param events The handler.
+     */
+    void json::parse(
+        std::istream& in,
+        handler& events
+    ) {
+        parser(in).document(events);
+    }
+
+
+    /**
+     * @brief Reads a tree from a stream, typed by a template.
+     * @param in The stream.
+     * @param schema The template.
+     * @param resource The memory resource of the tree.
+     * @return The root group.
+     */
+    group json::read(
+        std::istream& in,
+        const tmpl& schema,
+        std::pmr::memory_resource* resource
+    ) {
+        builder tree(schema, resource);
+        parse(in, tree);
+        return tree.result();
+    }
+
+
+    /**
+     * @brief Reads a tree from a file, typed by a template.
+     * @param path The path of the file.
+     * @param schema The template.
+     * @param resource The memory resource of the tree.
+     * @return The root group.
+     */
+    group json::read(
+        const std::string& path,
+        const tmpl& schema,
+        std::pmr::memory_resource* resource
+    ) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) Exception::Throw::Runtime(path, Exception::FILE_OPEN_ERROR);
+        return read(in, schema, resource);
+    }
+} // namespace treecode
@@ -0,0 +1,132 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file key.cpp
+ * @class key
+ * @brief Implementation file for the key class.
+ * @ingroup Core
+ *
+ * This file contains the implementation of the key class and of the
+ * process wide atom table backing it.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the key class
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/key.hpp"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+
+namespace treecode {
+    /**
+     * @brief Default constructor, refers to the empty key.
+     */
+    key::key() {
+        /* the empty atom is resolved once */
+        static const atom* const empty = __intern(std::string_view());
+        this->__atom = empty;
+    }
+
+
+    /**
+     * @brief Interns a key string.
+     * @param name The key string.
+     */
+    key::key(
+        std::string_view name
+    ) : __atom(__intern(name)) {}
+
+
+    /**
+     * @brief Gets the key string.
+     * @return The interned string.
+     */
+    const std::string& key::str() const { return this->__atom->text; }
+
+
+    /**
+     * @brief Gets the key string as a view.
+     * @return A view on the interned string.
+     */
+    std::string_view key::view() const { return this->__atom->text; }
+
+
+    /**
+     * @brief Gets the precomputed hash of the key.
+     * @return The hash of the key.
+     */
+    std::uint32_t key::hash() const { return this->__atom->hash; }
+
+
+    /**
+     * @brief Hashes a key string the same way interned keys are hashed.
+     * @param name The key string.
+     * @return The hash of the key string.
+     */
+    std::uint32_t key::hash_of(
+        std::string_view name
+    ) {
+        const std::uint64_t h = std::hash<std::string_view>{}(name);
+        return static_cast<std::uint32_t>(h ^ (h >> 32));
+    }
+
+
+    /**
+     * @brief Finds or creates the atom of a key string.
+     *        Lookups of already interned keys only take a shared lock.
+     * @param name The key string.
+     * @return The interned atom.
+     */
+    const key::atom* key::__intern(
+        std::string_view name
+    ) {
+        /* the table is created on first use, atoms live in a deque so their address is stable */
+        static std::shared_mutex mutex;
+        static std::deque<atom> atoms;
+        static std::unordered_map<std::string_view, const atom*> table;
+
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto it = table.find(name);
+            if (it != table.end()) return it->second;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        /* another thread may have interned the key in the meantime */
+        auto it = table.find(name);
+        if (it != table.end()) return it->second;
+        atoms.push_back({std::string(name), hash_of(name)});
+        const atom* a = &atoms.back();
+        table.emplace(std::string_view(a->text), a);
+        return a;
+    }
+} // namespace treecode
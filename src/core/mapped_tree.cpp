@@ -0,0 +1,220 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file mapped_tree.cpp
+ * @class mapped_tree
+ * @brief Implementation file for the mapped_tree class.
+ * @ingroup Core
+ *
+ * This file contains the read-only file mapping backing mapped_tree and the
+ * lookups of the group and item views.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the mapped_tree class
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/mapped_tree.hpp"
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace treecode {
+    /**
+     * @brief Maps a file read-only.
+     * @param path The path of the file.
+     */
+    mapped_tree::region::region(
+        const std::string& path
+    ) {
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) Exception::Throw::Runtime(path, Exception::FILE_OPEN_ERROR);
+        LARGE_INTEGER length;
+        if (!GetFileSizeEx(file, &length) || length.QuadPart == 0) {
+            CloseHandle(file);
+            Exception::Throw::Runtime(path, Exception::SNAPSHOT_BAD_MAGIC);
+        }
+        /* the mapping object keeps the file open */
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping) Exception::Throw::Runtime(path, Exception::FILE_MAP_ERROR);
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+            CloseHandle(mapping);
+            Exception::Throw::Runtime(path, Exception::FILE_MAP_ERROR);
+        }
+        this->data = static_cast<const char*>(view);
+        this->size = static_cast<std::size_t>(length.QuadPart);
+        this->handle = mapping;
+#else
+        const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0) Exception::Throw::Runtime(path, Exception::FILE_OPEN_ERROR);
+        struct stat info;
+        if (::fstat(file, &info) != 0 || info.st_size == 0) {
+            ::close(file);
+            Exception::Throw::Runtime(path, Exception::SNAPSHOT_BAD_MAGIC);
+        }
+        /* the mapping keeps the file referenced once the descriptor is closed */
+        void* view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, file, 0);
+        ::close(file);
+        if (view == MAP_FAILED) Exception::Throw::Runtime(path, Exception::FILE_MAP_ERROR);
+        this->data = static_cast<const char*>(view);
+        this->size = static_cast<std::size_t>(info.st_size);
+#endif
+    }
+
+
+    /**
+     * @brief Takes over a mapping.
+     * @param other The mapping to take over, left empty.
+     */
+    mapped_tree::region::region(
+        region&& other
+    ) noexcept : data(other.data), size(other.size), handle(other.handle) {
+        other.data = nullptr;
+        other.size = 0;
+        other.handle = nullptr;
+    }
+
+    mapped_tree::region& mapped_tree::region::operator=(
+        region&& other
+    ) noexcept {
+        /* the previous mapping is released with other */
+        std::swap(this->data, other.data);
+        std::swap(this->size, other.size);
+        std::swap(this->handle, other.handle);
+        return *this;
+    }
+
+
+    /**
+     * @brief Unmaps the file.
+     */
+    mapped_tree::region::~region() {
+        if (!this->data) return;
+#if defined(_WIN32)
+        UnmapViewOfFile(this->data);
+        CloseHandle(static_cast<HANDLE>(this->handle));
+#else
+        ::munmap(const_cast<char*>(this->data), this->size);
+#endif
+    }
+
+
+    /**
+     * @brief Maps a snapshot file.
+     * @param path The path of the file.
+     */
+    mapped_tree::mapped_tree(
+        const std::string& path
+    ) : __region(path),
+        __image(std::make_unique<snapshot::image>(this->__region.data, this->__region.size)) {}
+
+
+    /**
+     * @brief Gets a copy of the value of the slot.
+     * @return The value, no value if none is set.
+     */
+    treecode::value mapped_tree::item_view::value() const {
+        return dispatch_tag(this->tag(), [this](auto t) {
+            using T = typename decltype(t)::type;
+            if constexpr (std::is_void_v<T>) return treecode::value();
+            else {
+                const auto v = this->get<T>();
+                if constexpr (std::is_same_v<T, std::string>) return v ? treecode::value(std::string(*v)) : treecode::value();
+                else return v ? treecode::value(*v) : treecode::value();
+            }
+        });
+    }
+
+
+    /**
+     * @brief Gets an item by position.
+     * @param pos The position of the item.
+     * @return The item.
+     */
+    mapped_tree::item_view mapped_tree::group_view::item(
+        std::size_t pos
+    ) const {
+        if (pos >= this->item_count()) Exception::Throw::Range(std::string(this->name()), Exception::SNAPSHOT_OUT_OF_RANGE);
+        return item_view(this->__image, this->__image->item(this->__offset, this->__record.item_count, static_cast<std::uint32_t>(pos)));
+    }
+
+
+    /**
+     * @brief Finds an item by key.
+     * @param key The key of the item.
+     * @return The item, no value if the group has no such item.
+     */
+    std::optional<mapped_tree::item_view> mapped_tree::group_view::find(
+        std::string_view key
+    ) const {
+        for (std::size_t i = 0; i < this->item_count(); ++i) {
+            item_view view = this->item(i);
+            if (view.id() == key) return view;
+        }
+        return std::nullopt;
+    }
+
+
+    /**
+     * @brief Gets a child by position.
+     * @param pos The position of the child.
+     * @return The child.
+     */
+    mapped_tree::group_view mapped_tree::group_view::child(
+        std::size_t pos
+    ) const {
+        if (pos >= this->child_count()) Exception::Throw::Range(std::string(this->name()), Exception::SNAPSHOT_OUT_OF_RANGE);
+        return group_view(this->__image, this->__image->child(this->__offset, this->__record, static_cast<std::uint32_t>(pos)));
+    }
+
+
+    /**
+     * @brief Finds the first child with a given name.
+     * @param name The name of the child.
+     * @return The child, no value if the group has no such child.
+     */
+    std::optional<mapped_tree::group_view> mapped_tree::group_view::child(
+        std::string_view name
+    ) const {
+        for (std::size_t i = 0; i < this->child_count(); ++i) {
+            group_view view = this->child(i);
+            if (view.name() == name) return view;
+        }
+        return std::nullopt;
+    }
+} // namespace treecode
@@ -0,0 +1,410 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file persistent_group.cpp
+ * @class persistent_group
+ * @brief Implementation file for the persistent_group class.
+ * @ingroup Core
+ *
+ * This file contains the implementation of the persistent_group class, the
+ * conversions from and to groups and the path copying modifications.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the persistent_group class
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/persistent_group.hpp"
+
+#include <algorithm>
+
+namespace treecode {
+    namespace {
+        /**
+         * @brief Checks a value against the choices of an item.
+         * @param choices A std::vector of the type of the value, null for items without choices.
+         * @return True if the item has no choices or the value is one of them.
+         */
+        bool allowed(
+            const std::shared_ptr<const void>& choices,
+            const value& v
+        ) {
+            if (!choices || !v.has_value()) return true;
+            return v.visit([&choices](const auto& x) {
+                using T = std::decay_t<decltype(x)>;
+                if constexpr (std::is_same_v<T, std::monostate>) return true;
+                else {
+                    const auto& list = *static_cast<const std::vector<T>*>(choices.get());
+                    return std::find(list.begin(), list.end(), x) != list.end();
+                }
+            });
+        }
+    } // namespace
+
+
+    /**
+     * @brief Gets the key of the item.
+     */
+    const key& persistent_group::item_view::id() const { return this->__slot->id; }
+
+
+    /**
+     * @brief Gets the type tag of the item.
+     */
+    type_tag persistent_group::item_view::tag() const { return this->__slot->tag; }
+
+
+    /**
+     * @brief Checks the flags of the item.
+     */
+    bool persistent_group::item_view::is_inline() const { return this->__slot->is_inline; }
+    bool persistent_group::item_view::is_required() const { return this->__slot->required; }
+    bool persistent_group::item_view::has_value() const { return this->__slot->value.has_value(); }
+
+
+    /**
+     * @brief Gets the value of the item.
+     */
+    const value& persistent_group::item_view::value() const { return this->__slot->value; }
+
+
+    /**
+     * @brief Constructs an empty group.
+     * @param name The name of the group.
+     */
+    persistent_group::persistent_group(
+        const std::string& name
+    ) : __node(std::make_shared<const node>(node{name, {}, {}})) {}
+
+
+    /**
+     * @brief Builds a version from a group and its subtree.
+     * @param source The group.
+     * @return The version.
+     */
+    persistent_group persistent_group::freeze(
+        const group& source
+    ) {
+        /* choice lists already frozen, by the address of their source list */
+        std::unordered_map<const void*, std::shared_ptr<const void>> lists;
+
+        struct builder {
+            std::unordered_map<const void*, std::shared_ptr<const void>>& lists;
+
+            std::shared_ptr<const node> operator()(const group& g) {
+                auto built = std::make_shared<node>();
+                built->name = g.name();
+                const container& items = g.items();
+                built->items.reserve(items.size());
+                items.for_each([this, &built](const container::item_view& view) {
+                    auto item = std::make_shared<slot>(slot{view.id(), view.value(), view.tag(), view.is_required(), view.is_inline(), nullptr});
+                    dispatch_tag(view.tag(), [&](auto t) {
+                        using T = typename decltype(t)::type;
+                        if constexpr (std::is_void_v<T>) {
+                            Exception::Throw::Invalid(view.id().str(), Exception::PERSISTENT_USER_TYPE);
+                        } else if (!view.is_inline()) {
+                            /* the tag of an item slot is the tag of its item<T> */
+                            if (const std::vector<T>* list = static_cast<const treecode::item<T>*>(view.ptr().get())->choices_ptr()) {
+                                auto& shared = this->lists[list];
+                                if (!shared) shared = std::make_shared<const std::vector<T>>(*list);
+                                item->choices = shared;
+                            }
+                        }
+                    });
+                    built->items.push_back(std::move(item));
+                });
+                const auto& children = g.children();
+                built->children.reserve(children.size());
+                for (const auto& child : children) {
+                    if (child) built->children.push_back((*this)(*child));
+                }
+                return built;
+            }
+        };
+        return persistent_group(builder{lists}(source));
+    }
+
+
+    /**
+     * @brief Builds a mutable group from the version.
+     * @param resource The memory resource of the group.
+     * @return The group.
+     */
+    group persistent_group::thaw(
+        std::pmr::memory_resource* resource
+    ) const {
+        if (!resource) resource = std::pmr::get_default_resource();
+        group result(this->__node->name, resource);
+        container& items = result.items();
+        for (const auto& item : this->__node->items) {
+            dispatch_tag(item->tag, [&](auto t) {
+                using T = typename decltype(t)::type;
+                if constexpr (!std::is_void_v<T>) {
+                    const T* v = item->value.template get_if<T>();
+                    if (item->is_inline) {
+                        if (v) items.add_inline<T>(item->id, *v);
+                        else items.add_inline<T>(item->id);
+                        if (item->required) items.required(item->id);
+                        return;
+                    }
+                    /* the items of every thawed group share the frozen choice list */
+                    auto created = item->choices
+                        ? items.emplace<T>(item->id, std::static_pointer_cast<const std::vector<T>>(item->choices))
+                        : items.emplace<T>(item->id);
+                    if (v) created->value(*v);
+                    else created->clear_value();
+                    if (item->required && !created->is_required()) created->required();
+                }
+            });
+        }
+        for (const auto& child : this->__node->children) result.add(persistent_group(child).thaw(resource));
+        return result;
+    }
+
+
+    /**
+     * @brief Gets the name of the group.
+     */
+    const std::string& persistent_group::name() const { return this->__node->name; }
+
+
+    /**
+     * @brief Gets the number of items and of children of the group.
+     */
+    std::size_t persistent_group::item_count() const { return this->__node->items.size(); }
+    std::size_t persistent_group::child_count() const { return this->__node->children.size(); }
+
+
+    /**
+     * @brief Finds an item by key.
+     * @param key The key of the item.
+     * @return The item, no value if the group has no such item.
+     */
+    std::optional<persistent_group::item_view> persistent_group::find(
+        const key& key
+    ) const {
+        const std::size_t pos = this->__find(key);
+        if (pos == this->__node->items.size()) return std::nullopt;
+        return item_view(this->__node->items[pos].get());
+    }
+
+
+    /**
+     * @brief Gets a child by position.
+     * @param pos The position of the child.
+     * @return The child.
+     */
+    persistent_group persistent_group::child(
+        std::size_t pos
+    ) const {
+        if (pos >= this->__node->children.size()) Exception::Throw::Range(this->__node->name, Exception::PERSISTENT_CHILD_OUT_OF_RANGE);
+        return persistent_group(this->__node->children[pos]);
+    }
+
+
+    /**
+     * @brief Gets the first child with a name.
+     * @param name The name of the child.
+     * @return The child, no value if the group has no such child.
+     */
+    std::optional<persistent_group> persistent_group::child(
+        std::string_view name
+    ) const {
+        for (const auto& c : this->__node->children) {
+            if (c->name == name) return persistent_group(c);
+        }
+        return std::nullopt;
+    }
+
+
+    /**
+     * @brief Returns a version with the value of an item replaced.
+     * @param key The key of the item.
+     * @param v The value, no value to clear it.
+     * @return The new version.
+     */
+    persistent_group persistent_group::with_value(
+        const key& key,
+        const treecode::value& v
+    ) const {
+        const std::size_t pos = this->__find(key);
+        if (pos == this->__node->items.size()) Exception::Throw::Range(key.str(), Exception::CONTAINER_KEY_NOT_FOUND);
+        const slot& current = *this->__node->items[pos];
+        if (v.has_value() && v.tag() != current.tag) Exception::Throw::Invalid(key.str(), Exception::ELEMENT_INVALID_TYPE);
+        if (!allowed(current.choices, v)) Exception::Throw::Invalid(key.str(), Exception::ELEMENT_VALUE_NOT_ALLOWED);
+        if (v == current.value) return *this;
+
+        auto replaced = std::make_shared<slot>(current);
+        replaced->value = v;
+        auto copy = std::make_shared<node>(*this->__node);
+        copy->items[pos] = std::move(replaced);
+        return persistent_group(std::move(copy));
+    }
+
+
+    /**
+     * @brief Returns a version with an inline item added.
+     * @param key The key of the item.
+     * @param v The value.
+     * @param required True if the item is required.
+     * @return The new version.
+     */
+    persistent_group persistent_group::with_item(
+        const key& key,
+        const treecode::value& v,
+        bool required
+    ) const {
+        if (this->__find(key) != this->__node->items.size()) Exception::Throw::Invalid(key.str(), Exception::CONTAINER_KEY_ALREADY_EXISTS);
+        if (!v.has_value()) Exception::Throw::Invalid(key.str(), Exception::ELEMENT_INVALID_TYPE);
+        auto copy = std::make_shared<node>(*this->__node);
+        copy->items.push_back(std::make_shared<const slot>(slot{key, v, v.tag(), required, true, nullptr}));
+        return persistent_group(std::move(copy));
+    }
+
+
+    /**
+     * @brief Returns a version with the required flag of an item set or cleared.
+     * @param key The key of the item.
+     * @param required The flag.
+     * @return The new version.
+     */
+    persistent_group persistent_group::with_required(
+        const key& key,
+        bool required
+    ) const {
+        const std::size_t pos = this->__find(key);
+        if (pos == this->__node->items.size()) Exception::Throw::Range(key.str(), Exception::CONTAINER_KEY_NOT_FOUND);
+        if (this->__node->items[pos]->required == required) return *this;
+
+        auto replaced = std::make_shared<slot>(*this->__node->items[pos]);
+        replaced->required = required;
+        auto copy = std::make_shared<node>(*this->__node);
+        copy->items[pos] = std::move(replaced);
+        return persistent_group(std::move(copy));
+    }
+
+
+    /**
+     * @brief Returns a version without an item.
+     * @param key The key of the item.
+     * @return The new version.
+     */
+    persistent_group persistent_group::without_item(
+        const key& key
+    ) const {
+        const std::size_t pos = this->__find(key);
+        if (pos == this->__node->items.size()) return *this;
+        auto copy = std::make_shared<node>(*this->__node);
+        copy->items.erase(copy->items.begin() + static_cast<std::ptrdiff_t>(pos));
+        return persistent_group(std::move(copy));
+    }
+
+
+    /**
+     * @brief Returns a version with a child replaced.
+     * @param pos The position of the child.
+     * @param child The new child.
+     * @return The new version.
+     */
+    persistent_group persistent_group::with_child(
+        std::size_t pos,
+        const persistent_group& child
+    ) const {
+        if (pos >= this->__node->children.size()) Exception::Throw::Range(this->__node->name, Exception::PERSISTENT_CHILD_OUT_OF_RANGE);
+        if (this->__node->children[pos] == child.__node) return *this;
+        auto copy = std::make_shared<node>(*this->__node);
+        copy->children[pos] = child.__node;
+        return persistent_group(std::move(copy));
+    }
+
+
+    /**
+     * @brief Returns a version with a child appended.
+     * @param child The child.
+     * @return The new version.
+     */
+    persistent_group persistent_group::with_added_child(
+        const persistent_group& child
+    ) const {
+        auto copy = std::make_shared<node>(*this->__node);
+        copy->children.push_back(child.__node);
+        return persistent_group(std::move(copy));
+    }
+
+
+    /**
+     * @brief Returns a version without a child.
+     * @param pos The position of the child.
+     * @return The new version.
+     */
+    persistent_group persistent_group::without_child(
+        std::size_t pos
+    ) const {
+        if (pos >= this->__node->children.size()) Exception::Throw::Range(this->__node->name, Exception::PERSISTENT_CHILD_OUT_OF_RANGE);
+        auto copy = std::make_shared<node>(*this->__node);
+        copy->children.erase(copy->children.begin() + static_cast<std::ptrdiff_t>(pos));
+        return persistent_group(std::move(copy));
+    }
+
+
+    /**
+     * @brief Finds the position of an item.
+     * @param key The key of the item.
+     * @return The position, the number of items if the key does not exist.
+     */
+    std::size_t persistent_group::__find(
+        const key& key
+    ) const {
+        const auto& items = this->__node->items;
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            if (items[i]->id == key) return i;
+        }
+        return items.size();
+    }
+
+
+    /**
+     * @brief Gets the nodes from this group down to the end of a path.
+     * @param path The child positions.
+     * @return The nodes, this group first.
+     */
+    std::vector<std::shared_ptr<const persistent_group::node>> persistent_group::__path(
+        const std::vector<std::size_t>& path
+    ) const {
+        std::vector<std::shared_ptr<const node>> nodes;
+        nodes.reserve(path.size() + 1);
+        nodes.push_back(this->__node);
+        for (std::size_t pos : path) {
+            const auto& children = nodes.back()->children;
+            if (pos >= children.size()) Exception::Throw::Range(nodes.back()->name, Exception::PERSISTENT_CHILD_OUT_OF_RANGE);
+            nodes.push_back(children[pos]);
+        }
+        return nodes;
+    }
+} // namespace treecode
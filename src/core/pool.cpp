@@ -0,0 +1,202 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file pool.cpp
+ * @class pool
+ * @brief Implementation file for the pool and task_group classes.
+ * @ingroup Core
+ *
+ * This file contains the implementation of the work-stealing thread pool
+ * and of the task groups forking and joining tasks on it.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the pool and task_group classes
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/pool.hpp"
+
+namespace treecode {
+    namespace {
+        /**
+         * @brief The pool the calling thread works for and its queue, if it is a worker.
+         */
+        thread_local const pool* tl_pool = nullptr;
+        thread_local std::size_t tl_index = 0;
+    } // namespace
+
+
+    /**
+     * @brief Constructs a pool.
+     * @param threads The number of worker threads.
+     */
+    pool::pool(
+        std::size_t threads
+    ) {
+        /* one queue per worker and the shared queue */
+        for (std::size_t i = 0; i <= threads; ++i) this->__queues.emplace_back(std::make_unique<queue>());
+        this->__workers.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) this->__workers.emplace_back(&pool::__work, this, i);
+    }
+
+
+    /**
+     * @brief Stops and joins the workers.
+     */
+    pool::~pool() {
+        {
+            std::lock_guard<std::mutex> lock(this->__sleep_mutex);
+            this->__stop = true;
+        }
+        this->__wake.notify_all();
+        for (auto& worker : this->__workers) worker.join();
+    }
+
+
+    /**
+     * @brief Gets the process wide pool.
+     * @return The shared pool.
+     */
+    pool& pool::shared() {
+        static pool instance(std::max<std::size_t>(std::thread::hardware_concurrency(), 1U) - 1U);
+        return instance;
+    }
+
+
+    /**
+     * @brief Gets the number of worker threads.
+     * @return The number of workers.
+     */
+    std::size_t pool::size() const { return this->__workers.size(); }
+
+
+    /**
+     * @brief Pushes a task to the queue of the calling thread.
+     * @param task The task.
+     */
+    void pool::__push(
+        std::function<void()> task
+    ) {
+        queue& q = *this->__queues[this->__home()];
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(task));
+        }
+        this->__queued.fetch_add(1, std::memory_order_release);
+        /* taking the sleep mutex orders the push before the wake up check of sleeping workers */
+        { std::lock_guard<std::mutex> lock(this->__sleep_mutex); }
+        this->__wake.notify_one();
+    }
+
+
+    /**
+     * @brief Runs one pending task, from the queue of the calling thread first.
+     * @return True if a task was run, false if all queues were empty.
+     */
+    bool pool::__run_one() {
+        if (this->__queued.load(std::memory_order_acquire) == 0) return false;
+
+        const std::size_t home = this->__home();
+        const std::size_t count = this->__queues.size();
+        std::function<void()> task;
+        for (std::size_t n = 0; n < count && !task; ++n) {
+            const std::size_t i = (home + n) % count;
+            queue& q = *this->__queues[i];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) continue;
+            /* own tasks are taken newest first, stolen tasks oldest first */
+            if (n == 0) {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            } else {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+        }
+        if (!task) return false;
+        this->__queued.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+
+    /**
+     * @brief Gets the queue of the calling thread.
+     * @return The position of the worker queue, or of the shared queue.
+     */
+    std::size_t pool::__home() const {
+        return tl_pool == this ? tl_index : this->__workers.size();
+    }
+
+
+    /**
+     * @brief The loop of a worker thread.
+     * @param index The position of the worker.
+     */
+    void pool::__work(
+        std::size_t index
+    ) {
+        tl_pool = this;
+        tl_index = index;
+        for (;;) {
+            if (this->__run_one()) continue;
+            std::unique_lock<std::mutex> lock(this->__sleep_mutex);
+            this->__wake.wait(lock, [this] { return this->__stop || this->__queued.load(std::memory_order_acquire) > 0; });
+            if (this->__stop) return;
+        }
+    }
+
+
+    /**
+     * @brief Waits for the pending tasks.
+     */
+    task_group::~task_group() {
+        /* exceptions of the tasks are only reported by an explicit wait */
+        try {
+            this->wait();
+        } catch (...) {}
+    }
+
+
+    /**
+     * @brief Runs pending tasks until every task of the group finished.
+     */
+    void task_group::wait() {
+        while (this->__pending.load(std::memory_order_acquire) != 0) {
+            if (!this->__pool.__run_one()) std::this_thread::yield();
+        }
+
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(this->__error_mutex);
+            std::swap(error, this->__error);
+        }
+        if (error) std::rethrow_exception(error);
+    }
+} // namespace treecode
@@ -0,0 +1,402 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file query.cpp
+ * @class query
+ * @brief Implementation file for the query class.
+ * @ingroup Core
+ *
+ * This file contains the compilation of query texts into steps and
+ * predicates, and the serial and parallel selection of matches.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the query class
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/query.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <mutex>
+
+namespace treecode {
+    namespace {
+        /**
+         * @brief Strips the spaces around a text.
+         */
+        std::string_view trim(
+            std::string_view text
+        ) {
+            while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+            while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+            return text;
+        }
+
+
+        /**
+         * @brief Parses a whole text as a number.
+         * @return The number, empty if the text is not entirely a number.
+         */
+        template <typename T>
+        std::optional<T> parse_number(
+            std::string_view text
+        ) {
+            T result{};
+            std::from_chars_result parsed{};
+            if constexpr (std::is_integral_v<T>) {
+                if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+                    parsed = std::from_chars(text.data() + 2, text.data() + text.size(), result, 16);
+                else
+                    parsed = std::from_chars(text.data(), text.data() + text.size(), result, 10);
+            } else {
+                parsed = std::from_chars(text.data(), text.data() + text.size(), result);
+            }
+            if (text.empty() || parsed.ec != std::errc() || parsed.ptr != text.data() + text.size()) return std::nullopt;
+            return result;
+        }
+    } // namespace
+
+
+    /**
+     * @brief Compiles a query.
+     * @param text The query text.
+     * @throws std::invalid_argument if the query is malformed.
+     */
+    query::query(
+        std::string_view text
+    ) : __text(text) {
+        /* split on the separators outside of predicates and quotes */
+        std::size_t begin = 0, depth = 0;
+        char quote = 0;
+        for (std::size_t i = 0; i <= text.size(); ++i) {
+            const char c = i < text.size() ? text[i] : '/';
+            if (quote) {
+                if (i == text.size()) Exception::Throw::Invalid(this->__text, Exception::QUERY_UNTERMINATED);
+                if (c == quote) quote = 0;
+            } else if (depth && (c == '"' || c == '\'')) {
+                quote = c;
+            } else if (c == '[') {
+                ++depth;
+            } else if (c == ']') {
+                if (!depth) Exception::Throw::Invalid(this->__text, Exception::QUERY_INVALID_STEP);
+                --depth;
+            } else if (c == '/' && !depth) {
+                this->__steps.push_back(this->__compile_step(text.substr(begin, i - begin)));
+                begin = i + 1;
+            } else if (i == text.size()) {
+                Exception::Throw::Invalid(this->__text, Exception::QUERY_UNTERMINATED);
+            }
+        }
+
+        /* ** needs a step to apply to, items only end a query */
+        for (std::size_t i = 0; i < this->__steps.size(); ++i) {
+            const bool last = i + 1 == this->__steps.size();
+            if ((this->__steps[i].op == step::kind::descendants && last) || (this->__steps[i].op == step::kind::item && !last))
+                Exception::Throw::Invalid(this->__text, Exception::QUERY_INVALID_STEP);
+        }
+    }
+
+
+    /**
+     * @brief Gets the text the query was compiled from.
+     * @return The query text.
+     */
+    const std::string& query::text() const { return this->__text; }
+
+
+    /**
+     * @brief Selects every match below a group.
+     * @param root The group the query is run from.
+     * @return The matches in pre-order.
+     */
+    std::vector<query::match> query::select(
+        group& root
+    ) const {
+        std::vector<match> matches;
+        /* every group below a non-constant root is non-constant */
+        auto emit = [&matches](const const_match& m) {
+            matches.push_back({const_cast<group*>(m.node), m.item});
+            return true;
+        };
+        this->__run(root, 0, emit);
+        return matches;
+    }
+
+    std::vector<query::const_match> query::select(
+        const group& root
+    ) const {
+        std::vector<const_match> matches;
+        auto emit = [&matches](const const_match& m) {
+            matches.push_back(m);
+            return true;
+        };
+        this->__run(root, 0, emit);
+        return matches;
+    }
+
+
+    /**
+     * @brief Selects every match below a group on a thread pool.
+     * @param root The group the query is run from.
+     * @param options The pool and grain size of the query.
+     * @return The matches in pre-order.
+     */
+    std::vector<query::const_match> query::select(
+        const group& root,
+        const parallel& options
+    ) const {
+        /* a single step has nothing to split */
+        if (this->__steps.size() < 2) return this->select(root);
+
+        /* the groups matched by the first step are the roots of the tasks */
+        std::vector<const group*> heads;
+        if (this->__steps[0].op == step::kind::descendants) {
+            for (const auto& n : walk(root)) heads.push_back(n.node);
+        } else {
+            __children(root, this->__steps[0], [&heads](const group& child) {
+                heads.push_back(&child);
+                return true;
+            });
+        }
+
+        /* each chunk collects its matches, they are put back in order after the join */
+        std::mutex mutex;
+        std::vector<std::pair<std::size_t, std::vector<const_match>>> chunks;
+        {
+            task_group tasks(options.workers ? *options.workers : pool::shared());
+            fork_chunks(tasks, heads.size(), std::max<std::size_t>(options.grain, 1U),
+                [&heads](std::size_t i) { return 1U + heads[i]->children().size(); },
+                [this, &heads, &mutex, &chunks](std::size_t begin, std::size_t end) {
+                    std::vector<const_match> local;
+                    auto emit = [&local](const const_match& m) {
+                        local.push_back(m);
+                        return true;
+                    };
+                    for (std::size_t i = begin; i < end; ++i) this->__run(*heads[i], 1, emit);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    chunks.emplace_back(begin, std::move(local));
+                });
+            tasks.wait();
+        }
+
+        std::sort(chunks.begin(), chunks.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        std::size_t total = 0;
+        for (const auto& chunk : chunks) total += chunk.second.size();
+        std::vector<const_match> matches;
+        matches.reserve(total);
+        for (auto& chunk : chunks) matches.insert(matches.end(), chunk.second.begin(), chunk.second.end());
+        return matches;
+    }
+
+
+    /**
+     * @brief Selects the first match below a group, the search stops there.
+     * @param root The group the query is run from.
+     * @return The first match in pre-order, empty if nothing matches.
+     */
+    std::optional<query::match> query::first(
+        group& root
+    ) const {
+        auto found = this->first(static_cast<const group&>(root));
+        if (!found) return std::nullopt;
+        return match{const_cast<group*>(found->node), found->item};
+    }
+
+    std::optional<query::const_match> query::first(
+        const group& root
+    ) const {
+        std::optional<const_match> found;
+        auto emit = [&found](const const_match& m) {
+            found = m;
+            return false;
+        };
+        this->__run(root, 0, emit);
+        return found;
+    }
+
+
+    /**
+     * @brief Compiles a step.
+     * @param text The text of the step.
+     * @return The compiled step.
+     * @throws std::invalid_argument if the step is malformed.
+     */
+    query::step query::__compile_step(
+        std::string_view text
+    ) const {
+        if (text.empty()) Exception::Throw::Invalid(this->__text, Exception::QUERY_EMPTY_STEP);
+
+        step s{step::kind::child, std::string(), key(), {}, false};
+        if (text == "**") {
+            s.op = step::kind::descendants;
+            return s;
+        }
+
+        const std::size_t open = text.find('[');
+        std::string_view name = text.substr(0, open);
+        /* a step starting with a predicate has no name */
+        if (name.empty()) Exception::Throw::Invalid(this->__text, Exception::QUERY_INVALID_STEP);
+        if (name.front() == '@') {
+            s.op = step::kind::item;
+            name.remove_prefix(1);
+            if (open != std::string_view::npos) Exception::Throw::Invalid(this->__text, Exception::QUERY_INVALID_STEP);
+        } else if (name == "*") {
+            s.op = step::kind::any;
+        }
+        if (name.empty() || (s.op != step::kind::any && name.find('*') != std::string_view::npos))
+            Exception::Throw::Invalid(this->__text, Exception::QUERY_INVALID_STEP);
+        s.name = std::string(name);
+        s.id = key(name);
+
+        /* the brackets are balanced, the split checked them */
+        std::size_t pos = open;
+        while (pos != std::string_view::npos && pos < text.size()) {
+            if (text[pos] != '[') Exception::Throw::Invalid(this->__text, Exception::QUERY_INVALID_STEP);
+            char quote = 0;
+            std::size_t close = pos + 1;
+            for (; close < text.size(); ++close) {
+                if (quote) {
+                    if (text[close] == quote) quote = 0;
+                } else if (text[close] == '"' || text[close] == '\'') {
+                    quote = text[close];
+                } else if (text[close] == ']') {
+                    break;
+                }
+            }
+            s.predicates.push_back(this->__compile_predicate(text.substr(pos + 1, close - pos - 1)));
+            s.indexed = s.indexed || s.predicates.back().op == predicate::kind::index;
+            pos = close + 1;
+        }
+        return s;
+    }
+
+
+    /**
+     * @brief Compiles a predicate.
+     * @param text The text between the brackets.
+     * @return The compiled predicate.
+     * @throws std::invalid_argument if the predicate is malformed.
+     */
+    query::predicate query::__compile_predicate(
+        std::string_view text
+    ) const {
+        text = trim(text);
+        if (text.empty()) Exception::Throw::Invalid(this->__text, Exception::QUERY_INVALID_PREDICATE);
+
+        predicate p{predicate::kind::exists, key(), 0, {}};
+        if (std::all_of(text.begin(), text.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+            auto index = parse_number<std::size_t>(text);
+            if (!index) Exception::Throw::Invalid(this->__text, Exception::QUERY_INVALID_PREDICATE);
+            p.op = predicate::kind::index;
+            p.index = *index;
+            return p;
+        }
+
+        std::string_view name = text;
+        const std::size_t eq = text.find('=');
+        if (eq != std::string_view::npos) {
+            const bool negated = eq > 0 && text[eq - 1] == '!';
+            p.op = negated ? predicate::kind::not_equal : predicate::kind::equal;
+            name = trim(text.substr(0, negated ? eq - 1 : eq));
+
+            std::string_view value = trim(text.substr(eq + 1));
+            if (!value.empty() && (value.front() == '"' || value.front() == '\'')) {
+                if (value.size() < 2 || value.back() != value.front()) Exception::Throw::Invalid(this->__text, Exception::QUERY_INVALID_PREDICATE);
+                value = value.substr(1, value.size() - 2);
+            }
+            p.value.text = std::string(value);
+            p.value.signed_value = parse_number<std::int64_t>(value);
+            p.value.unsigned_value = parse_number<std::uint64_t>(value);
+            p.value.real_value = parse_number<double>(value);
+            if (value == "true" || value == "1") p.value.bool_value = true;
+            else if (value == "false" || value == "0") p.value.bool_value = false;
+        }
+
+        if (name.empty() || name.find_first_of("\"'!") != std::string_view::npos)
+            Exception::Throw::Invalid(this->__text, Exception::QUERY_INVALID_PREDICATE);
+        p.id = key(name);
+        return p;
+    }
+
+
+    /**
+     * @brief Checks if a value equals a literal.
+     * @param view The slot holding the value.
+     * @param value The literal.
+     * @return True if the slot holds a value equal to the literal.
+     */
+    bool query::__equals(
+        const container::item_view& view,
+        const literal& value
+    ) {
+        return dispatch_tag(view.tag(), [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            if constexpr (std::is_void_v<T>) {
+                return false;
+            } else {
+                const T* v = view.template get_if<T>();
+                if (!v) return false;
+                if constexpr (std::is_same_v<T, std::string>) return *v == value.text;
+                else if constexpr (std::is_same_v<T, bool>) return value.bool_value && *v == *value.bool_value;
+                else if constexpr (std::is_floating_point_v<T>) return value.real_value && static_cast<double>(*v) == *value.real_value;
+                else if constexpr (std::is_signed_v<T>) return value.signed_value && static_cast<std::int64_t>(*v) == *value.signed_value;
+                else return value.unsigned_value && static_cast<std::uint64_t>(*v) == *value.unsigned_value;
+            }
+        });
+    }
+
+
+    /**
+     * @brief Checks if a group passes the value predicates of a step.
+     * @param node The candidate group.
+     * @param s The step.
+     * @param counters The counters of the index predicates.
+     * @return True if the group passes every predicate.
+     */
+    bool query::__accept(
+        const group& node,
+        const step& s,
+        std::vector<std::size_t>& counters
+    ) {
+        for (std::size_t i = 0; i < s.predicates.size(); ++i) {
+            const predicate& p = s.predicates[i];
+            if (p.op == predicate::kind::index) {
+                if (counters[i]++ != p.index) return false;
+                continue;
+            }
+            auto view = node.items().find(p.id);
+            if (!view || !view->has_value()) return false;
+            if (p.op == predicate::kind::equal && !__equals(*view, p.value)) return false;
+            if (p.op == predicate::kind::not_equal && __equals(*view, p.value)) return false;
+        }
+        return true;
+    }
+} // namespace treecode
@@ -0,0 +1,188 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file rcu_tree.cpp
+ * @class rcu_tree
+ * @brief Implementation file for the rcu_tree class.
+ * @ingroup Core
+ *
+ * This file contains the implementation of the rcu_tree class, the reader
+ * registration and the grace periods of the writers.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the rcu_tree class
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/rcu_tree.hpp"
+
+#include <thread>
+
+namespace treecode {
+    namespace {
+        /**
+         * @brief The reader slot of the calling thread, threads are dealt round robin over the slots.
+         */
+        std::atomic<std::size_t> next_slot{0};
+        thread_local const std::size_t tl_slot = next_slot.fetch_add(1, std::memory_order_relaxed) % RCU_TREE_SLOTS;
+    } // namespace
+
+
+    /**
+     * @brief Takes over a pinned version from another reader.
+     */
+    rcu_tree::reader::reader(
+        reader&& other
+    ) noexcept : __counter(other.__counter),
+        __published(other.__published) {
+        other.__counter = nullptr;
+    }
+
+
+    /**
+     * @brief Releases the pinned version.
+     */
+    rcu_tree::reader::~reader() {
+        if (this->__counter) this->__counter->fetch_sub(1, std::memory_order_release);
+    }
+
+
+    /**
+     * @brief Publishes an initial root.
+     * @param root The root.
+     */
+    rcu_tree::rcu_tree(
+        std::shared_ptr<const group> root
+    ) {
+        if (!root) Exception::Throw::Invalid("rcu_tree", Exception::NULL_GROUP);
+        this->__current.store(new published{std::move(root), 1});
+    }
+
+
+    /**
+     * @brief Publishes an initial root, taken over by the tree.
+     * @param root The root.
+     */
+    rcu_tree::rcu_tree(
+        group&& root
+    ) : rcu_tree(std::make_shared<const group>(std::move(root))) {}
+
+
+    /**
+     * @brief Releases the current version.
+     */
+    rcu_tree::~rcu_tree() {
+        delete this->__current.load();
+    }
+
+
+    /**
+     * @brief Pins the current version.
+     *        The counter is raised before the root is loaded: a writer replacing that root
+     *        stores its successor later, so its grace period finds the counter raised.
+     * @return The reader.
+     */
+    rcu_tree::reader rcu_tree::read() const {
+        const std::uint64_t parity = this->__epoch.load(std::memory_order_relaxed) & 1U;
+        std::atomic<std::uint64_t>* counter = &this->__slots[tl_slot].readers[parity];
+        counter->fetch_add(1, std::memory_order_seq_cst);
+        return reader(counter, this->__current.load(std::memory_order_seq_cst));
+    }
+
+
+    /**
+     * @brief Gets the number of the current version.
+     * @return The version number.
+     */
+    std::uint64_t rcu_tree::version() const {
+        return this->read().version();
+    }
+
+
+    /**
+     * @brief Replaces the root, then waits until no reader sees the previous one.
+     * @param root The new root.
+     * @return The number of the new version.
+     */
+    std::uint64_t rcu_tree::publish(
+        std::shared_ptr<const group> root
+    ) {
+        if (!root) Exception::Throw::Invalid("rcu_tree", Exception::NULL_GROUP);
+        std::lock_guard<std::mutex> lock(this->__writer);
+        return this->__publish(std::move(root));
+    }
+
+    std::uint64_t rcu_tree::publish(
+        group&& root
+    ) {
+        return this->publish(std::make_shared<const group>(std::move(root)));
+    }
+
+
+    /**
+     * @brief Waits until every reader pinning a version at the call has released it.
+     */
+    void rcu_tree::synchronize() {
+        std::lock_guard<std::mutex> lock(this->__writer);
+        this->__synchronize();
+    }
+
+
+    /**
+     * @brief Swaps in a new root and drops the old one after a grace period.
+     * @param root The new root.
+     * @return The number of the new version.
+     */
+    std::uint64_t rcu_tree::__publish(
+        std::shared_ptr<const group> root
+    ) {
+        const published* old = this->__current.load(std::memory_order_relaxed);
+        const std::uint64_t number = old->number + 1;
+        this->__current.store(new published{std::move(root), number}, std::memory_order_seq_cst);
+        this->__synchronize();
+        /* holders of the old root keep it alive, only the version record goes */
+        delete old;
+        return number;
+    }
+
+
+    /**
+     * @brief Waits for a grace period.
+     *        Each phase sends new readers to the other parity and drains the one it left,
+     *        after both phases every reader registered before the call is gone.
+     */
+    void rcu_tree::__synchronize() {
+        for (int phase = 0; phase < 2; ++phase) {
+            const std::uint64_t parity = this->__epoch.fetch_add(1, std::memory_order_seq_cst) & 1U;
+            for (slot& s : this->__slots) {
+                while (s.readers[parity].load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
+            }
+        }
+    }
+} // namespace treecode
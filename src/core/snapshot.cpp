@@ -0,0 +1,658 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file snapshot.cpp
+ * @class snapshot
+ * @brief Implementation file for the snapshot class.
+ * @ingroup Core
+ *
+ * This file contains the encoding of group trees into snapshot images, the
+ * bounds checked access to the records of an image and the decoding of
+ * images back into group trees.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the snapshot class
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/snapshot.hpp"
+#include "includes/mapped_tree.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
+/**
+ * @brief The magic bytes opening every image
+ */
+#define SNAPSHOT_MAGIC "TCSNAP\0"
+
+/**
+ * @brief The alignment of every record
+ */
+#define SNAPSHOT_ALIGN 8U
+
+namespace treecode {
+    /**
+     * @struct snapshot::__writer
+     * @brief The state of a write.
+     */
+    struct snapshot::__writer {
+        std::ostream& out;
+        std::uint64_t pos = 0;
+        std::uint64_t nodes = 0;
+        /* strings are views into the tree, which is not modified while it is written */
+        std::unordered_map<std::string_view, std::uint32_t> ids;
+        std::vector<std::string_view> strings;
+        /* choice lists written so far, by address */
+        std::unordered_map<const void*, std::uint64_t> choices;
+        /* scratch space reused by every node */
+        std::vector<item_record> items;
+        std::vector<std::uint64_t> children;
+
+        explicit __writer(std::ostream& stream) : out(stream) {}
+
+        void put(const void* data, std::size_t size) {
+            this->out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            this->pos += size;
+        }
+
+        void pad() {
+            static const char zeros[SNAPSHOT_ALIGN] = {};
+            if (this->pos % SNAPSHOT_ALIGN) this->put(zeros, SNAPSHOT_ALIGN - this->pos % SNAPSHOT_ALIGN);
+        }
+
+        std::uint32_t intern(std::string_view text) {
+            auto [it, added] = this->ids.try_emplace(text, static_cast<std::uint32_t>(this->strings.size()));
+            if (added) this->strings.push_back(text);
+            return it->second;
+        }
+
+        template <typename T>
+        std::uint64_t encode(const T& v) {
+            if constexpr (std::is_same_v<T, std::string>) return this->intern(v);
+            else if constexpr (std::is_same_v<T, bool>) return v ? 1U : 0U;
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) return static_cast<std::uint64_t>(static_cast<std::int64_t>(v));
+            else if constexpr (std::is_integral_v<T>) return static_cast<std::uint64_t>(v);
+            else {
+                std::uint64_t payload = 0;
+                std::memcpy(&payload, &v, sizeof(T));
+                return payload;
+            }
+        }
+    };
+
+
+    /**
+     * @typedef choice_cache
+     * The choice lists read so far and their tag, by offset, so items sharing them keep sharing them.
+     */
+    using choice_cache = std::unordered_map<std::uint64_t, std::pair<std::uint8_t, std::shared_ptr<const void>>>;
+
+
+    /**
+     * @struct snapshot::__source
+     * @brief An image read lazily, shared by its pending groups.
+     */
+    struct snapshot::__source {
+        std::shared_ptr<const image> data;
+        /* choice lists are shared across the loads of every group, which may run concurrently */
+        mutable std::mutex mutex;
+        mutable choice_cache choices;
+
+        explicit __source(std::shared_ptr<const image> source) : data(std::move(source)) {}
+    };
+
+
+    /**
+     * @struct snapshot::__reader
+     * @brief The state of a read.
+     */
+    struct snapshot::__reader {
+        const image& data;
+        /* keys are interned once per string read, subtrees only touch a few strings of the image */
+        std::unordered_map<std::uint32_t, key> keys;
+        /* the choice lists of this read, or of the lazily read image guarded by lock */
+        choice_cache own;
+        choice_cache* choices;
+        std::mutex* lock = nullptr;
+
+        explicit __reader(const image& source) : data(source), choices(&this->own) {}
+
+        explicit __reader(const __source& source) : data(*source.data), choices(&source.choices), lock(&source.mutex) {}
+
+        const key& intern(std::uint32_t id) {
+            auto it = this->keys.find(id);
+            if (it == this->keys.end()) it = this->keys.emplace(id, key(this->data.string(id))).first;
+            return it->second;
+        }
+
+        template <typename T>
+        T decode(std::uint64_t payload) const {
+            if constexpr (std::is_same_v<T, std::string>) return std::string(this->data.string(payload));
+            else return this->data.template decode<T>(payload);
+        }
+    };
+
+
+    /**
+     * @brief Checks the header, footer and string table of an image.
+     * @param data The image.
+     * @param size The size of the image in bytes.
+     */
+    snapshot::image::image(
+        const void* data,
+        std::size_t size
+    ) : __data(static_cast<const char*>(data)),
+        __size(size) {
+        if (size < sizeof(header) || std::memcmp(this->__data, SNAPSHOT_MAGIC, sizeof(header::magic)) != 0)
+            Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_BAD_MAGIC);
+        const header head = this->__load<header>(0);
+        if (head.version != VERSION || head.byte_order != ENDIAN_MARK)
+            Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_BAD_VERSION);
+        if (size < sizeof(header) + sizeof(footer)) Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_CORRUPT);
+        this->__footer = this->__load<footer>(size - sizeof(footer));
+
+        /* the string offsets must lie before the footer and the root record before the strings */
+        const std::uint64_t end = size - sizeof(footer);
+        if (this->__footer.strings > end || this->__footer.root >= this->__footer.strings ||
+            this->__footer.string_count >= (end - this->__footer.strings) / sizeof(std::uint64_t))
+            Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_CORRUPT);
+    }
+
+
+    /**
+     * @brief Reads a node record.
+     * @param offset The offset of the record.
+     * @return The record.
+     */
+    snapshot::node_record snapshot::image::node(
+        std::uint64_t offset
+    ) const {
+        const node_record record = this->__load<node_record>(offset);
+        /* the items and child offsets must follow within the records section */
+        const std::uint64_t tail = static_cast<std::uint64_t>(record.item_count) * sizeof(item_record) +
+            static_cast<std::uint64_t>(record.child_count) * sizeof(std::uint64_t);
+        if (offset % SNAPSHOT_ALIGN || record.subtree_begin > offset || offset > this->__footer.strings ||
+            this->__footer.strings - offset < sizeof(node_record) + tail)
+            Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_CORRUPT);
+        return record;
+    }
+
+
+    /**
+     * @brief Reads an item record of a node.
+     * @param node The offset of the node record.
+     * @param count The item count of the node.
+     * @param pos The position of the item.
+     * @return The record.
+     */
+    snapshot::item_record snapshot::image::item(
+        std::uint64_t node,
+        std::uint32_t count,
+        std::uint32_t pos
+    ) const {
+        if (pos >= count) Exception::Throw::Range("snapshot", Exception::SNAPSHOT_OUT_OF_RANGE);
+        const item_record record = this->__load<item_record>(node + sizeof(node_record) + pos * sizeof(item_record));
+        if (record.tag < static_cast<std::uint8_t>(type_tag::boolean) || record.tag > static_cast<std::uint8_t>(type_tag::string))
+            Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_CORRUPT);
+        if ((record.flags & ITEM_CHOICES) && (record.choice_count == 0 ||
+            record.choices > node || (node - record.choices) / sizeof(std::uint64_t) < record.choice_count))
+            Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_CORRUPT);
+        return record;
+    }
+
+
+    /**
+     * @brief Reads a child offset of a node.
+     * @param node The offset of the node record.
+     * @param record The node record.
+     * @param pos The position of the child.
+     * @return The offset of the child record.
+     */
+    std::uint64_t snapshot::image::child(
+        std::uint64_t node,
+        const node_record& record,
+        std::uint32_t pos
+    ) const {
+        if (pos >= record.child_count) Exception::Throw::Range("snapshot", Exception::SNAPSHOT_OUT_OF_RANGE);
+        const std::uint64_t offset = this->__load<std::uint64_t>(
+            node + sizeof(node_record) + record.item_count * sizeof(item_record) + pos * sizeof(std::uint64_t));
+        /* children precede their parent within its subtree, which also rules out cycles */
+        if (offset < record.subtree_begin || offset >= node) Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_CORRUPT);
+        return offset;
+    }
+
+
+    /**
+     * @brief Reads the payload of a choice.
+     * @param record The item record.
+     * @param pos The position of the choice.
+     * @return The payload.
+     */
+    std::uint64_t snapshot::image::choice(
+        const item_record& record,
+        std::uint32_t pos
+    ) const {
+        if (!(record.flags & ITEM_CHOICES) || pos >= record.choice_count)
+            Exception::Throw::Range("snapshot", Exception::SNAPSHOT_OUT_OF_RANGE);
+        return this->__load<std::uint64_t>(record.choices + pos * sizeof(std::uint64_t));
+    }
+
+
+    /**
+     * @brief Gets a string of the string table.
+     * @param id The string index.
+     * @return A view into the image.
+     */
+    std::string_view snapshot::image::string(
+        std::uint64_t id
+    ) const {
+        if (id >= this->__footer.string_count) Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_CORRUPT);
+        const std::uint64_t table = this->__footer.strings;
+        const std::uint64_t begin = this->__load<std::uint64_t>(table + id * sizeof(std::uint64_t));
+        const std::uint64_t end = this->__load<std::uint64_t>(table + (id + 1) * sizeof(std::uint64_t));
+        /* string offsets are relative to the text following the offset table */
+        const std::uint64_t text = table + (this->__footer.string_count + 1) * sizeof(std::uint64_t);
+        if (begin > end || end > this->__size - sizeof(footer) - text) Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_CORRUPT);
+        return std::string_view(this->__data + text + begin, end - begin);
+    }
+
+
+    /**
+     * @brief Writes a tree to a stream.
+     * @param root The root group.
+     * @param out The binary stream.
+     */
+    void snapshot::write(
+        const group& root,
+        std::ostream& out
+    ) {
+        __writer state(out);
+        header head{};
+        std::memcpy(head.magic, SNAPSHOT_MAGIC, sizeof(head.magic));
+        head.version = VERSION;
+        head.byte_order = ENDIAN_MARK;
+        state.put(&head, sizeof(head));
+
+        footer foot{};
+        foot.root = __write(root, state);
+        foot.node_count = state.nodes;
+
+        /* the string table: the end offset of every string after a leading zero, then the text */
+        foot.strings = state.pos;
+        foot.string_count = state.strings.size();
+        std::uint64_t end = 0;
+        state.put(&end, sizeof(end));
+        for (std::string_view text : state.strings) {
+            end += text.size();
+            state.put(&end, sizeof(end));
+        }
+        for (std::string_view text : state.strings) state.put(text.data(), text.size());
+        state.pad();
+        state.put(&foot, sizeof(foot));
+
+        if (!out) Exception::Throw::Runtime("snapshot", Exception::FILE_WRITE_ERROR);
+    }
+
+
+    /**
+     * @brief Writes a tree to a file.
+     * @param root The root group.
+     * @param path The path of the file.
+     */
+    void snapshot::write(
+        const group& root,
+        const std::string& path
+    ) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) Exception::Throw::Runtime(path, Exception::FILE_OPEN_ERROR);
+        write(root, out);
+        out.close();
+        if (!out) Exception::Throw::Runtime(path, Exception::FILE_WRITE_ERROR);
+    }
+
+
+    /**
+     * @brief Reads a tree from an image in memory.
+     * @param data The image.
+     * @param size The size of the image in bytes.
+     * @param resource The memory resource of the tree.
+     * @return The root group.
+     */
+    group snapshot::read(
+        const void* data,
+        std::size_t size,
+        std::pmr::memory_resource* resource
+    ) {
+        const image source(data, size);
+        return read(source, source.info().root, resource);
+    }
+
+
+    /**
+     * @brief Reads the subtree of a node record of an image.
+     * @param source The image.
+     * @param node The offset of the node record.
+     * @param resource The memory resource of the subtree.
+     * @return The group of the node record.
+     */
+    group snapshot::read(
+        const image& source,
+        std::uint64_t node,
+        std::pmr::memory_resource* resource
+    ) {
+        __reader state(source);
+        group result(std::string(source.string(source.node(node).name)), resource ? resource : std::pmr::get_default_resource());
+        __read(node, result, state);
+        return result;
+    }
+
+
+    /**
+     * @brief Reads a tree from a stream.
+     * @param in The binary stream.
+     * @param resource The memory resource of the tree.
+     * @return The root group.
+     */
+    group snapshot::read(
+        std::istream& in,
+        std::pmr::memory_resource* resource
+    ) {
+        std::string bytes{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+        return read(bytes.data(), bytes.size(), resource);
+    }
+
+
+    /**
+     * @brief Reads a tree from a file.
+     * @param path The path of the file.
+     * @param resource The memory resource of the tree.
+     * @return The root group.
+     */
+    group snapshot::read(
+        const std::string& path,
+        std::pmr::memory_resource* resource
+    ) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) Exception::Throw::Runtime(path, Exception::FILE_OPEN_ERROR);
+        /* read the file in one call into a buffer of its size */
+        std::string bytes(static_cast<std::size_t>(in.tellg()), '\0');
+        in.seekg(0);
+        in.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!in) Exception::Throw::Runtime(path, Exception::FILE_OPEN_ERROR);
+        return read(bytes.data(), bytes.size(), resource);
+    }
+
+
+    /**
+     * @brief Reads a tree lazily from a file.
+     * @param path The path of the file.
+     * @param resource The memory resource of the tree.
+     * @return The root group, pending.
+     */
+    group snapshot::read_lazy(
+        const std::string& path,
+        std::pmr::memory_resource* resource
+    ) {
+        /* the groups share the mapping through the image */
+        auto tree = std::make_shared<const mapped_tree>(path);
+        return __lazy_root(std::shared_ptr<const image>(tree, &tree->image()), resource);
+    }
+
+
+    /**
+     * @brief Reads a tree lazily from a stream.
+     * @param in The binary stream.
+     * @param resource The memory resource of the tree.
+     * @return The root group, pending.
+     */
+    group snapshot::read_lazy(
+        std::istream& in,
+        std::pmr::memory_resource* resource
+    ) {
+        /* the groups share the bytes through the image */
+        struct buffer {
+            std::string bytes;
+            image source;
+            explicit buffer(std::string&& data) : bytes(std::move(data)), source(this->bytes.data(), this->bytes.size()) {}
+        };
+        auto held = std::make_shared<const buffer>(std::string{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()});
+        return __lazy_root(std::shared_ptr<const image>(held, &held->source), resource);
+    }
+
+
+    /**
+     * @brief Writes the records of a subtree, children first.
+     * @param node The root of the subtree.
+     * @param out The state of the write.
+     * @return The offset of the node record.
+     */
+    std::uint64_t snapshot::__write(
+        const group& node,
+        __writer& out
+    ) {
+        node.__load();
+        node_record record{};
+        record.subtree_begin = out.pos;
+        const std::uint64_t first = out.nodes;
+
+        /* the children, their offsets are kept on the shared stack until the node is written */
+        const std::size_t base = out.children.size();
+        for (const auto& child : node.__children) {
+            if (child) out.children.push_back(__write(*child, out));
+        }
+
+        /* the item records, choice lists not written yet go before the node */
+        out.items.clear();
+        node.__container.for_each([&out](const container::item_view& view) {
+            item_record item{};
+            item.key = out.intern(view.id().view());
+            item.tag = static_cast<std::uint8_t>(view.tag());
+            item.flags = static_cast<std::uint8_t>((view.is_required() ? ITEM_REQUIRED : 0U) | (view.is_inline() ? ITEM_INLINE : 0U));
+            dispatch_tag(view.tag(), [&](auto t) {
+                using T = typename decltype(t)::type;
+                if constexpr (std::is_void_v<T>) {
+                    Exception::Throw::Invalid(view.id().str(), Exception::SNAPSHOT_USER_TYPE);
+                } else {
+                    if (const T* value = view.get_if<T>()) {
+                        item.flags |= ITEM_VALUE;
+                        item.value = out.encode(*value);
+                    }
+                    /* the tag of an item slot is the tag of its item<T> */
+                    const std::vector<T>* list = view.is_inline() ? nullptr : static_cast<const treecode::item<T>*>(view.ptr().get())->choices_ptr();
+                    if (list) {
+                        auto [it, added] = out.choices.try_emplace(list, out.pos);
+                        if (added) {
+                            for (const T& choice : *list) {
+                                const std::uint64_t payload = out.encode(choice);
+                                out.put(&payload, sizeof(payload));
+                            }
+                        }
+                        item.flags |= ITEM_CHOICES;
+                        item.choice_count = static_cast<std::uint32_t>(list->size());
+                        item.choices = it->second;
+                    }
+                }
+            });
+            out.items.push_back(item);
+        });
+
+        const std::uint64_t offset = out.pos;
+        record.name = out.intern(node.__name);
+        record.item_count = static_cast<std::uint32_t>(out.items.size());
+        record.child_count = static_cast<std::uint32_t>(out.children.size() - base);
+        record.subtree_nodes = out.nodes - first + 1U;
+        out.put(&record, sizeof(record));
+        out.put(out.items.data(), out.items.size() * sizeof(item_record));
+        out.put(out.children.data() + base, record.child_count * sizeof(std::uint64_t));
+        out.children.resize(base);
+        ++out.nodes;
+        return offset;
+    }
+
+
+    /**
+     * @brief Reads the items and the subtree of a node record into an empty group.
+     * @param offset The offset of the node record.
+     * @param dst The group receiving the node.
+     * @param in The state of the read.
+     */
+    void snapshot::__read(
+        std::uint64_t offset,
+        group& dst,
+        __reader& in
+    ) {
+        const node_record record = in.data.node(offset);
+        __read_items(offset, record, dst.__container, in);
+
+        /* every child is a fresh group, so the duplicate check of add() is not needed */
+        std::pmr::memory_resource* resource = dst.resource();
+        dst.__children.reserve(record.child_count);
+        for (std::uint32_t i = 0; i < record.child_count; ++i) {
+            const std::uint64_t at = in.data.child(offset, record, i);
+            auto child = make_shared_in<group>(resource, std::string(in.data.string(in.data.node(at).name)), resource);
+            __read(at, *child, in);
+            dst.__attached(dst.__children.emplace_back(std::move(child)));
+        }
+    }
+
+
+    /**
+     * @brief Reads the item records of a node record into a container.
+     * @param offset The offset of the node record.
+     * @param record The node record.
+     * @param items The container receiving the items.
+     * @param in The state of the read.
+     */
+    void snapshot::__read_items(
+        std::uint64_t offset,
+        const node_record& record,
+        container& items,
+        __reader& in
+    ) {
+        for (std::uint32_t i = 0; i < record.item_count; ++i) {
+            const item_record item = in.data.item(offset, record.item_count, i);
+            const key& id = in.intern(item.key);
+            /* the records of a group hold distinct keys */
+            if (items.exists(id)) Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_CORRUPT);
+            dispatch_tag(static_cast<type_tag>(item.tag), [&](auto t) {
+                using T = typename decltype(t)::type;
+                if constexpr (!std::is_void_v<T>) {
+                    if (item.flags & ITEM_INLINE) {
+                        if (item.flags & ITEM_VALUE) items.add_inline<T>(id, in.decode<T>(item.value));
+                        else items.add_inline<T>(id);
+                        if (item.flags & ITEM_REQUIRED) items.required(id);
+                        return;
+                    }
+
+                    std::shared_ptr<treecode::item<T>> slot;
+                    if (item.flags & ITEM_CHOICES) {
+                        std::unique_lock<std::mutex> guard;
+                        if (in.lock) guard = std::unique_lock<std::mutex>(*in.lock);
+                        auto& [tag, shared] = (*in.choices)[item.choices];
+                        if (shared && tag != item.tag) Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_CORRUPT);
+                        if (!shared) {
+                            tag = item.tag;
+                            std::vector<T> list;
+                            list.reserve(item.choice_count);
+                            for (std::uint32_t c = 0; c < item.choice_count; ++c) list.push_back(in.decode<T>(in.data.choice(item, c)));
+                            shared = std::make_shared<const std::vector<T>>(std::move(list));
+                        }
+                        slot = items.emplace<T>(id, std::static_pointer_cast<const std::vector<T>>(shared));
+                    } else {
+                        slot = items.emplace<T>(id);
+                    }
+                    if (item.flags & ITEM_VALUE) {
+                        const T v(in.decode<T>(item.value));
+                        /* a value is one of the choices of its item */
+                        const std::vector<T>* list = slot->choices_ptr();
+                        if (list && std::find(list->begin(), list->end(), v) == list->end())
+                            Exception::Throw::Runtime("snapshot", Exception::SNAPSHOT_CORRUPT);
+                        slot->value(v);
+                    } else {
+                        slot->clear_value();
+                    }
+                    if ((item.flags & ITEM_REQUIRED) && !slot->is_required()) slot->required();
+                }
+            });
+        }
+    }
+
+
+    /**
+     * @brief Creates the pending root group of an image.
+     * @param source The image.
+     * @param resource The memory resource of the tree.
+     * @return The root group.
+     */
+    group snapshot::__lazy_root(
+        std::shared_ptr<const image> source,
+        std::pmr::memory_resource* resource
+    ) {
+        const std::uint64_t root = source->info().root;
+        group result(std::string(source->string(source->node(root).name)), resource ? resource : std::pmr::get_default_resource());
+        result.__lazy.ptr.store(new group::lazy_node{std::make_shared<const __source>(std::move(source)), root});
+        return result;
+    }
+
+
+    /**
+     * @brief Loads the items of a pending group and creates its children.
+     * @param node The pending group.
+     * @param pending The record of the group.
+     */
+    void snapshot::__load(
+        const group& node,
+        const group::lazy_node& pending
+    ) {
+        const __source& shared = *static_cast<const __source*>(pending.source.get());
+        const image& source = *shared.data;
+        __reader in(shared);
+        try {
+            const node_record record = source.node(pending.offset);
+            __read_items(pending.offset, record, node.__container, in);
+            /* the children only get their name, the name index is built once the group is loaded */
+            std::pmr::memory_resource* resource = node.resource();
+            node.__children.reserve(record.child_count);
+            for (std::uint32_t i = 0; i < record.child_count; ++i) {
+                const std::uint64_t at = source.child(pending.offset, record, i);
+                auto child = make_shared_in<group>(resource, std::string(source.string(source.node(at).name)), resource);
+                child->__lazy.ptr.store(new group::lazy_node{pending.source, at});
+                child->__link(&node);
+                node.__children.push_back(std::move(child));
+            }
+        } catch (...) {
+            node.__container = container(node.resource());
+            node.__children.clear();
+            throw;
+        }
+    }
+} // namespace treecode
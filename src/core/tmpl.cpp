@@ -53,6 +53,63 @@ namespace treecode {
     ) : __name(name) {}
 
 
+    /**
+     * @brief Method to add a group to the template.
+     * @param group The group to add.
+     * Adds the specified group to the template.
+     */
+    tmpl::tmpl(
+        const tmpl& other
+    ) {
+        std::shared_lock<std::shared_mutex> lock(other.__mutex);
+        this->__name = other.__name;
+        this->__groups = other.__groups;
+        this->__index = other.__index;
+        this->__plans = other.__plans;
+    }
+
+
+    tmpl::tmpl(
+        tmpl&& other
+    ) {
+        std::unique_lock<std::shared_mutex> lock(other.__mutex);
+        this->__name = std::move(other.__name);
+        this->__groups = std::move(other.__groups);
+        this->__index = std::move(other.__index);
+        this->__plans = std::move(other.__plans);
+    }
+
+
+    tmpl& tmpl::operator=(
+        const tmpl& other
+    ) {
+        if (this == &other) return *this;
+        std::unique_lock<std::shared_mutex> lock(this->__mutex, std::defer_lock);
+        std::shared_lock<std::shared_mutex> other_lock(other.__mutex, std::defer_lock);
+        std::lock(lock, other_lock);
+        this->__name = other.__name;
+        this->__groups = other.__groups;
+        this->__index = other.__index;
+        this->__plans = other.__plans;
+        return *this;
+    }
+
+
+    tmpl& tmpl::operator=(
+        tmpl&& other
+    ) {
+        if (this == &other) return *this;
+        std::unique_lock<std::shared_mutex> lock(this->__mutex, std::defer_lock);
+        std::unique_lock<std::shared_mutex> other_lock(other.__mutex, std::defer_lock);
+        std::lock(lock, other_lock);
+        this->__name = std::move(other.__name);
+        this->__groups = std::move(other.__groups);
+        this->__index = std::move(other.__index);
+        this->__plans = std::move(other.__plans);
+        return *this;
+    }
+
+
     /**
      * @brief Method to add a group to the template.
      * @param group The group to add.
@@ -61,19 +118,25 @@ namespace treecode {
     void tmpl::add(
         const std::shared_ptr<group>& grp
     ) {
-        /* add the group to the list of groups */
-        if (grp) this->__groups.emplace_back(grp);
-        else Exception::Throw::Invalid(this->__name, Exception::NULL_GROUP);
+        if (!grp) Exception::Throw::Invalid(this->__name, Exception::NULL_GROUP);
+        std::unique_lock<std::shared_mutex> lock(this->__mutex);
+        /* add the group to the list of groups, the first group of a name wins the lookups */
+        this->__index.emplace(grp->name(), this->__groups.size());
+        this->__groups.emplace_back(grp);
+        this->__plans.emplace_back();
     }
 
 
     void tmpl::add(
         const group& grp
     ) {
-        std::shared_ptr<group> group_ptr = std::make_shared<group>(grp);
-        /* add the group to the list of groups */
-        if (group_ptr) this->__groups.emplace_back(group_ptr);
-        else Exception::Throw::Invalid(this->__name, Exception::NULL_GROUP);
+        this->add(std::make_shared<group>(grp));
+    }
+
+    void tmpl::add(
+        group&& grp
+    ) {
+        this->add(std::make_shared<group>(std::move(grp)));
     }
 
 
@@ -91,21 +154,28 @@ namespace treecode {
     const std::vector<std::shared_ptr<group>>& tmpl::groups() const { return this->__groups; }
 
 
+    /**
+     * @brief Method to check if the template has a group.
+     * @param name The name of the group.
+     * @return True if a group of the template has the name.
+     */
+    bool tmpl::has(
+        const std::string& name
+    ) const {
+        return this->__index.count(name) != 0;
+    }
+
+
     /**
      * @brief Method to create an instance of the template.
+     *        Every group of the template is instantiated as a child of the instance.
      * @return The created instance of the template.
      */
     group tmpl::clone() const {
-        auto instance = std::make_shared<group>(group(this->__name));
-        /* add the groups to the instance */
-        for (const auto& grp : this->__groups) {
-            /* clone the group instance and add it to the instance */
-            if (grp) {
-                
-                grp->add(__clone_group(instance));
-            } else Exception::Throw::Invalid(this->__name, Exception::NULL_GROUP);
-        }
-        return *instance;
+        group instance(this->__name);
+        for (std::size_t pos = 0; pos < this->__groups.size(); ++pos)
+            instance.add(std::make_shared<group>(__instantiate(*this->__plan(pos), std::pmr::get_default_resource(), clone_mode::deep)));
+        return instance;
     }
 
 
@@ -117,51 +187,286 @@ namespace treecode {
     group tmpl::clone(
         const std::string& name
     ) const {
-        /* find the group in the template */
-        auto it = std::find_if(this->__groups.begin(), this->__groups.end(), [&name](
-            const std::shared_ptr<group>& grp
-        ) {
-            /* return the group if found */
-            return grp->name() == name;
-        });
-
-
-        /* create an instance of the group if found */
-        if (it != this->__groups.end())  {
-            return __clone_group(*it);
+        return this->clone(name, nullptr);
+    }
+
+
+    /**
+     * @brief Method to create an instance of a specific group within the template
+     *        allocated from a memory resource.
+     * @param groupName The name of the group to create an instance of.
+     * @param resource The memory resource of the instance.
+     * @return The created instance of the group.
+     */
+    group tmpl::clone(
+        const std::string& name,
+        std::pmr::memory_resource* resource
+    ) const {
+        return this->clone(name, clone_mode::deep, resource);
+    }
+
+
+    /**
+     * @brief Method to create an instance of a specific group within the template
+     *        with the given clone mode.
+     * @param name The name of the group to create an instance of.
+     * @param mode The clone mode of the items.
+     * @param resource The memory resource of the instance.
+     * @return The created instance of the group.
+     */
+    group tmpl::clone(
+        const std::string& name,
+        clone_mode mode,
+        std::pmr::memory_resource* resource
+    ) const {
+        /* create an instance of the group, throws if the group is not found */
+        return __instantiate(*this->__plan(name), resource ? resource : std::pmr::get_default_resource(), mode);
+    }
+
+
+    /**
+     * @brief Method to create an instance of a specific group within the template on a thread pool.
+     * @param name The name of the group to create an instance of.
+     * @param options The pool and grain size of the instantiation.
+     * @param mode The clone mode of the items.
+     * @return The created instance of the group.
+     */
+    group tmpl::clone(
+        const std::string& name,
+        const parallel& options,
+        clone_mode mode
+    ) const {
+        const auto p = this->__plan(name);
+        group instance(p->name);
+        task_group tasks(options.workers ? *options.workers : pool::shared());
+        __instantiate_into(*p, instance, mode, &tasks, std::max<std::size_t>(options.grain, 1U));
+        /* the instance is complete once every forked subtree is */
+        tasks.wait();
+        return instance;
+    }
+
+
+    /**
+     * @brief Method to create a shared instance of a specific group within the template.
+     * @param name The name of the group to create an instance of.
+     * @param mode The clone mode of the items.
+     * @param resource The memory resource of the instance.
+     * @return A shared pointer to the created instance.
+     */
+    std::shared_ptr<group> tmpl::clone_ptr(
+        const std::string& name,
+        clone_mode mode,
+        std::pmr::memory_resource* resource
+    ) const {
+        const auto p = this->__plan(name);
+        if (!resource) resource = std::pmr::get_default_resource();
+        /* the instance is built in its node, as the children of an instance are */
+        auto node = make_shared_in<group>(resource, p->name, resource);
+        __instantiate_into(*p, *node, mode, nullptr, 0);
+        return node;
+    }
+
+
+    /**
+     * @brief Method to create many instances of a specific group within the template.
+     * @param name The name of the group to create instances of.
+     * @param count The number of instances.
+     * @param mode The clone mode of the items.
+     * @param resource The memory resource of the instances.
+     * @return The created instances.
+     */
+    std::vector<std::shared_ptr<group>> tmpl::clone_n(
+        const std::string& name,
+        std::size_t count,
+        clone_mode mode,
+        std::pmr::memory_resource* resource
+    ) const {
+        auto block = this->__instantiate_n(name, count, mode, resource);
+        std::vector<std::shared_ptr<group>> instances;
+        instances.reserve(count);
+        /* every instance shares the ownership of the block */
+        for (auto& instance : *block) instances.emplace_back(block, &instance);
+        return instances;
+    }
+
+
+    /**
+     * @brief Method to create many instances of a specific group within the template
+     *        and attach them as children of a group.
+     * @param name The name of the group to create instances of.
+     * @param count The number of instances.
+     * @param target The group receiving the instances as children.
+     * @param mode The clone mode of the items.
+     */
+    void tmpl::clone_n(
+        const std::string& name,
+        std::size_t count,
+        group& target,
+        clone_mode mode
+    ) const {
+        auto block = this->__instantiate_n(name, count, mode, target.resource());
+        /* fresh instances cannot be children of the target yet, the duplicate check is skipped */
+        target.__load();
+        target.__children.reserve(target.__children.size() + count);
+        for (auto& instance : *block) target.__attached(target.__children.emplace_back(block, &instance));
+    }
+
+
+    /**
+     * @brief Drops the compiled clone plans.
+     */
+    void tmpl::invalidate() {
+        std::unique_lock<std::shared_mutex> lock(this->__mutex);
+        for (auto& p : this->__plans) p.reset();
+    }
+
+
+    /**
+     * @brief Gets the plan of a group, compiling it on first use and after a change.
+     * @param pos The position of the group.
+     * @return The plan of the group.
+     */
+    std::shared_ptr<const tmpl::plan> tmpl::__plan(
+        std::size_t pos
+    ) const {
+        /* compiling caches the hash of the subtree, so the first write after it moves the version,
+           even a write the content hash cannot see, such as an edit of an item of a user type */
+        const std::uint64_t v = this->__groups[pos]->__hash.version.load(std::memory_order_acquire);
+        {
+            std::shared_lock<std::shared_mutex> lock(this->__mutex);
+            const auto& p = this->__plans[pos];
+            if (p && p->version == v) return p;
         }
-        /* throw an exception if the group was not found */
-        else {
-            return group();
+
+        std::unique_lock<std::shared_mutex> lock(this->__mutex);
+        /* another thread may have compiled the group in the meantime */
+        auto& p = this->__plans[pos];
+        if (!p || p->version != v) p = __compile(*this->__groups[pos]);
+        return p;
+    }
+
+
+    /**
+     * @brief Gets the plan of a group by name, compiling it on first use.
+     * @param name The name of the group.
+     * @return The plan of the group.
+     */
+    std::shared_ptr<const tmpl::plan> tmpl::__plan(
+        const std::string& name
+    ) const {
+        /* find the group in the template, throw an exception if the group was not found */
+        auto it = this->__index.find(name);
+        if (it == this->__index.end()) {
             Exception::Throw::Invalid(name, Exception::TEMPLATE_GROUP_NOT_FOUND);
+            return nullptr;
         }
-        
+        return this->__plan(it->second);
     }
 
 
     /**
-     * @brief Helper method to create an instance of a group.
-     * @param groupIns The group instance to clone.
-     * @return The cloned group instance.
+     * @brief Compiles a group and its children into a plan.
+     * @param grp The group to compile.
+     * @return The plan of the group.
      */
-    group tmpl::__clone_group(
-        const std::shared_ptr<group>& grp
-    ) const {
-        /* create a new group instance */
-        auto group_instance = std::make_shared<group>(grp->name());
-        for (const auto& item : grp->items().keys()) {
-            /* get the item from the group instance */
-            auto itemPtr = grp->items().get(item);
-            /* add the item to the group instance */
-            if (itemPtr) group_instance->items().add(item, itemPtr->clone());
-            else Exception::Throw::Invalid(item, "Exception::NULL_ELEMENT");
+    std::shared_ptr<const tmpl::plan> tmpl::__compile(
+        const group& grp
+    ) {
+        auto p = std::make_shared<plan>();
+        p->name = grp.name();
+        /* the version is read first, a write racing the compilation leaves the plan stale;
+           the cached hashes make the next write below the group move its version */
+        p->version = grp.__hash.version.load(std::memory_order_acquire);
+        (void)grp.hash();
+        /* the prototype is compacted, so instances copy its slots and index as is */
+        p->items = grp.items().clone(nullptr);
+        p->children.reserve(grp.children().size());
+        for (const auto& child : grp.children()) {
+            if (!child) continue;
+            p->children.emplace_back(__compile(*child));
+            p->nodes += p->children.back()->nodes;
+        }
+        return p;
+    }
+
+
+    /**
+     * @brief Creates a group from a plan.
+     * @param p The plan to instantiate.
+     * @param resource The memory resource of the instance.
+     * @param mode The clone mode of the items.
+     * @return The created group.
+     */
+    group tmpl::__instantiate(
+        const plan& p,
+        std::pmr::memory_resource* resource,
+        clone_mode mode
+    ) {
+        group instance(p.name, resource);
+        __instantiate_into(p, instance, mode, nullptr, 0);
+        return instance;
+    }
+
+
+    /**
+     * @brief Fills an empty group from a plan.
+     * @param p The plan to instantiate.
+     * @param instance The group receiving the items and children.
+     * @param mode The clone mode of the items.
+     * @param tasks The task group forking child subtrees, null for a serial instantiation.
+     * @param grain The minimum number of groups instantiated by a forked task.
+     */
+    void tmpl::__instantiate_into(
+        const plan& p,
+        group& instance,
+        clone_mode mode,
+        task_group* tasks,
+        std::size_t grain
+    ) {
+        std::pmr::memory_resource* resource = instance.resource();
+        instance.items() = p.items.clone(resource, mode);
+        /* the child slots are sized up front, so tasks only write their own slots */
+        instance.__children.resize(p.children.size());
+
+        auto body = [&p, &instance, resource, mode, tasks, grain](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const plan& child = *p.children[i];
+                auto node = make_shared_in<group>(resource, child.name, resource);
+                __instantiate_into(child, *node, mode, tasks, grain);
+                node->__link(&instance);
+                instance.__children[i] = std::move(node);
+            }
+        };
+
+        if (!tasks || p.nodes <= grain) {
+            body(0, p.children.size());
+            return;
         }
-        /* add the child groups to the group instance */
-        auto children = group_instance->children();
-        /* return the group instance if no children */
-        if (children.empty()) return *group_instance;
-        /* add the children to the group instance */
-        for (const auto& child : children) group_instance->add(__clone_group(child));
-        return *group_instance;
-    }
-} // namespace treecode
\ No newline at end of file
+        fork_chunks(*tasks, p.children.size(), grain, [&p](std::size_t i) { return p.children[i]->nodes; }, body);
+    }
+
+
+    /**
+     * @brief Creates a block of instances of a group.
+     * @param name The name of the group.
+     * @param count The number of instances.
+     * @param mode The clone mode of the items.
+     * @param resource The memory resource of the block and the instances.
+     * @return The block of instances.
+     */
+    std::shared_ptr<std::pmr::vector<group>> tmpl::__instantiate_n(
+        const std::string& name,
+        std::size_t count,
+        clone_mode mode,
+        std::pmr::memory_resource* resource
+    ) const {
+        /* the group is resolved and compiled once for the whole block, throws if the group is not found */
+        const auto p = this->__plan(name);
+        if (!resource) resource = std::pmr::get_default_resource();
+        /* the vector takes the resource by uses-allocator construction */
+        auto block = make_shared_in<std::pmr::vector<group>>(resource);
+        block->reserve(count);
+        for (std::size_t i = 0; i < count; ++i) block->emplace_back(__instantiate(*p, resource, mode));
+        return block;
+    }
+} // namespace treecode
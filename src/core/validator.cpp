@@ -0,0 +1,344 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * This project is a C++ library for managing hierarchical data
+ * structures. It includes classes for containers, items, groups, templates,
+ * and logging. The library can be built as a shared library and includes options
+ * for building tests and examples.
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file validator.cpp
+ * @class validator
+ * @brief Implementation file for the validator class.
+ * @ingroup Core
+ *
+ * This file contains the implementation of the validator class: the item
+ * checks against the prototype of a plan, the walk matching groups to plans
+ * and forking subtrees on a pool, and the ordering of the diagnostics.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the validator class
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/validator.hpp"
+
+#include <mutex>
+
+namespace treecode {
+    namespace {
+        /**
+         * @brief Gets the size of a subtree as seen from its root, 1 if it cannot be loaded.
+         */
+        std::size_t weight(
+            const group& g
+        ) noexcept {
+            try {
+                return 1U + g.children().size();
+            } catch (...) {
+                return 1U;
+            }
+        }
+    }
+
+
+    /**
+     * @struct validator::batch
+     * @brief The findings of one task.
+     */
+    struct validator::batch {
+        std::vector<diagnostic> found;
+        std::size_t groups = 0;
+
+        void report(
+            issue kind,
+            const std::vector<std::size_t>& where,
+            std::string key
+        ) {
+            this->found.push_back(diagnostic{kind, where, std::string(), std::move(key)});
+        }
+    };
+
+
+    /**
+     * @struct validator::session
+     * @brief The state of a run shared by its tasks.
+     */
+    struct validator::session {
+        task_group* tasks;
+        std::size_t grain;
+        std::unordered_map<std::string, std::shared_ptr<const tmpl::plan>> plans;    /* by template group name */
+        std::mutex mutex;
+        batch merged;
+
+        void merge(
+            batch& b
+        ) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->merged.groups += b.groups;
+            for (auto& d : b.found) this->merged.found.push_back(std::move(d));
+        }
+    };
+
+
+    /**
+     * @brief Keeps the template whose plans the runs check against.
+     * @param source The template.
+     */
+    validator::validator(
+        const tmpl& source
+    ) : __source(&source) {}
+
+
+    /**
+     * @brief Checks a tree on the calling thread.
+     * @param root The tree.
+     * @return The diagnostics and the number of checked groups.
+     */
+    validation validator::run(
+        const group& root
+    ) const {
+        return this->__run(root, nullptr, 0);
+    }
+
+
+    /**
+     * @brief Checks a tree on a thread pool.
+     * @param root The tree.
+     * @param options The pool and grain size of the subtree tasks.
+     * @return The diagnostics and the number of checked groups.
+     */
+    validation validator::run(
+        const group& root,
+        const parallel& options
+    ) const {
+        task_group tasks(options.workers ? *options.workers : pool::shared());
+        return this->__run(root, &tasks, std::max<std::size_t>(options.grain, 1U));
+    }
+
+
+    /**
+     * @brief Runs the checks of a tree, forking subtrees on tasks when given.
+     * @param root The tree.
+     * @param tasks The task group forking subtrees, null for a serial run.
+     * @param grain The minimum number of groups checked by a forked task.
+     * @return The diagnostics and the number of checked groups.
+     */
+    validation validator::__run(
+        const group& root,
+        task_group* tasks,
+        std::size_t grain
+    ) const {
+        session state{tasks, grain, {}, {}, {}};
+        /* the plans are looked up once per run, tmpl::__plan compiles the groups changed since the last one */
+        state.plans.reserve(this->__source->__index.size());
+        for (const auto& named : this->__source->__index) state.plans.emplace(named.first, this->__source->__plan(named.second));
+        batch out;
+        std::vector<std::size_t> where;
+        this->__check(root, __match(root.name(), nullptr, state), where, state, out);
+        /* the findings are complete once every forked subtree is */
+        if (tasks) tasks->wait();
+        state.merge(out);
+
+        validation result;
+        result.groups = state.merged.groups;
+        result.diagnostics = std::move(state.merged.found);
+        /* tasks report in any order, positions sort the findings in pre-order and keep the order within a group */
+        std::stable_sort(result.diagnostics.begin(), result.diagnostics.end(), [](const diagnostic& a, const diagnostic& b) {
+            return a.position < b.position;
+        });
+
+        /* the paths are only spelled out for the groups with findings */
+        for (auto& d : result.diagnostics) {
+            const group* g = &root;
+            for (const std::size_t pos : d.position) {
+                const auto& siblings = g->children();
+                const group* child = siblings[pos].get();
+                /* the n-th child of its name, as a query step counts it */
+                std::size_t nth = 0;
+                for (std::size_t i = 0; i < pos; ++i) if (siblings[i] && siblings[i]->name() == child->name()) ++nth;
+                if (!d.path.empty()) d.path += '/';
+                d.path += child->name() + "[" + std::to_string(nth) + "]";
+                g = child;
+            }
+        }
+        return result;
+    }
+
+
+    /**
+     * @brief Checks a group against its plan, if any, and visits its children.
+     * @param g The group.
+     * @param p The plan of the group, null for a group outside of any checked group.
+     * @param where The positions leading to the group.
+     * @param state The state of the run.
+     * @param out The findings of the current task.
+     */
+    void validator::__check(
+        const group& g,
+        const tmpl::plan* p,
+        std::vector<std::size_t>& where,
+        session& state,
+        batch& out
+    ) const {
+        child_range children;
+        try {
+            /* a group read lazily is loaded here, a corrupt record is a finding */
+            const container& items = g.items();
+            children = g.children();
+            if (p) {
+                ++out.groups;
+                __items(items, *p, where, out);
+            }
+        } catch (const std::exception&) {
+            out.report(issue::unreadable, where, g.__name);
+            return;
+        }
+
+        if (p) {
+            for (std::size_t j = 0; j < p->children.size(); ++j) {
+                /* a name of the template group is reported once */
+                const std::string& name = p->children[j]->name;
+                bool first = true;
+                for (std::size_t k = 0; k < j && first; ++k) first = p->children[k]->name != name;
+                if (first && !g.child(name)) out.report(issue::missing_group, where, name);
+            }
+        }
+
+        auto range = [this, children, p, &state](std::size_t begin, std::size_t end, std::vector<std::size_t>& at, batch& into) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const auto& child = children[i];
+                if (!child) continue;
+                const tmpl::plan* match = __match(child->__name, p, state);
+                at.push_back(i);
+                if (!match && p) into.report(issue::unexpected_group, at, child->__name);
+                this->__check(*child, match, at, state, into);
+                at.pop_back();
+            }
+        };
+
+        const std::size_t count = children.size();
+        if (!state.tasks) {
+            range(0, count, where, out);
+            return;
+        }
+        /* chunks of at least grain groups are forked as with fork_chunks, the last one stays in this batch */
+        std::size_t begin = 0;
+        std::size_t load = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& child = children[i];
+            load += child ? weight(*child) : 1U;
+            if (load < state.grain) continue;
+            state.tasks->run([range, begin, end = i + 1, at = where, &state]() mutable {
+                batch local;
+                range(begin, end, at, local);
+                state.merge(local);
+            });
+            begin = i + 1;
+            load = 0;
+        }
+        range(begin, count, where, out);
+    }
+
+
+    /**
+     * @brief Checks the items of a group against the prototype of its plan.
+     * @param items The items of the group.
+     * @param p The plan of the group.
+     * @param where The positions leading to the group.
+     * @param out The findings of the current task.
+     */
+    void validator::__items(
+        const container& items,
+        const tmpl::plan& p,
+        const std::vector<std::size_t>& where,
+        batch& out
+    ) {
+        /* instances copy the slots of the compacted prototype in order, a slot at the same
+           position with the same key is the match, others are looked up */
+        const auto& slots = items.__entries;
+        std::size_t matched = 0;
+        std::size_t pos = 0;
+        for (const auto& t : p.items.__entries) {
+            const std::size_t at = pos++;
+            const container::entry* v = at < slots.size() && slots[at].live && slots[at].id == t.id ? &slots[at] : nullptr;
+            if (!v) {
+                const std::size_t found = items.__find(t.id);
+                if (found == container::npos) {
+                    out.report(issue::missing_item, where, t.id.str());
+                    continue;
+                }
+                v = &slots[found];
+            }
+            ++matched;
+            if (v->tag != t.tag) {
+                out.report(issue::wrong_type, where, t.id.str());
+                continue;
+            }
+            const bool set = v->is_inline ? v->val.has_value() : v->ptr && v->ptr->is_value_set();
+            if (!set) {
+                const bool required = t.is_inline ? t.required : t.ptr && t.ptr->is_required();
+                if (required || (v->is_inline ? v->required : v->ptr && v->ptr->is_required())) out.report(issue::required_unset, where, t.id.str());
+                continue;
+            }
+            /* only item slots carry choices, a slot without any is checked against the template slot */
+            if (v->is_inline && t.is_inline) continue;
+            const bool allowed = dispatch_tag(v->tag, [v, &t](auto tag) {
+                using T = typename decltype(tag)::type;
+                if constexpr (std::is_void_v<T>) {
+                    return true;
+                } else {
+                    /* the tag of an item slot is the tag of its item<T> */
+                    const T* value = v->is_inline ? v->val.get_if<T>() : static_cast<const item<T>*>(v->ptr.get())->value_ptr();
+                    const std::vector<T>* list = v->is_inline ? nullptr : static_cast<const item<T>*>(v->ptr.get())->choices_ptr();
+                    if (!list && !t.is_inline) list = static_cast<const item<T>*>(t.ptr.get())->choices_ptr();
+                    return !list || std::find(list->begin(), list->end(), *value) != list->end();
+                }
+            });
+            if (!allowed) out.report(issue::invalid_choice, where, t.id.str());
+        }
+        /* every item of the group was matched, none can be unexpected */
+        if (matched == items.size()) return;
+        items.for_each([&](const container::item_view& v) {
+            if (!p.items.find(v.id())) out.report(issue::unexpected_item, where, v.id().str());
+        });
+    }
+
+
+    /**
+     * @brief Finds the plan of a child, by the children of the parent plan then by the template.
+     * @param name The name of the child.
+     * @param parent The plan of the parent, null for a parent outside of any checked group.
+     * @param state The state of the run, holding the plans of the template.
+     * @return The plan, null if no template group has the name.
+     */
+    const tmpl::plan* validator::__match(
+        const std::string& name,
+        const tmpl::plan* parent,
+        const session& state
+    ) {
+        if (parent) for (const auto& c : parent->children) if (c->name == name) return c.get();
+        auto it = state.plans.find(name);
+        return it != state.plans.end() ? it->second.get() : nullptr;
+    }
+} // namespace treecode
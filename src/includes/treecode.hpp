@@ -42,11 +42,32 @@
  * @brief Include necessary headers
  */
 #include "../core/includes/common.hpp"
+#include "../core/includes/key.hpp"
+#include "../core/includes/value.hpp"
+#include "../core/includes/arena.hpp"
+#include "../core/includes/pool.hpp"
 #include "../core/includes/container.hpp"
 #include "../core/includes/item.hpp"
 #include "../core/includes/group.hpp"
 #include "../core/includes/tmpl.hpp"
+#include "../core/includes/traversal.hpp"
+#include "../core/includes/parallel.hpp"
+#include "../core/includes/query.hpp"
+#include "../core/includes/snapshot.hpp"
+#include "../core/includes/mapped_tree.hpp"
+#include "../core/includes/json.hpp"
+#include "../core/includes/rcu_tree.hpp"
+#include "../core/includes/persistent_group.hpp"
+#include "../core/includes/delta.hpp"
+#include "../core/includes/interner.hpp"
+#include "../core/includes/validator.hpp"
 #include "../core/includes/exception.hpp"
 #include "../core/includes/base.hpp"
 
+/**
+ * @namespace tc
+ * @brief Short alias of the treecode namespace.
+ */
+namespace tc = treecode;
+
 #endif // TREECODE_HPP
\ No newline at end of file
@@ -0,0 +1,126 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file check.cpp
+ * @brief Implementation file for the unit test harness.
+ * @ingroup Tests
+ *
+ * This file contains the registry and the runner of the unit test harness,
+ * including the main function of the test executables.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the unit test harness
+ */
+
+/**
+ * @brief Include necessary headers
+ */
+#include "includes/check.hpp"
+
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+namespace {
+    /**
+     * @struct test_case
+     * @brief A registered test case.
+     */
+    struct test_case {
+        const char* suite;
+        const char* name;
+        void (*fn)();
+    };
+
+    /* the registry is built before main, function local to avoid static order issues */
+    std::vector<test_case>& registry() {
+        static std::vector<test_case> cases;
+        return cases;
+    }
+
+    /* the number of failed checks of the running test case */
+    int g_failures = 0;
+} // namespace
+
+namespace check {
+    /**
+     * @brief Registers a test case, called by the TEST macro before main.
+     * @param suite The name of the test suite.
+     * @param name The name of the test case.
+     * @param fn The body of the test case.
+     * @return Always true.
+     */
+    bool add(
+        const char* suite,
+        const char* name,
+        void (*fn)()
+    ) {
+        registry().push_back({suite, name, fn});
+        return true;
+    }
+
+
+    /**
+     * @brief Records a failed check of the running test case.
+     * @param file The source file of the check.
+     * @param line The source line of the check.
+     * @param what The description of the failure.
+     */
+    void fail(
+        const char* file,
+        int line,
+        const std::string& what
+    ) {
+        ++g_failures;
+        std::cerr << file << ":" << line << ": " << what << "\n";
+    }
+} // namespace check
+
+
+/**
+ * @brief Runs the registered test cases, or those whose "suite.name" contains argv[1].
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : "";
+    int failed = 0, run = 0;
+    for (const auto& t : registry()) {
+        const std::string id = std::string(t.suite) + "." + t.name;
+        if (std::strstr(id.c_str(), filter) == nullptr) continue;
+        ++run;
+        g_failures = 0;
+        try {
+            t.fn();
+        } catch (const check::fatal&) {
+            /* the failure is already reported */
+        } catch (const std::exception& e) {
+            check::fail(t.suite, 0, std::string("unexpected exception: ") + e.what());
+        } catch (...) {
+            check::fail(t.suite, 0, "unexpected exception");
+        }
+        std::cout << (g_failures ? "[  FAILED  ] " : "[       OK ] ") << id << std::endl;
+        if (g_failures) ++failed;
+    }
+    std::cout << run - failed << "/" << run << " test cases passed" << std::endl;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    using treecode::group;
+    using treecode::index_kind;
+
+    /* a group of n children, each holding its position as an item ID and an inline SLOT */
+    group make_parent(int n) {
+        group parent("PARENT");
+        for (int i = 0; i < n; ++i) {
+            auto child = parent.emplace_child("CHILD");
+            child->items().add<int>("ID", i);
+            child->items().add_inline<int>("SLOT", i % 3);
+        }
+        return parent;
+    }
+
+    /* the ID items of the children found, in any order */
+    std::vector<int> ids(std::vector<std::shared_ptr<group>> found) {
+        std::vector<int> values;
+        for (const auto& c : found) values.push_back(*c->items().value<int>("ID"));
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+} // namespace
+
+
+TEST(ChildIndex, LookupsFollowTheChildren) {
+    group parent = make_parent(12);
+    EXPECT_TRUE(parent.find_child("ID", 4) == parent.children()[4]);
+    parent.add_index("ID");
+    parent.add_index("SLOT", index_kind::ordered);
+    EXPECT_TRUE(parent.find_child("ID", 4) == parent.children()[4]);
+    EXPECT_EQ(ids(parent.find_children("SLOT", 2)), (std::vector<int>{2, 5, 8, 11}));
+    EXPECT_EQ(ids(parent.find_children("SLOT", 1, 2)).size(), 8U);
+
+    /* values set through the container, through the item and by removing the slot */
+    parent.children()[4]->items().value<int>("ID", 40);
+    parent.children()[5]->items().get<int>("ID")->value(50);
+    parent.children()[2]->items().value<int>("SLOT", 0);
+    parent.children()[8]->items().remove("SLOT");
+    EXPECT_TRUE(parent.find_child("ID", 4) == nullptr);
+    EXPECT_TRUE(parent.find_child("ID", 40) == parent.children()[4]);
+    EXPECT_TRUE(parent.find_child("ID", 50) == parent.children()[5]);
+    EXPECT_EQ(ids(parent.find_children("SLOT", 2)), (std::vector<int>{11, 50}));
+
+    /* children added and removed through the group */
+    const auto removed = parent.children()[11];
+    parent.remove(removed);
+    auto added = parent.emplace_child("CHILD");
+    added->items().add<int>("ID", 99);
+    EXPECT_TRUE(parent.find_child("ID", 11) == nullptr);
+    EXPECT_TRUE(parent.find_child("ID", 99) == added);
+    removed->items().value<int>("ID", 99);
+    EXPECT_EQ(parent.find_children("ID", 99).size(), 1U);
+
+    /* a key without an index is scanned, a dropped index falls back to the scan */
+    EXPECT_TRUE(parent.drop_index("ID"));
+    EXPECT_FALSE(parent.drop_index("ID"));
+    EXPECT_TRUE(parent.find_child("ID", 40) == parent.children()[4]);
+}
+
+
+TEST(ChildIndex, SharedChildrenAreFollowedByEveryParent) {
+    group a = make_parent(6);
+    group b = a;
+    const auto c = a.children()[1];
+    ASSERT_TRUE(b.children()[1] == c);
+    a.add_index("ID");
+    b.add_index("ID", index_kind::ordered);
+
+    c->items().value<int>("ID", 20);
+    EXPECT_TRUE(a.find_child("ID", 20) == c);
+    EXPECT_TRUE(b.find_child("ID", 20) == c);
+    EXPECT_TRUE(a.find_child("ID", 1) == nullptr);
+    EXPECT_TRUE(b.find_child("ID", 1) == nullptr);
+
+    c->items().get<int>("ID")->value(30);
+    EXPECT_TRUE(a.find_child("ID", 30) == c);
+    EXPECT_TRUE(b.find_child("ID", 30) == c);
+
+    /* one parent letting go of the child leaves the other one following it */
+    b.remove(c);
+    c->items().value<int>("ID", 40);
+    EXPECT_TRUE(a.find_child("ID", 40) == c);
+    EXPECT_TRUE(b.find_child("ID", 40) == nullptr);
+    {
+        group d = a;
+        d.add_index("ID");
+        d.drop_index("ID");
+        group e = a;
+        e.add_index("ID");
+    }
+    c->items().value<int>("ID", 50);
+    EXPECT_TRUE(a.find_child("ID", 50) == c);
+    EXPECT_TRUE(a.find_child("ID", 40) == nullptr);
+}
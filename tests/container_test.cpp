@@ -0,0 +1,164 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+    using treecode::container;
+
+    std::string name_of(int i) { return "K" + std::to_string(i); }
+
+    /* fills a container with the keys K0..K(n-1), each holding its number */
+    void fill(container& items, int n) {
+        for (int i = 0; i < n; ++i) items.add<int>(name_of(i), i);
+    }
+
+    std::vector<std::string> expected_keys(int n, int step) {
+        std::vector<std::string> keys;
+        for (int i = 0; i < n; ++i) if (i % step != 0) keys.push_back(name_of(i));
+        return keys;
+    }
+} // namespace
+
+
+TEST(Container, SmallAndIndexedLookups) {
+    for (int n : {3, 8, 9, 200}) {
+        container items;
+        fill(items, n);
+        ASSERT_EQ(items.size(), static_cast<std::size_t>(n));
+        for (int i = 0; i < n; ++i) {
+            EXPECT_TRUE(items.exists(name_of(i)));
+            EXPECT_TRUE(items.exists(treecode::key(name_of(i))));
+            EXPECT_EQ(items.value<int>(name_of(i)), i);
+        }
+        EXPECT_FALSE(items.exists("MISSING"));
+        EXPECT_THROW(items.value<int>("MISSING"), std::out_of_range);
+    }
+}
+
+
+TEST(Container, DuplicateKeyIsRejected) {
+    container items;
+    fill(items, 20);
+    EXPECT_THROW(items.add<int>("K5", 0), std::invalid_argument);
+    EXPECT_THROW(items.add_inline<int>("K15", 0), std::invalid_argument);
+    EXPECT_EQ(items.size(), 20U);
+}
+
+
+TEST(Container, EraseKeepsInsertionOrder) {
+    container items;
+    fill(items, 100);
+    for (int i = 0; i < 100; i += 3) EXPECT_TRUE(items.remove(name_of(i)));
+    EXPECT_FALSE(items.remove(name_of(0)));
+    EXPECT_EQ(items.keys(), expected_keys(100, 3));
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(items.exists(name_of(i)), i % 3 != 0);
+}
+
+
+TEST(Container, CompactionKeepsLookupsValid) {
+    container items;
+    fill(items, 64);
+    /* remove most of the keys, so the holes dominate and the table is compacted */
+    for (int i = 0; i < 64; ++i) if (i % 8 != 7) items.remove(name_of(i));
+    ASSERT_EQ(items.size(), 8U);
+    std::vector<std::string> keys;
+    for (int i = 7; i < 64; i += 8) keys.push_back(name_of(i));
+    EXPECT_EQ(items.keys(), keys);
+    for (int i = 7; i < 64; i += 8) EXPECT_EQ(items.value<int>(treecode::key(name_of(i))), i);
+
+    /* the table grows back into the indexed representation */
+    for (int i = 100; i < 140; ++i) items.add_inline<int>(name_of(i), i);
+    EXPECT_EQ(items.size(), 48U);
+    for (int i = 100; i < 140; ++i) EXPECT_EQ(items.value<int>(name_of(i)), i);
+    for (int i = 7; i < 64; i += 8) EXPECT_EQ(items.value<int>(name_of(i)), i);
+}
+
+
+TEST(Container, ReinsertAfterRemove) {
+    container items;
+    fill(items, 30);
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 30; i += 2) items.remove(name_of(i));
+        for (int i = 0; i < 30; i += 2) items.add<int>(name_of(i), i + round);
+        ASSERT_EQ(items.size(), 30U);
+        for (int i = 0; i < 30; i += 2) EXPECT_EQ(items.value<int>(name_of(i)), i + round);
+    }
+    /* re-added keys move to the end of the insertion order */
+    const auto keys = items.keys();
+    EXPECT_EQ(keys.front(), "K1");
+    EXPECT_EQ(keys.back(), "K28");
+}
+
+
+TEST(Container, CloneSkipsHoles) {
+    container items;
+    fill(items, 40);
+    for (int i = 0; i < 40; i += 2) items.remove(name_of(i));
+    container copy = items.clone();
+    EXPECT_EQ(copy.keys(), items.keys());
+    for (int i = 1; i < 40; i += 2) EXPECT_EQ(copy.value<int>(name_of(i)), i);
+    copy.value<int>("K1", -1);
+    EXPECT_EQ(items.value<int>("K1"), 1);
+}
+
+
+namespace {
+    /* counts the slot changes of an observed container */
+    struct counting_observer : treecode::observer {
+        int items = 0;
+        int slots = 0;
+        void changed(const treecode::base&) override { ++this->items; }
+        void changed(const container&, const treecode::key&) override { ++this->slots; }
+    };
+} // namespace
+
+
+TEST(Container, ReadsLeaveInlineSlots) {
+    container items;
+    items.add_inline<int>("LIMIT", 7);
+    items.add_inline<std::string>("NAME", std::string("a"));
+    counting_observer watcher;
+    items.observe(&watcher);
+
+    /* find, view and value<T> read the slots in place */
+    const container& view = items;
+    EXPECT_EQ(*view.find("LIMIT")->get_if<int>(), 7);
+    EXPECT_TRUE(view.find("LIMIT")->get_if<double>() == nullptr);
+    EXPECT_EQ(view.value<std::string>("NAME"), std::string("a"));
+    EXPECT_TRUE(view.view("LIMIT").is_inline());
+    EXPECT_TRUE(view.view("NAME").is_inline());
+    EXPECT_EQ(watcher.slots, 0);
+
+    /* get materialises the slot once, the constant version as well */
+    const auto limit = view.get<int>("LIMIT");
+    ASSERT_TRUE(limit != nullptr);
+    EXPECT_FALSE(view.view("LIMIT").is_inline());
+    EXPECT_TRUE(items.get<int>("LIMIT") == limit);
+    EXPECT_TRUE(view.get("LIMIT") == limit);
+    EXPECT_EQ(watcher.slots, 1);
+    EXPECT_TRUE(view.get<double>("LIMIT") == nullptr);
+
+    /* writes through the item reach the slot */
+    limit->value(9);
+    EXPECT_EQ(items.value<int>("LIMIT"), 9);
+    EXPECT_TRUE(view.get("NAME")->is_value_set());
+    EXPECT_EQ(watcher.slots, 2);
+}
+
+
+TEST(Container, GetDoesNotExposeTheSlot) {
+    static_assert(std::is_same_v<decltype(std::declval<container&>().get("K")), const std::shared_ptr<treecode::base>&>,
+        "the slot pointer must not be assignable through get");
+    static_assert(std::is_same_v<decltype(std::declval<const container&>().get("K")), const std::shared_ptr<treecode::base>&>,
+        "the slot pointer must not be assignable through the constant get");
+    static_assert(std::is_same_v<decltype(std::declval<const container&>().get<int>("K")), std::shared_ptr<treecode::item<int>>>,
+        "constant get<T> keeps its return type");
+    container items;
+    items.add<int>("K", 1);
+    EXPECT_EQ(items.get("K")->tag(), treecode::type_tag::int32);
+    EXPECT_EQ(items.get<int>("K")->data(), 1);
+}
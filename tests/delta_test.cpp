@@ -0,0 +1,108 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+    using treecode::container;
+    using treecode::group;
+
+    /* compares two trees slot by slot, without the hashes the delta relies on */
+    bool equal_trees(const group& a, const group& b) {
+        if (a.name() != b.name() || a.items().keys() != b.items().keys()) return false;
+        std::vector<treecode::value> va, vb;
+        a.items().for_each([&va](const container::item_view& view) { va.push_back(view.value()); });
+        b.items().for_each([&vb](const container::item_view& view) { vb.push_back(view.value()); });
+        if (va != vb || a.children().size() != b.children().size()) return false;
+        for (std::size_t i = 0; i < a.children().size(); ++i) {
+            if (!equal_trees(*a.children()[i], *b.children()[i])) return false;
+        }
+        return true;
+    }
+
+    group make_leaf(const std::string& name, int size) {
+        group leaf(name);
+        leaf.items().add<std::string>("VALUE", name + "_RO");
+        leaf.items().add_inline<int>("SIZE", size);
+        return leaf;
+    }
+
+    group make_tree() {
+        group root("ROOT");
+        root.items().add<int>("COUNT", 5);
+        for (int i = 0; i < 5; ++i) root.add(make_leaf("LEAF" + std::to_string(i), i));
+        return root;
+    }
+
+    /* ships the delta between two trees through its bytes and replays it on a copy of the source */
+    group round_trip(const group& from, const group& to) {
+        const treecode::delta changes(treecode::diff(from, to).bytes());
+        group replayed = from.deep_copy();
+        treecode::apply(replayed, changes);
+        return replayed;
+    }
+} // namespace
+
+
+TEST(Delta, EqualTreesGiveAnEmptyDelta) {
+    const group a = make_tree();
+    EXPECT_TRUE(treecode::diff(a, a).empty());
+    EXPECT_TRUE(treecode::diff(a, a.deep_copy()).empty());
+    EXPECT_TRUE(treecode::diff(a, make_tree()).empty());
+}
+
+
+TEST(Delta, RoundTripOfValueAndItemChanges) {
+    const group from = make_tree();
+    group to = from.deep_copy();
+    to.items().value<int>("COUNT", 6);
+    to.items().add_inline<double>("RATIO", 0.5);
+    to.items().required("COUNT");
+    to.own_child(1)->items().value<std::string>("VALUE", "RW");
+    to.own_child(3)->items().remove("SIZE");
+
+    EXPECT_FALSE(treecode::diff(from, to).empty());
+    const group replayed = round_trip(from, to);
+    EXPECT_TRUE(equal_trees(replayed, to));
+    EXPECT_TRUE(replayed.items().view("COUNT").is_required());
+    EXPECT_EQ(replayed.hash(), to.hash());
+}
+
+
+TEST(Delta, RoundTripOfChildChanges) {
+    const group from = make_tree();
+    group to = from.deep_copy();
+    to.remove(to.children()[0]);
+    to.add(make_leaf("NEW", 9));
+    to.own_child(2)->add(make_leaf("DEEP", 1));
+    EXPECT_TRUE(equal_trees(round_trip(from, to), to));
+
+    /* a child of another name in the middle is replaced, the ends are kept */
+    group renamed = from.deep_copy();
+    renamed.remove(renamed.children()[2]);
+    EXPECT_TRUE(equal_trees(round_trip(from, renamed), renamed));
+    EXPECT_TRUE(equal_trees(round_trip(renamed, from), from));
+}
+
+
+TEST(Delta, CorruptInputIsRejected) {
+    EXPECT_THROW(treecode::delta(std::string()), std::runtime_error);
+    EXPECT_THROW(treecode::delta(std::string("TCDL")), std::runtime_error);
+    EXPECT_THROW(treecode::delta(std::string("XXXX\x01\x00", 6)), std::runtime_error);
+
+    const group from = make_tree();
+    group to = from.deep_copy();
+    to.own_child(4)->items().value<std::string>("VALUE", "RW");
+    const std::string bytes = treecode::diff(from, to).bytes();
+
+    /* every truncation is rejected and leaves no half applied patch unnoticed */
+    for (std::size_t n = 6; n < bytes.size(); ++n) {
+        group target = from.deep_copy();
+        EXPECT_THROW(treecode::apply(target, treecode::delta(bytes.substr(0, n))), std::runtime_error);
+    }
+
+    /* a delta replayed on a tree that is not its source is rejected */
+    group other("ROOT");
+    EXPECT_THROW(treecode::apply(other, treecode::delta(bytes)), std::runtime_error);
+}
@@ -0,0 +1,174 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <memory>
+#include <string>
+
+namespace {
+    using treecode::group;
+
+    /* ROOT > A > B, every group holds an item slot and an inline slot */
+    group make_tree() {
+        group root("ROOT");
+        root.items().add<std::string>("NAME", std::string("root"));
+        root.items().add_inline<int>("N", 0);
+        auto a = root.emplace_child("A");
+        a->items().add<std::string>("NAME", std::string("a"));
+        a->items().add_inline<int>("N", 1);
+        auto b = a->emplace_child("B");
+        b->items().add<std::string>("NAME", std::string("b"));
+        b->items().add_inline<int>("N", 2);
+        return root;
+    }
+
+    /* the cached hash must match the hash of a copy computed from scratch */
+    bool fresh(const group& g) { return g.hash() == g.deep_copy().hash(); }
+} // namespace
+
+
+TEST(GroupHash, EqualContentHasEqualHash) {
+    const group x = make_tree();
+    const group y = make_tree();
+    EXPECT_EQ(x.hash(), y.hash());
+    EXPECT_NE(x.hash(), group("ROOT").hash());
+}
+
+
+TEST(GroupHash, HeldItemPointerInvalidates) {
+    group root = make_tree();
+    auto b = root.children()[0]->children()[0];
+    const auto name = b->items().get<std::string>("NAME");
+    const auto before = root.hash();
+    name->value("changed");
+    EXPECT_NE(root.hash(), before);
+    EXPECT_TRUE(fresh(root));
+
+    const auto again = root.hash();
+    name->clear_value();
+    EXPECT_NE(root.hash(), again);
+    EXPECT_TRUE(fresh(root));
+
+    const auto required = root.hash();
+    name->required();
+    EXPECT_NE(root.hash(), required);
+    EXPECT_TRUE(fresh(root));
+}
+
+
+TEST(GroupHash, MaterialisedItemInvalidates) {
+    group root = make_tree();
+    auto a = root.children()[0];
+    /* the inline slot turns into an item owned by the container */
+    const auto n = a->items().get<int>("N");
+    const auto before = root.hash();
+    n->value(41);
+    EXPECT_NE(root.hash(), before);
+    EXPECT_TRUE(fresh(root));
+}
+
+
+TEST(GroupHash, KeptContainerReferenceInvalidates) {
+    group root = make_tree();
+    treecode::container& items = root.children()[0]->items();
+    auto before = root.hash();
+    items.value<int>("N", 7);
+    EXPECT_NE(root.hash(), before);
+    EXPECT_TRUE(fresh(root));
+
+    before = root.hash();
+    items.required("N");
+    EXPECT_NE(root.hash(), before);
+    EXPECT_TRUE(fresh(root));
+
+    before = root.hash();
+    items.add_inline<bool>("FLAG", true);
+    EXPECT_NE(root.hash(), before);
+    EXPECT_TRUE(fresh(root));
+
+    before = root.hash();
+    items.remove("FLAG");
+    EXPECT_NE(root.hash(), before);
+    EXPECT_TRUE(fresh(root));
+
+    before = root.hash();
+    items = treecode::container();
+    EXPECT_NE(root.hash(), before);
+    EXPECT_TRUE(fresh(root));
+}
+
+
+TEST(GroupHash, ItemsLeavingTheTreeNoLongerInvalidate) {
+    group root = make_tree();
+    auto a = root.children()[0];
+    const auto name = a->items().get<std::string>("NAME");
+    a->items().remove("NAME");
+    const auto before = root.hash();
+    name->value("gone");
+    EXPECT_EQ(root.hash(), before);
+
+    /* an item outliving its group is released, writing it is harmless */
+    std::shared_ptr<treecode::item<std::string>> kept;
+    {
+        group scratch("S");
+        kept = scratch.items().add<std::string>("K", std::string("k"));
+    }
+    kept->value("after");
+    EXPECT_EQ(kept->data(), std::string("after"));
+}
+
+
+TEST(GroupHash, MovedGroupsKeepTracking) {
+    group source = make_tree();
+    const auto name = source.items().get<std::string>("NAME");
+    group moved(std::move(source));
+    const auto before = moved.hash();
+    name->value("moved");
+    EXPECT_NE(moved.hash(), before);
+    EXPECT_TRUE(fresh(moved));
+
+    group assigned("X");
+    assigned = std::move(moved);
+    const auto again = assigned.hash();
+    name->value("assigned");
+    EXPECT_NE(assigned.hash(), again);
+    EXPECT_TRUE(fresh(assigned));
+}
+
+
+TEST(GroupHash, CopiesShareTheirItems) {
+    group original = make_tree();
+    auto copy = std::make_unique<group>(original);
+    const auto before = original.hash();
+    EXPECT_EQ(copy->hash(), before);
+    EXPECT_TRUE(copy->items().get<std::string>("NAME") == original.items().get<std::string>("NAME"));
+
+    /* a write through either copy is seen by both */
+    copy->items().get<std::string>("NAME")->value("copy");
+    EXPECT_EQ(original.items().value<std::string>("NAME"), std::string("copy"));
+    EXPECT_NE(original.hash(), before);
+    EXPECT_EQ(copy->hash(), original.hash());
+    EXPECT_TRUE(fresh(original));
+    EXPECT_TRUE(fresh(*copy));
+
+    /* inline slots are values of each copy */
+    const auto shared = original.hash();
+    copy->items().value<int>("N", 5);
+    EXPECT_EQ(original.items().value<int>("N"), 0);
+    EXPECT_EQ(original.hash(), shared);
+    EXPECT_TRUE(fresh(*copy));
+
+    /* the copy gone, the original keeps tracking the item */
+    const auto name = original.items().get<std::string>("NAME");
+    copy.reset();
+    name->value("alone");
+    EXPECT_NE(original.hash(), shared);
+    EXPECT_TRUE(fresh(original));
+
+    /* an item erased from one copy still reaches the other */
+    group other = original;
+    other.items().remove("NAME");
+    const auto kept = original.hash();
+    name->value("again");
+    EXPECT_NE(original.hash(), kept);
+    EXPECT_TRUE(fresh(original));
+}
@@ -0,0 +1,166 @@
+/**
+ * +--------------------------------------------------------------------------+
+ *  _____ ____  _____ _____ ____ ___  ____  _____
+ * |_   _|  _ \| ____| ____/ ___/ _ \|  _ \| ____|
+ *   | | | |_) |  _| |  _|| |  | | | | | | |  _|
+ *   | | |  _ <| |___| |__| |__| |_| | |_| | |___
+ *   |_| |_| \_|_____|_____\____\___/|____/|_____|
+ *
+ * Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+ * SPDX-License-Identifier: MIT
+ * TREECODE - Copyright (c) - Amr MOUSA 2025-2026
+ *
+ * Version 0.0.1
+ *
+ * +--------------------------------------------------------------------------+
+ *
+ * @file check.hpp
+ * @brief Header file for the unit test harness.
+ * @ingroup Tests
+ *
+ * This file contains the small unit test harness of the library tests:
+ * self-registering test cases, non-fatal EXPECT_* and fatal ASSERT_* checks,
+ * and a runner reporting the failed checks. Each test file is linked into its
+ * own executable, registered with CTest.
+ *
+ * @version 0.0.1
+ * @author Amr MOUSA
+ * @copyright Copyright (c) - Amr MOUSA 2025
+ * @date October 16, 2026
+ *
+ * File History:
+ * - Version 0.0.1:
+ *      - Initial Implementation of the unit test harness
+ */
+#ifndef CHECK_HARNESS_H
+#define CHECK_HARNESS_H
+
+/**
+ * @brief Include necessary headers
+ */
+#include <optional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace check {
+    /**
+     * @brief Registers a test case, called by the TEST macro before main.
+     * @param suite The name of the test suite.
+     * @param name The name of the test case.
+     * @param fn The body of the test case.
+     * @return Always true.
+     */
+    bool add(
+        const char* suite,
+        const char* name,
+        void (*fn)()
+    );
+
+
+    /**
+     * @brief Records a failed check of the running test case.
+     * @param file The source file of the check.
+     * @param line The source line of the check.
+     * @param what The description of the failure.
+     */
+    void fail(
+        const char* file,
+        int line,
+        const std::string& what
+    );
+
+
+    /**
+     * @struct fatal
+     * @brief Thrown by a failed ASSERT_* check to end the running test case.
+     */
+    struct fatal {};
+
+
+    /**
+     * @struct printable
+     * @brief True if a value of the type can be written to a std::ostream.
+     */
+    template <typename T, typename = void>
+    struct printable : std::false_type {};
+
+    template <typename T>
+    struct printable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>> : std::true_type {};
+
+
+    /**
+     * @brief Formats a value for a failure message, values that cannot be printed are shown as '?'.
+     * @param value The value.
+     * @return The printed value.
+     */
+    template <typename T>
+    std::string show(const T& value) {
+        if constexpr (printable<T>::value) {
+            std::ostringstream out;
+            out << value;
+            return out.str();
+        } else {
+            return "?";
+        }
+    }
+
+    template <typename T>
+    std::string show(const std::optional<T>& value) { return value ? show(*value) : "nullopt"; }
+
+    inline std::string show(std::nullopt_t) { return "nullopt"; }
+} // namespace check
+
+
+/**
+ * @brief Defines and registers a test case.
+ */
+#define TEST(suite, name) \
+    static void suite##_##name(); \
+    static const bool suite##_##name##_registered = check::add(#suite, #name, &suite##_##name); \
+    static void suite##_##name()
+
+
+/* non-fatal checks, the test case goes on after a failure */
+#define EXPECT_TRUE(cond) \
+    do { if (!(cond)) check::fail(__FILE__, __LINE__, "expected true: " #cond); } while (0)
+
+#define EXPECT_FALSE(cond) \
+    do { if (cond) check::fail(__FILE__, __LINE__, "expected false: " #cond); } while (0)
+
+#define EXPECT_EQ(a, b) \
+    do { \
+        const auto& check_a = (a); const auto& check_b = (b); \
+        if (!(check_a == check_b)) check::fail(__FILE__, __LINE__, "expected " #a " == " #b " (" + check::show(check_a) + " vs " + check::show(check_b) + ")"); \
+    } while (0)
+
+#define EXPECT_NE(a, b) \
+    do { if ((a) == (b)) check::fail(__FILE__, __LINE__, "expected " #a " != " #b); } while (0)
+
+#define EXPECT_THROW(stmt, exception) \
+    do { \
+        bool check_thrown = false; \
+        try { stmt; } catch (const exception&) { check_thrown = true; } catch (...) {} \
+        if (!check_thrown) check::fail(__FILE__, __LINE__, "expected " #stmt " to throw " #exception); \
+    } while (0)
+
+#define EXPECT_NO_THROW(stmt) \
+    do { \
+        try { stmt; } catch (...) { check::fail(__FILE__, __LINE__, "expected " #stmt " not to throw"); } \
+    } while (0)
+
+/* fatal checks, the test case ends after a failure */
+#define ASSERT_TRUE(cond) \
+    do { if (!(cond)) { check::fail(__FILE__, __LINE__, "expected true: " #cond); throw check::fatal(); } } while (0)
+
+#define ASSERT_EQ(a, b) \
+    do { \
+        const auto& check_a = (a); const auto& check_b = (b); \
+        if (!(check_a == check_b)) { \
+            check::fail(__FILE__, __LINE__, "expected " #a " == " #b " (" + check::show(check_a) + " vs " + check::show(check_b) + ")"); \
+            throw check::fatal(); \
+        } \
+    } while (0)
+
+#endif // CHECK_HARNESS_H
@@ -0,0 +1,94 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <memory>
+#include <string>
+
+namespace {
+    using treecode::group;
+    using treecode::interner;
+
+    /* a LEAF group holding an item slot and an inline slot */
+    group make_leaf(const std::string& value) {
+        group leaf("LEAF");
+        leaf.items().add<std::string>("VALUE", value);
+        leaf.items().add_inline<int>("SIZE", 2);
+        return leaf;
+    }
+
+    /* a root of n equal LEAF children */
+    group make_tree(std::size_t n) {
+        group root("ROOT");
+        for (std::size_t i = 0; i < n; ++i) root.add(make_leaf("RO"));
+        return root;
+    }
+
+    std::string value_of(const group& g, std::size_t pos) {
+        return g.children()[pos]->items().value<std::string>("VALUE").value_or("");
+    }
+
+    /* turns the process wide interning on for the scope */
+    struct interning {
+        interning() { interner::enable(true); }
+        ~interning() { interner::enable(false); interner::shared().clear(); }
+    };
+} // namespace
+
+
+TEST(Interner, OwnChildIsolatesACopy) {
+    group a = make_tree(3);
+    group b = a;
+    ASSERT_TRUE(a.children()[0] == b.children()[0]);
+
+    /* the child is shared by both copies, own_child gives b its own */
+    const auto child = b.own_child(0);
+    EXPECT_TRUE(child != a.children()[0]);
+    child->items().value<std::string>("VALUE", "RW");
+    child->items().get<std::string>("VALUE")->value("RW2");
+    child->items().value<int>("SIZE", 3);
+    EXPECT_EQ(value_of(b, 0), std::string("RW2"));
+    EXPECT_EQ(value_of(a, 0), std::string("RO"));
+    EXPECT_EQ(a.children()[0]->items().value<int>("SIZE"), 2);
+
+    /* owning an unshared child hands out the child itself */
+    EXPECT_TRUE(b.own_child(0) == child);
+}
+
+
+TEST(Interner, DedupeThenOwnChildIsolatesWrites) {
+    group root = make_tree(4);
+    const treecode::dedupe_stats saved = treecode::dedupe(root);
+    EXPECT_EQ(saved.groups, 3U);
+    ASSERT_TRUE(root.children()[0] == root.children()[3]);
+    const std::uint64_t before = root.children()[1]->hash();
+
+    root.own_child(2)->items().value<std::string>("VALUE", "RW");
+    EXPECT_EQ(value_of(root, 2), std::string("RW"));
+    for (std::size_t i : {0U, 1U, 3U}) EXPECT_EQ(value_of(root, i), std::string("RO"));
+    EXPECT_EQ(root.children()[1]->hash(), before);
+    EXPECT_NE(root.children()[2]->hash(), before);
+}
+
+
+TEST(Interner, AddWhileInterningKeepsNodesOwn) {
+    interning on;
+    group a("A");
+    group b("B");
+    a.add(make_leaf("RO"));
+    b.add(make_leaf("RO"));
+    const group leaf = make_leaf("RO");
+    b.add(leaf);
+
+    /* the nodes are distinct, the equal items are shared and copied on write */
+    ASSERT_TRUE(a.children()[0] != b.children()[0]);
+    ASSERT_TRUE(b.children()[0] != b.children()[1]);
+    EXPECT_TRUE(b.children()[0]->items().view("VALUE").is_shared());
+    EXPECT_TRUE(a.children()[0]->items().view("VALUE").ptr() == b.children()[1]->items().view("VALUE").ptr());
+
+    b.children().back()->items().value<std::string>("VALUE", "RW");
+    b.children()[0]->items().get<std::string>("VALUE")->value("RW2");
+    EXPECT_EQ(value_of(b, 1), std::string("RW"));
+    EXPECT_EQ(value_of(b, 0), std::string("RW2"));
+    EXPECT_EQ(value_of(a, 0), std::string("RO"));
+    EXPECT_EQ(leaf.items().value<std::string>("VALUE"), std::string("RO"));
+}
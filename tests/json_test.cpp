@@ -0,0 +1,238 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    using treecode::container;
+    using treecode::group;
+    using treecode::json;
+    using treecode::tmpl;
+    using treecode::value;
+
+    /* compares two trees slot by slot, the types of the values included */
+    bool equal_trees(const group& a, const group& b) {
+        if (a.name() != b.name() || a.items().keys() != b.items().keys()) return false;
+        std::vector<value> va, vb;
+        a.items().for_each([&va](const container::item_view& view) { va.push_back(view.value()); });
+        b.items().for_each([&vb](const container::item_view& view) { vb.push_back(view.value()); });
+        if (va != vb || a.children().size() != b.children().size()) return false;
+        for (std::size_t i = 0; i < a.children().size(); ++i) {
+            if (!equal_trees(*a.children()[i], *b.children()[i])) return false;
+        }
+        return true;
+    }
+
+    /* a DID group of typed items and choices, holding two ELEMENT children */
+    tmpl make_template() {
+        tmpl t("T");
+        group did("DID");
+        did.items().add<std::string>("ID", std::string("FD00"));
+        did.items().add_inline<std::uint8_t>("SIZE", 1);
+        did.items().add_inline<float>("RATIO", 0.25F);
+        did.items().emplace<std::string>("MODE",
+            std::make_shared<const std::vector<std::string>>(std::vector<std::string>{"RO", "RW"}))->value("RO");
+        for (int i = 0; i < 2; ++i) {
+            group element("ELEMENT");
+            element.items().add<std::string>("NAME", std::string("none"));
+            element.items().add_inline<std::int16_t>("VALUE", static_cast<std::int16_t>(i));
+            did.add(std::move(element));
+        }
+        t.add(std::move(did));
+        return t;
+    }
+
+    group make_tree(const tmpl& t) {
+        group root("ROOT");
+        for (int d = 0; d < 3; ++d) {
+            group did = t.clone("DID");
+            did.items().value<std::string>("ID", "FD0" + std::to_string(d));
+            did.items().value<std::uint8_t>("SIZE", static_cast<std::uint8_t>(200 + d));
+            did.items().value<std::string>("MODE", d % 2 ? "RW" : "RO");
+            did.own_child(1)->items().value<std::string>("NAME", "tab\t\"quoted\" \\ " + std::to_string(d));
+            root.add(std::move(did));
+        }
+        return root;
+    }
+
+    std::string text_of(const group& root, bool pretty = false) {
+        std::ostringstream out;
+        treecode::json_options opts;
+        opts.pretty = pretty;
+        json::write(root, out, opts);
+        return out.str();
+    }
+
+    group read_text(const std::string& text, const tmpl& t) {
+        std::istringstream in(text);
+        return json::read(in, t);
+    }
+
+    /* records the events of a parse, one line per event */
+    class recorder : public json::handler {
+    public:
+        std::vector<std::string> events;
+        std::vector<value> values;
+
+        void begin_group(std::string_view name) override { this->events.push_back("<" + std::string(name)); }
+
+        void item(std::string_view key, const value& v) override {
+            this->events.push_back(std::string(key));
+            this->values.push_back(v);
+        }
+
+        void end_group() override { this->events.push_back(">"); }
+    };
+
+    recorder parse_text(const std::string& text) {
+        recorder events;
+        std::istringstream in(text);
+        json::parse(in, events);
+        return events;
+    }
+} // namespace
+
+
+TEST(Json, RoundTrip) {
+    const tmpl t = make_template();
+    const group root = make_tree(t);
+    for (bool pretty : {false, true}) {
+        const group read = read_text(text_of(root, pretty), t);
+        EXPECT_TRUE(equal_trees(read, root));
+        EXPECT_EQ(read.hash(), root.hash());
+        EXPECT_EQ(text_of(read, pretty), text_of(root, pretty));
+    }
+
+    /* a buffer smaller than one group gives the same text */
+    std::ostringstream out;
+    treecode::json_options opts;
+    opts.buffer = 8;
+    json::write(root, out, opts);
+    EXPECT_EQ(out.str(), text_of(root));
+}
+
+
+TEST(Json, EscapesAndSurrogatePairs) {
+    const auto events = parse_text(
+        R"({"name":"G","items":{"S":"a\"b\\c\/d\b\f\n\r\t","U":"é€😀"}})");
+    EXPECT_EQ(events.events, (std::vector<std::string>{"<G", "S", "U", ">"}));
+    ASSERT_EQ(events.values.size(), 2U);
+    EXPECT_EQ(*events.values[0].get_if<std::string>(), std::string("a\"b\\c/d\b\f\n\r\t"));
+    EXPECT_EQ(*events.values[1].get_if<std::string>(), std::string("\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"));
+
+    /* control characters written as escapes read back as they were */
+    group g("G");
+    g.items().add<std::string>("S", std::string("\x01 line\nend\x1F"));
+    const auto read = parse_text(text_of(g));
+    EXPECT_EQ(*read.values[0].get_if<std::string>(), std::string("\x01 line\nend\x1F"));
+
+    /* lone or reversed surrogates are rejected */
+    for (const char* text : {R"({"name":"G","items":{"U":"\uD83D"}})", R"({"name":"G","items":{"U":"\uDE00\uD83D"}})",
+            R"({"name":"G","items":{"U":"\uD83Dx"}})", R"({"name":"G","items":{"U":"\uD83DA"}})",
+            R"({"name":"G","items":{"U":"\q"}})", R"({"name":"G","items":{"U":"\u12G4"}})"}) {
+        EXPECT_THROW(parse_text(text), std::runtime_error);
+    }
+}
+
+
+TEST(Json, NumbersSplitIntoInt64Uint64AndDouble) {
+    const auto events = parse_text(
+        R"({"name":"G","items":{"A":0,"B":-0,"C":-9223372036854775808,"D":9223372036854775807,)"
+        R"("E":9223372036854775808,"F":18446744073709551615,"G":18446744073709551616,"H":-9223372036854775809,)"
+        R"("I":0.5,"J":-1e3,"K":2E+2,"L":1e-2,"M":true,"N":null}})");
+    const auto& v = events.values;
+    ASSERT_EQ(v.size(), 14U);
+    EXPECT_EQ(v[0], value(std::int64_t(0)));
+    EXPECT_EQ(v[1], value(std::int64_t(0)));
+    EXPECT_EQ(v[2], value(std::numeric_limits<std::int64_t>::min()));
+    EXPECT_EQ(v[3], value(std::numeric_limits<std::int64_t>::max()));
+    EXPECT_EQ(v[4], value(std::uint64_t(9223372036854775808ULL)));
+    EXPECT_EQ(v[5], value(std::numeric_limits<std::uint64_t>::max()));
+    EXPECT_EQ(v[6], value(18446744073709551616.0));
+    EXPECT_EQ(v[7], value(-9223372036854775809.0));
+    EXPECT_EQ(v[8], value(0.5));
+    EXPECT_EQ(v[9], value(-1000.0));
+    EXPECT_EQ(v[10], value(200.0));
+    EXPECT_EQ(v[11], value(0.01));
+    EXPECT_EQ(v[12], value(true));
+    EXPECT_FALSE(v[13].has_value());
+}
+
+
+TEST(Json, MalformedNumbersAreRejected) {
+    for (const char* number : {"", "+1", "01", "-01", "00", "-", ".5", "1.", "1.e2", "1e", "1e+", "--1", "1-", "0x10", "1.5.5", "Infinity"}) {
+        EXPECT_THROW(parse_text(std::string(R"({"name":"G","items":{"x":)") + number + "}}"), std::runtime_error);
+    }
+}
+
+
+TEST(Json, ValuesAreConvertedToTheTemplateTypes) {
+    const tmpl t = make_template();
+    const group did = read_text(R"({"name":"DID","items":{"SIZE":255,"RATIO":2,"ID":"X"}})", t);
+    EXPECT_EQ(did.items().value<std::uint8_t>("SIZE"), std::uint8_t(255));
+    EXPECT_EQ(did.items().value<float>("RATIO"), 2.0F);
+    EXPECT_EQ(did.items().value<std::string>("ID"), std::string("X"));
+    /* a null clears the value, items the template does not know take the type of their value */
+    const group cleared = read_text(R"({"name":"DID","items":{"ID":null,"EXTRA":-2,"BIG":18446744073709551615}})", t);
+    EXPECT_FALSE(cleared.items().value<std::string>("ID").has_value());
+    EXPECT_EQ(cleared.items().value<std::int64_t>("EXTRA"), std::int64_t(-2));
+    EXPECT_EQ(cleared.items().value<std::uint64_t>("BIG"), std::numeric_limits<std::uint64_t>::max());
+
+    /* integers out of the range of the slot type */
+    EXPECT_THROW(read_text(R"({"name":"DID","items":{"SIZE":256}})", t), std::out_of_range);
+    EXPECT_THROW(read_text(R"({"name":"DID","items":{"SIZE":-1}})", t), std::out_of_range);
+    EXPECT_THROW(read_text(R"({"name":"DID","children":[{"name":"ELEMENT","items":{"VALUE":40000}}]})", t), std::out_of_range);
+    EXPECT_THROW(read_text(R"({"name":"DID","children":[{"name":"ELEMENT","items":{"VALUE":-32769}}]})", t), std::out_of_range);
+    EXPECT_THROW(read_text(R"({"name":"DID","items":{"SIZE":18446744073709551615}})", t), std::out_of_range);
+
+    /* values of another kind, fractions for integers and values out of the choices */
+    EXPECT_THROW(read_text(R"({"name":"DID","items":{"SIZE":1.5}})", t), std::invalid_argument);
+    EXPECT_THROW(read_text(R"({"name":"DID","items":{"SIZE":"1"}})", t), std::invalid_argument);
+    EXPECT_THROW(read_text(R"({"name":"DID","items":{"ID":true}})", t), std::invalid_argument);
+    EXPECT_THROW(read_text(R"({"name":"DID","items":{"MODE":"XX"}})", t), std::invalid_argument);
+}
+
+
+TEST(Json, UnknownKeysAreSkipped) {
+    const auto events = parse_text(
+        R"({"name":"G","meta":{"a":[1,{"b":"]}"},null],"c":{}},"items":{"K":1},"list":[[],[[]]],"flag":false,)"
+        R"("children":[{"name":"C","x":"y"}],"tail":-1.5e3})");
+    EXPECT_EQ(events.events, (std::vector<std::string>{"<G", "K", "<C", ">", ">"}));
+
+    /* a group must open with its name */
+    EXPECT_THROW(parse_text(R"({"items":{},"name":"G"})"), std::runtime_error);
+    for (const char* text : {R"({"name":"G","meta":{"a":1]})", R"({"name":"G","meta":[1,]]})", R"({"name":"G","meta":})",
+            R"({"name":"G","items":{"K":1,}})", R"({"name":"G","children":[{"name":"C"},]})", R"({"name":"G")"}) {
+        EXPECT_THROW(parse_text(text), std::runtime_error);
+    }
+}
+
+
+TEST(Json, ChildrenAreMatchedToTheTemplateClones) {
+    const tmpl t = make_template();
+    const group did = read_text(
+        R"({"name":"DID","children":[{"name":"ELEMENT","items":{"NAME":"first"}},{"name":"OTHER"},)"
+        R"({"name":"ELEMENT","items":{"VALUE":7}},{"name":"ELEMENT","items":{"VALUE":9}}]})", t);
+    ASSERT_EQ(did.children().size(), 4U);
+    /* the cloned children take the values of the text in order and keep their types */
+    EXPECT_EQ(did.children()[0]->items().value<std::string>("NAME"), std::string("first"));
+    EXPECT_EQ(did.children()[0]->items().value<std::int16_t>("VALUE"), std::int16_t(0));
+    EXPECT_EQ(did.children()[1]->items().value<std::string>("NAME"), std::string("none"));
+    EXPECT_EQ(did.children()[1]->items().value<std::int16_t>("VALUE"), std::int16_t(7));
+    /* children beyond the clones are added after them, typed by their values */
+    EXPECT_EQ(did.children()[2]->name(), std::string("OTHER"));
+    EXPECT_EQ(did.children()[3]->name(), std::string("ELEMENT"));
+    EXPECT_FALSE(did.children()[3]->items().exists("NAME"));
+    EXPECT_EQ(did.children()[3]->items().value<std::int64_t>("VALUE"), std::int64_t(9));
+
+    /* children missing from the text keep the values of the template */
+    const group bare = read_text(R"({"name":"DID","items":{"ID":"B"}})", t);
+    ASSERT_EQ(bare.children().size(), 2U);
+    EXPECT_EQ(bare.children()[1]->items().value<std::int16_t>("VALUE"), std::int16_t(1));
+}
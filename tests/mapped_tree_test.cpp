@@ -0,0 +1,159 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    using treecode::container;
+    using treecode::group;
+    using treecode::mapped_tree;
+    using treecode::snapshot;
+
+    /* a file in the temporary directory, removed with the object */
+    struct temp_file {
+        std::string path;
+
+        explicit temp_file(const std::string& name)
+            : path((std::filesystem::temp_directory_path() / ("treecode_mapped_tree_" + name + ".tcs")).string()) {}
+
+        ~temp_file() {
+            std::error_code ignored;
+            std::filesystem::remove(this->path, ignored);
+        }
+
+        void write(const std::string& bytes) const {
+            std::ofstream out(this->path, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        }
+    };
+
+    group make_tree() {
+        group root("ROOT");
+        root.items().add<std::string>("TITLE", std::string("catalogue"));
+        root.items().add_inline<bool>("OPEN", true);
+        root.items().required("TITLE");
+        for (int i = 0; i < 12; ++i) {
+            group entry("ENTRY");
+            entry.items().add_inline<std::int32_t>("ID", i);
+            entry.items().add<double>("RATIO", i / 4.0);
+            entry.items().emplace<std::string>("MODE",
+                std::make_shared<const std::vector<std::string>>(std::vector<std::string>{"RO", "RW"}))->value(i % 2 ? "RW" : "RO");
+            entry.items().add<std::uint64_t>("UNSET");
+            if (i % 4 == 0) {
+                group nested("NESTED");
+                nested.items().add_inline<std::int8_t>("DEPTH", static_cast<std::int8_t>(i));
+                entry.add(std::move(nested));
+            }
+            root.add(std::move(entry));
+        }
+        return root;
+    }
+
+    std::string image_of(const group& root) {
+        std::ostringstream out;
+        snapshot::write(root, out);
+        return out.str();
+    }
+
+    /* compares a mapped group with its source slot by slot and counts the nodes */
+    bool matches(const mapped_tree::group_view& view, const group& source, std::uint64_t& nodes) {
+        ++nodes;
+        if (view.name() != source.name() || view.item_count() != source.items().size() ||
+            view.child_count() != source.children().size()) return false;
+        bool same = true;
+        std::size_t pos = 0;
+        source.items().for_each([&](const container::item_view& item) {
+            const mapped_tree::item_view mapped = view.item(pos++);
+            same = same && mapped.id() == item.id().str() && mapped.tag() == item.tag() &&
+                mapped.is_inline() == item.is_inline() && mapped.is_required() == item.is_required() &&
+                mapped.has_value() == item.has_value() && mapped.value() == item.value();
+        });
+        for (std::size_t i = 0; same && i < view.child_count(); ++i) same = matches(view.child(i), *source.children()[i], nodes);
+        return same;
+    }
+
+    /* reads every record reachable from a group */
+    void walk(const mapped_tree::group_view& view) {
+        view.for_each_item([](const mapped_tree::item_view& item) { (void)item.value(); });
+        view.for_each_child([](const mapped_tree::group_view& child) { walk(child); });
+    }
+} // namespace
+
+
+TEST(MappedTree, ViewsMatchTheSourceTree) {
+    const group root = make_tree();
+    const temp_file file("views");
+    snapshot::write(root, file.path);
+
+    const mapped_tree tree(file.path);
+    std::uint64_t nodes = 0;
+    EXPECT_TRUE(matches(tree.root(), root, nodes));
+    EXPECT_EQ(tree.size(), nodes);
+    EXPECT_EQ(tree.root().subtree_size(), nodes);
+
+    /* typed reads decode in place, a type that does not match gives no value */
+    const auto entry = tree.root().child(5);
+    EXPECT_EQ(entry.find("ID")->get<std::int32_t>(), std::int32_t(5));
+    EXPECT_FALSE(entry.find("ID")->get<std::int64_t>().has_value());
+    const auto text = entry.find("MODE")->get<std::string>();
+    EXPECT_EQ(text, std::optional<std::string_view>("RW"));
+    EXPECT_FALSE(entry.find("UNSET")->get<std::uint64_t>().has_value());
+    EXPECT_FALSE(entry.find("MISSING").has_value());
+
+    /* choices are read by position */
+    const auto mode = *entry.find("MODE");
+    ASSERT_EQ(mode.choice_count(), 2U);
+    EXPECT_EQ(mode.choice<std::string>(1), std::optional<std::string_view>("RW"));
+    EXPECT_FALSE(mode.choice<int>(0).has_value());
+    EXPECT_THROW(mode.choice<std::string>(2), std::out_of_range);
+
+    EXPECT_EQ(tree.root().child("ENTRY")->find("ID")->get<std::int32_t>(), std::int32_t(0));
+    EXPECT_FALSE(tree.root().child("NONE").has_value());
+    EXPECT_THROW(tree.root().child(12), std::out_of_range);
+    EXPECT_THROW(tree.root().item(2), std::out_of_range);
+}
+
+
+TEST(MappedTree, MaterialiseGivesTheSourceTree) {
+    const group root = make_tree();
+    const temp_file file("materialise");
+    snapshot::write(root, file.path);
+
+    mapped_tree tree(file.path);
+    EXPECT_EQ(tree.materialise().hash(), root.hash());
+    EXPECT_EQ(tree.root().child(8).materialise().hash(), root.children()[8]->hash());
+
+    /* a moved tree keeps the mapping */
+    const mapped_tree moved(std::move(tree));
+    EXPECT_EQ(snapshot::read_lazy(file.path).hash(), root.hash());
+    EXPECT_EQ(moved.materialise().hash(), root.hash());
+}
+
+
+TEST(MappedTree, EmptyAndTruncatedFilesAreRejected) {
+    const temp_file file("truncated");
+    EXPECT_THROW(mapped_tree{file.path}, std::runtime_error);
+    file.write(std::string());
+    EXPECT_THROW(mapped_tree{file.path}, std::runtime_error);
+    file.write(std::string(256, 'x'));
+    EXPECT_THROW(mapped_tree{file.path}, std::runtime_error);
+
+    const std::string bytes = image_of(make_tree());
+    for (std::size_t n = 1; n < bytes.size(); n += 5) {
+        file.write(bytes.substr(0, n));
+        EXPECT_THROW({
+            const mapped_tree tree(file.path);
+            walk(tree.root());
+            (void)tree.materialise();
+        }, std::runtime_error);
+    }
+}
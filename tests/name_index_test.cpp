@@ -0,0 +1,107 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    using treecode::group;
+
+    const std::vector<std::string> NAMES = {"A", "B", "C", "D"};
+
+    /* a group of n children named A, B, C, D in turn, each holding its position */
+    group make_wide(std::size_t n) {
+        group root("ROOT");
+        for (std::size_t i = 0; i < n; ++i) {
+            group child(NAMES[i % NAMES.size()]);
+            child.items().add_inline<int>("POS", static_cast<int>(i % 3));
+            root.add(std::move(child));
+        }
+        return root;
+    }
+
+    /* checks the name lookups against a scan of the children */
+    bool consistent(group& g) {
+        for (const auto& name : NAMES) {
+            std::vector<std::shared_ptr<group>> scanned;
+            for (const auto& c : g.children()) if (c && c->name() == name) scanned.push_back(c);
+            if (g.children_named(name) != scanned) return false;
+            if (g.child(name) != (scanned.empty() ? nullptr : scanned.front())) return false;
+        }
+        /* children already held are not added again */
+        const std::size_t size = g.children().size();
+        const std::vector<std::shared_ptr<group>> children = g.children();
+        for (const auto& c : children) g.add(c);
+        return g.children().size() == size;
+    }
+} // namespace
+
+
+TEST(NameIndex, DedupeReplacesChildrenInPlace) {
+    group root = make_wide(48);
+    ASSERT_TRUE(root.child("A") != nullptr);
+    const treecode::dedupe_stats saved = treecode::dedupe(root);
+    EXPECT_TRUE(saved.groups > 0U);
+    EXPECT_TRUE(root.children()[0] == root.children()[12]);
+    EXPECT_TRUE(consistent(root));
+}
+
+
+TEST(NameIndex, OwnChildKeepsTheRankOfSharedChildren) {
+    group root = make_wide(48);
+    treecode::dedupe(root);
+    /* owning a child held at several positions replaces one occurrence, at its rank */
+    const auto owned = root.own_child(16);
+    EXPECT_TRUE(owned != root.children()[4]);
+    EXPECT_TRUE(root.children_named("A")[4] == owned);
+    EXPECT_TRUE(consistent(root));
+    owned->items().value<int>("POS", 7);
+    EXPECT_EQ(root.children_named("A")[4]->items().value<int>("POS"), 7);
+}
+
+
+TEST(NameIndex, SplicedChildrenAreIndexedInOrder) {
+    const group from = make_wide(40);
+    group to = from.deep_copy();
+    to.remove(to.children()[5]);
+    to.remove(to.children()[20]);
+    group extra("A");
+    extra.items().add_inline<int>("POS", 9);
+    to.add(std::move(extra));
+
+    /* the delta splices the middle of the children of an indexed group */
+    group target = from.deep_copy();
+    ASSERT_TRUE(target.child("B") != nullptr);
+    treecode::apply(target, treecode::diff(from, to));
+    ASSERT_EQ(target.children().size(), to.children().size());
+    EXPECT_TRUE(consistent(target));
+    EXPECT_EQ(target.children_named("A").back()->items().value<int>("POS"), 9);
+
+    /* a removed child can be added again */
+    const auto first = target.children()[0];
+    target.remove(first);
+    target.add(first);
+    EXPECT_TRUE(target.children().back() == first);
+    EXPECT_TRUE(consistent(target));
+}
+
+
+TEST(NameIndex, LookupsTakeViewsOfTheName) {
+    group root = make_wide(40);
+    const std::string text = "ABCD";
+    /* views that are not terminated after the name */
+    EXPECT_EQ(root.children_named(std::string_view(text).substr(1, 1)).size(), 10U);
+    EXPECT_TRUE(root.child(std::string_view(text).substr(2, 1)) == root.children()[2]);
+    EXPECT_TRUE(root.child(std::string_view(text).substr(0, 2)) == nullptr);
+
+    /* a name whose last child left is dropped, its key does not outlive it */
+    for (const auto& c : root.children_named("D")) root.remove(c);
+    EXPECT_TRUE(root.child("D") == nullptr);
+    root.add(group(std::string(64, 'D')));
+    root.add(group(""));
+    EXPECT_TRUE(root.child(std::string(64, 'D')) == root.children()[30]);
+    EXPECT_TRUE(root.child("") == root.children()[31]);
+    EXPECT_TRUE(consistent(root));
+}
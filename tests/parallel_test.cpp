@@ -0,0 +1,104 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    using treecode::clone_mode;
+    using treecode::group;
+
+    /* a tree of 1 + 16 + 16 * 32 groups, the leaves are shared instances of one template */
+    group make_tree() {
+        treecode::tmpl t("T");
+        group leaf("LEAF");
+        leaf.items().add_inline<int>("ID", 1);
+        leaf.items().add<std::string>("NAME", std::string("leaf"));
+        t.add(std::move(leaf));
+
+        group root("ROOT");
+        root.items().add_inline<int>("ID", 1);
+        for (int i = 0; i < 16; ++i) {
+            auto branch = root.emplace_child("B" + std::to_string(i));
+            branch->items().add_inline<int>("ID", 1);
+            for (int j = 0; j < 32; ++j) branch->add(t.clone("LEAF", clone_mode::shared));
+        }
+        return root;
+    }
+} // namespace
+
+
+TEST(Parallel, ForEachReadsInPlace) {
+    const group root = make_tree();
+    treecode::pool workers(4);
+    treecode::parallel options;
+    options.grain = 8;
+    options.workers = &workers;
+
+    std::atomic<int> visited{0}, ids{0}, names{0};
+    treecode::parallel_for_each(root, [&](const treecode::tree_node<const group>& n) {
+        ++visited;
+        /* inline slots and shared items are read in place */
+        if (const auto id = n.node->items().find("ID")) ids += *id->get_if<int>();
+        if (const auto name = n.node->items().find("NAME")) names += name->get_if<std::string>() != nullptr;
+        (void)n.node->items().value<int>("ID");
+        (void)n.node->hash();
+    }, options);
+
+    EXPECT_EQ(visited.load(), 1 + 16 + 16 * 32);
+    EXPECT_EQ(ids.load(), 1 + 16 + 16 * 32);
+    EXPECT_EQ(names.load(), 16 * 32);
+    /* nothing was materialised or copied by the readers */
+    EXPECT_TRUE(root.items().view("ID").is_inline());
+    EXPECT_TRUE(root.children()[3]->children()[5]->items().view("ID").is_inline());
+    EXPECT_TRUE(root.children()[3]->children()[5]->items().view("NAME").is_shared());
+}
+
+
+TEST(Parallel, ReduceMatchesSerialWalk) {
+    const group root = make_tree();
+    treecode::pool workers(4);
+    treecode::parallel options;
+    options.grain = 8;
+    options.workers = &workers;
+
+    const int total = treecode::parallel_reduce(root, 0,
+        [](const treecode::tree_node<const group>& n) { return n.node->items().get<int>("ID")->data().value_or(0) + static_cast<int>(n.depth); },
+        [](int a, int b) { return a + b; },
+        options);
+
+    int serial = 0;
+    for (const auto& n : treecode::walk(root)) serial += n.node->items().value<int>("ID").value_or(0) + static_cast<int>(n.depth);
+    EXPECT_EQ(total, serial);
+}
+
+
+TEST(Parallel, DeepCopyMatchesSerialCopy) {
+    const group root = make_tree();
+    const group serial = root.deep_copy();
+    treecode::pool workers(4);
+    /* grains below and above the size of the tree, the latter copying it in a single task */
+    for (std::size_t grain : {1U, 8U, 100000U}) {
+        treecode::parallel options;
+        options.grain = grain;
+        options.workers = &workers;
+        group copy = root.deep_copy(options);
+        EXPECT_EQ(copy.hash(), serial.hash());
+
+        std::vector<std::string> names, expected;
+        for (const auto& n : treecode::walk(std::as_const(copy))) names.push_back(n.node->name() + std::to_string(n.depth));
+        for (const auto& n : treecode::walk(serial)) expected.push_back(n.node->name() + std::to_string(n.depth));
+        EXPECT_EQ(names, expected);
+
+        /* nothing is shared with the source, writes to the copy leave it alone */
+        EXPECT_TRUE(copy.children()[2] != root.children()[2]);
+        EXPECT_FALSE(copy.children()[2]->children()[7]->items().view("NAME").is_shared());
+        copy.children()[2]->children()[7]->items().value<std::string>("NAME", "changed");
+        copy.children()[2]->items().value<int>("ID", 5);
+        EXPECT_EQ(root.children()[2]->children()[7]->items().value<std::string>("NAME"), std::string("leaf"));
+        EXPECT_EQ(root.children()[2]->items().value<int>("ID"), 1);
+        EXPECT_EQ(root.hash(), serial.hash());
+    }
+}
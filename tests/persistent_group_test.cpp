@@ -0,0 +1,130 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+    using treecode::container;
+    using treecode::group;
+    using treecode::persistent_group;
+    using treecode::value;
+
+    /* compares two trees slot by slot, flags and choices included */
+    bool equal_trees(const group& a, const group& b) {
+        if (a.name() != b.name() || a.items().keys() != b.items().keys()) return false;
+        std::vector<std::tuple<value, bool, bool>> va, vb;
+        a.items().for_each([&va](const container::item_view& view) { va.emplace_back(view.value(), view.is_required(), view.is_inline()); });
+        b.items().for_each([&vb](const container::item_view& view) { vb.emplace_back(view.value(), view.is_required(), view.is_inline()); });
+        if (va != vb || a.children().size() != b.children().size()) return false;
+        for (std::size_t i = 0; i < a.children().size(); ++i) {
+            if (!equal_trees(*a.children()[i], *b.children()[i])) return false;
+        }
+        return true;
+    }
+
+    /* ROOT holding three DID groups, each with a choice item and an ELEMENT child */
+    group make_tree() {
+        group root("ROOT");
+        root.items().add<std::string>("TITLE", std::string("dids"));
+        root.items().required("TITLE");
+        for (int d = 0; d < 3; ++d) {
+            group did("DID");
+            did.items().add_inline<std::uint16_t>("ID", static_cast<std::uint16_t>(d));
+            did.items().emplace<std::string>("MODE",
+                std::make_shared<const std::vector<std::string>>(std::vector<std::string>{"RO", "RW"}))->value("RO");
+            did.items().add<double>("RATIO");
+            group element("ELEMENT");
+            element.items().add_inline<int>("VALUE", d * 10);
+            did.add(std::move(element));
+            root.add(std::move(did));
+        }
+        return root;
+    }
+} // namespace
+
+
+TEST(PersistentGroup, FreezeThawRoundTrip) {
+    const group root = make_tree();
+    const persistent_group frozen = persistent_group::freeze(root);
+    EXPECT_EQ(frozen.name(), std::string("ROOT"));
+    EXPECT_EQ(frozen.item_count(), 1U);
+    EXPECT_EQ(frozen.child_count(), 3U);
+    EXPECT_TRUE(frozen.find("TITLE")->is_required());
+    EXPECT_FALSE(frozen.child(0).find("RATIO")->has_value());
+    EXPECT_EQ(*frozen.child(2).child(0).find("VALUE")->get_if<int>(), 20);
+    EXPECT_FALSE(frozen.find("MISSING").has_value());
+    EXPECT_FALSE(frozen.child("NONE").has_value());
+    EXPECT_THROW(frozen.child(3), std::out_of_range);
+
+    const group thawed = frozen.thaw();
+    EXPECT_TRUE(equal_trees(thawed, root));
+    EXPECT_EQ(thawed.hash(), root.hash());
+    /* the choices survive the round trip */
+    EXPECT_THROW(thawed.children()[1]->items().value<std::string>("MODE", "XX"), std::invalid_argument);
+
+    /* items of user types cannot be frozen */
+    group custom("CUSTOM");
+    custom.items().add<std::vector<int>>("LIST", std::vector<int>{1, 2});
+    EXPECT_THROW(persistent_group::freeze(custom), std::invalid_argument);
+}
+
+
+TEST(PersistentGroup, WithValueChecksTypesAndChoices) {
+    const persistent_group did = persistent_group::freeze(make_tree()).child(0);
+    const persistent_group rw = did.with_value("MODE", value("RW"));
+    EXPECT_EQ(*rw.find("MODE")->get_if<std::string>(), std::string("RW"));
+    /* the older version is left as it was */
+    EXPECT_EQ(*did.find("MODE")->get_if<std::string>(), std::string("RO"));
+
+    EXPECT_THROW(did.with_value("MODE", value("XX")), std::invalid_argument);
+    EXPECT_THROW(did.with_value("ID", value(1)), std::invalid_argument);
+    EXPECT_THROW(did.with_value("ID", value(1.0)), std::invalid_argument);
+    EXPECT_THROW(did.with_value("MISSING", value(1)), std::out_of_range);
+    EXPECT_NO_THROW(did.with_value("ID", value(std::uint16_t(7))));
+    /* no value clears the item, an equal value gives the same version */
+    EXPECT_FALSE(rw.with_value("MODE", value()).find("MODE")->has_value());
+    EXPECT_TRUE(did.with_value("MODE", value("RO")).identical(did));
+
+    EXPECT_THROW(did.with_item("ID", value(1)), std::invalid_argument);
+    EXPECT_THROW(did.with_item("NEW", value()), std::invalid_argument);
+    EXPECT_TRUE(did.with_item("NEW", value(1), true).find("NEW")->is_required());
+    EXPECT_THROW(did.with_required("MISSING"), std::out_of_range);
+    EXPECT_TRUE(did.with_required("ID", false).identical(did));
+    EXPECT_EQ(did.without_item("ID").item_count(), 2U);
+    EXPECT_TRUE(did.without_item("MISSING").identical(did));
+}
+
+
+TEST(PersistentGroup, UpdateSharesTheUnchangedPaths) {
+    const persistent_group v1 = persistent_group::freeze(make_tree());
+    const persistent_group v2 = v1.update({1, 0}, [](const persistent_group& element) {
+        return element.with_value("VALUE", value(99));
+    });
+    EXPECT_FALSE(v2.identical(v1));
+    EXPECT_EQ(*v2.child(1).child(0).find("VALUE")->get_if<int>(), 99);
+    EXPECT_EQ(*v1.child(1).child(0).find("VALUE")->get_if<int>(), 10);
+
+    /* only the path to the changed child is copied */
+    EXPECT_FALSE(v2.child(1).identical(v1.child(1)));
+    EXPECT_TRUE(v2.child(0).identical(v1.child(0)));
+    EXPECT_TRUE(v2.child(2).identical(v1.child(2)));
+
+    /* identical() compares nodes, not values */
+    const persistent_group same = v1.update({}, [](const persistent_group& g) { return g; });
+    EXPECT_TRUE(same.identical(v1));
+    EXPECT_TRUE(v1.update({1, 0}, [](const persistent_group& g) { return g; }).identical(v1));
+    EXPECT_FALSE(persistent_group::freeze(make_tree()).identical(v1));
+    EXPECT_THROW(v1.update({5}, [](const persistent_group& g) { return g; }), std::out_of_range);
+
+    const persistent_group grown = v1.with_added_child(persistent_group("EXTRA"));
+    EXPECT_EQ(grown.child_count(), 4U);
+    EXPECT_TRUE(grown.child(3).identical(*grown.child("EXTRA")));
+    EXPECT_TRUE(grown.without_child(3).child(0).identical(v1.child(0)));
+    EXPECT_THROW(v1.without_child(3), std::out_of_range);
+    EXPECT_THROW(v1.with_child(3, persistent_group("X")), std::out_of_range);
+}
@@ -0,0 +1,149 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    using treecode::group;
+    using treecode::query;
+
+    /* ROOT with three DID groups, each holding ELEMENT children, the last one nested one level deeper */
+    group make_tree() {
+        group root("ROOT");
+        root.items().add<std::string>("TITLE", std::string("dids"));
+        for (int d = 0; d < 3; ++d) {
+            group did("DID");
+            did.items().add<std::string>("ID", "FD1" + std::to_string(d));
+            did.items().add_inline<std::uint16_t>("MASK", static_cast<std::uint16_t>(0x10 * (d + 1)));
+            did.items().add_inline<bool>("ACTIVE", d != 1);
+            for (int e = 0; e < 2; ++e) {
+                group element("ELEMENT");
+                element.items().add<std::string>("NAME", "e" + std::to_string(d) + std::to_string(e));
+                element.items().add_inline<double>("SCALE", 0.5 * e);
+                element.items().add_inline<int>("VALUE", d * 10 + e);
+                did.add(std::move(element));
+            }
+            if (d == 2) {
+                group nested("NESTED");
+                group inner("ELEMENT");
+                inner.items().add<std::string>("NAME", std::string("/[quoted]"));
+                nested.add(std::move(inner));
+                did.add(std::move(nested));
+            }
+            root.add(std::move(did));
+        }
+        return root;
+    }
+
+    /* the NAME items or the group names of the matches, in order */
+    std::vector<std::string> names(const std::vector<query::const_match>& matches) {
+        std::vector<std::string> found;
+        for (const auto& m : matches) {
+            if (m.item) found.push_back(m.item->id().str());
+            else if (m.node->items().exists("NAME")) found.push_back(*m.node->items().value<std::string>("NAME"));
+            else found.push_back(m.node->name());
+        }
+        return found;
+    }
+
+    std::vector<std::string> run(const group& root, const char* text) {
+        return names(query(text).select(root));
+    }
+} // namespace
+
+
+TEST(Query, ChildAndWildcardSteps) {
+    const group root = make_tree();
+    EXPECT_EQ(query("DID").select(root).size(), 3U);
+    EXPECT_EQ(run(root, "DID/ELEMENT"), (std::vector<std::string>{"e00", "e01", "e10", "e11", "e20", "e21"}));
+    EXPECT_EQ(run(root, "*/*").size(), 7U);
+    EXPECT_TRUE(query("MISSING").select(root).empty());
+    const query q("DID/ELEMENT");
+    EXPECT_EQ(q.text(), std::string("DID/ELEMENT"));
+}
+
+
+TEST(Query, DescendantsStep) {
+    const group root = make_tree();
+    /* the group itself and every descendant, in pre-order */
+    EXPECT_EQ(run(root, "**/ELEMENT"), (std::vector<std::string>{"e00", "e01", "e10", "e11", "e20", "e21", "/[quoted]"}));
+    EXPECT_EQ(run(root, "**/NESTED/ELEMENT"), std::vector<std::string>{"/[quoted]"});
+}
+
+
+TEST(Query, ItemSteps) {
+    const group root = make_tree();
+    const auto ids = query("DID/@ID").select(root);
+    ASSERT_EQ(ids.size(), 3U);
+    EXPECT_EQ(*ids[1].item->get_if<std::string>(), std::string("FD11"));
+    EXPECT_EQ(ids[1].node->name(), std::string("DID"));
+
+    /* a name as the last step selects child groups before the item of the parent */
+    EXPECT_EQ(run(root, "TITLE"), std::vector<std::string>{"TITLE"});
+    EXPECT_EQ(run(root, "DID[0]/ELEMENT/VALUE"), (std::vector<std::string>{"VALUE", "VALUE"}));
+}
+
+
+TEST(Query, Predicates) {
+    const group root = make_tree();
+    EXPECT_EQ(run(root, "DID[ID=FD11]/ELEMENT"), (std::vector<std::string>{"e10", "e11"}));
+    EXPECT_EQ(run(root, "DID[ID!=FD11]/ELEMENT[0]"), (std::vector<std::string>{"e00", "e20"}));
+    EXPECT_EQ(run(root, "DID[2]/ELEMENT[1]"), std::vector<std::string>{"e21"});
+    EXPECT_EQ(run(root, "DID/ELEMENT[VALUE=21]"), std::vector<std::string>{"e21"});
+    EXPECT_EQ(run(root, "DID/ELEMENT[SCALE=0.5]").size(), 3U);
+    EXPECT_EQ(run(root, "DID[ACTIVE=false]/ELEMENT[0]"), std::vector<std::string>{"e10"});
+    EXPECT_EQ(run(root, "DID[ACTIVE=1]").size(), 2U);
+    EXPECT_EQ(run(root, "**/ELEMENT[NAME]").size(), 7U);
+    EXPECT_TRUE(query("DID[MISSING]").select(root).empty());
+
+    /* predicates apply in order, an index counts the groups passing the earlier ones */
+    EXPECT_EQ(run(root, "DID[ACTIVE=true][1]/ELEMENT[0]"), std::vector<std::string>{"e20"});
+    EXPECT_EQ(run(root, "DID[1][ACTIVE=true]").size(), 0U);
+
+    /* hexadecimal and decimal literals compare as numbers */
+    EXPECT_EQ(run(root, "DID[MASK=0x20]/ELEMENT[0]"), std::vector<std::string>{"e10"});
+    EXPECT_EQ(run(root, "DID[MASK=48]/ELEMENT[0]"), std::vector<std::string>{"e20"});
+
+    /* quoted values may hold separators, brackets and spaces */
+    EXPECT_EQ(run(root, "**/ELEMENT[NAME=\"/[quoted]\"]"), std::vector<std::string>{"/[quoted]"});
+    EXPECT_EQ(run(root, "**/ELEMENT[NAME='/[quoted]']"), std::vector<std::string>{"/[quoted]"});
+    EXPECT_EQ(run(root, "DID[ ID = 'FD10' ]/ELEMENT[0]"), std::vector<std::string>{"e00"});
+}
+
+
+TEST(Query, FirstAndForEachStopEarly) {
+    group root = make_tree();
+    const auto first = query("**/ELEMENT[VALUE=11]").first(root);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->node->items().value<int>("VALUE"), 11);
+    EXPECT_FALSE(query("DID[9]").first(root).has_value());
+
+    std::size_t seen = 0;
+    const bool complete = query("DID/ELEMENT").for_each(root, [&seen](const query::const_match&) { return ++seen < 2; });
+    EXPECT_FALSE(complete);
+    EXPECT_EQ(seen, 2U);
+}
+
+
+TEST(Query, ParallelSelectKeepsTheOrder) {
+    group root("ROOT");
+    for (int i = 0; i < 20; ++i) root.add(make_tree());
+    treecode::parallel options;
+    options.grain = 3;
+    for (const char* text : {"ROOT/DID/ELEMENT", "**/ELEMENT[VALUE!=0]", "*/DID[1]/@ID"}) {
+        const query q(text);
+        EXPECT_EQ(names(q.select(root, options)), names(q.select(static_cast<const group&>(root))));
+    }
+}
+
+
+TEST(Query, MalformedQueriesAreRejected) {
+    for (const char* text : {"", "/", "A/", "A//B", "[0]", "A/[ID=1]", "[ID=1]/A", "**", "A/**", "@ID/A",
+            "@", "@ID[0]", "A*", "*A", "A[", "A]", "A[0", "A[]", "A[ ]", "A[=1]", "A[!=1]", "A[ID=\"x]",
+            "A[ID='x\"]", "A[\"ID\"=1]", "A[ID=1]B"}) {
+        EXPECT_THROW(query{text}, std::invalid_argument);
+    }
+}
@@ -0,0 +1,81 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using treecode::group;
+    using treecode::rcu_tree;
+
+    /* a root with inline and item slots and enough children to build a name index */
+    group make_root() {
+        group root("ROOT");
+        root.items().add_inline<int>("LIMIT", 0);
+        root.items().add<std::string>("OWNER", std::string("init"));
+        for (int i = 0; i < 40; ++i) {
+            auto child = root.emplace_child("C" + std::to_string(i));
+            child->items().add_inline<int>("ID", i);
+            child->items().add<std::string>("NAME", "n" + std::to_string(i));
+        }
+        return root;
+    }
+} // namespace
+
+
+TEST(RcuTree, ReadersSeeConsistentVersions) {
+    rcu_tree tree(make_root());
+    constexpr int READERS = 4;
+    constexpr int UPDATES = 30;
+    std::atomic<bool> done{false};
+    std::atomic<int> errors{0};
+
+    /* readers go through the constant accessors that read the slots in place */
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; ++r) {
+        readers.emplace_back([&tree, &done, &errors]() {
+            while (!done.load()) {
+                auto view = tree.read();
+                const auto limit = view->items().find("LIMIT");
+                const auto owner = view->items().find("OWNER");
+                /* children are returned as mutable groups, readers hold them as constant ones */
+                const std::shared_ptr<const group> c7 = view->child("C7");
+                if (!limit || !owner || !c7) { ++errors; continue; }
+                /* every version holds LIMIT equal to its number minus one */
+                if (*limit->get_if<int>() != static_cast<int>(view.version()) - 1) ++errors;
+                if (c7->items().value<int>("ID") != 7) ++errors;
+                if (!c7->items().find("NAME")->get_if<std::string>()) ++errors;
+                (void)view->hash();
+            }
+        });
+    }
+
+    /* the writer copies the published root while the readers run */
+    for (int u = 1; u <= UPDATES; ++u) {
+        tree.update([u](group& next) {
+            next.items().value<int>("LIMIT", u);
+            next.child("C" + std::to_string(u % 40))->items().value<std::string>("NAME", "u" + std::to_string(u));
+        });
+    }
+    done = true;
+    for (auto& t : readers) t.join();
+
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(tree.version(), static_cast<std::uint64_t>(UPDATES + 1));
+    const auto root = tree.load();
+    EXPECT_EQ(root->items().value<int>("LIMIT"), UPDATES);
+    EXPECT_EQ(root->child("C30")->items().value<std::string>("NAME"), std::string("u30"));
+    EXPECT_TRUE(root->items().view("LIMIT").is_inline());
+}
+
+
+TEST(RcuTree, HeldRootsOutliveTheirVersion) {
+    rcu_tree tree(make_root());
+    const auto held = tree.load();
+    tree.update([](group& next) { next.items().value<std::string>("OWNER", "next"); });
+    EXPECT_EQ(held->items().value<std::string>("OWNER"), std::string("init"));
+    EXPECT_EQ(tree.load()->items().value<std::string>("OWNER"), std::string("next"));
+    EXPECT_EQ(tree.version(), 2U);
+}
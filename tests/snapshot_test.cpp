@@ -0,0 +1,99 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    using treecode::container;
+    using treecode::group;
+    using treecode::snapshot;
+
+    /* compares two trees slot by slot, required flags included */
+    bool equal_trees(const group& a, const group& b) {
+        if (a.name() != b.name() || a.items().keys() != b.items().keys()) return false;
+        std::vector<std::pair<treecode::value, bool>> va, vb;
+        a.items().for_each([&va](const container::item_view& view) { va.emplace_back(view.value(), view.is_required()); });
+        b.items().for_each([&vb](const container::item_view& view) { vb.emplace_back(view.value(), view.is_required()); });
+        if (va != vb || a.children().size() != b.children().size()) return false;
+        for (std::size_t i = 0; i < a.children().size(); ++i) {
+            if (!equal_trees(*a.children()[i], *b.children()[i])) return false;
+        }
+        return true;
+    }
+
+    group make_tree() {
+        group root("ROOT");
+        root.items().add<std::string>("TITLE", std::string("catalogue"));
+        root.items().add_inline<bool>("OPEN", true);
+        root.items().required("TITLE");
+        for (int i = 0; i < 20; ++i) {
+            group entry("ENTRY");
+            entry.items().add_inline<int>("ID", i);
+            entry.items().add<double>("RATIO", i / 4.0);
+            entry.items().emplace<std::string>("MODE",
+                std::make_shared<const std::vector<std::string>>(std::vector<std::string>{"RO", "RW"}))->value("RO");
+            if (i % 5 == 0) entry.add(group("EMPTY"));
+            root.add(std::move(entry));
+        }
+        return root;
+    }
+
+    std::string image_of(const group& root) {
+        std::ostringstream out;
+        snapshot::write(root, out);
+        return out.str();
+    }
+} // namespace
+
+
+TEST(Snapshot, RoundTrip) {
+    const group root = make_tree();
+    const std::string bytes = image_of(root);
+    const group read = snapshot::read(bytes.data(), bytes.size());
+    EXPECT_TRUE(equal_trees(read, root));
+    EXPECT_EQ(read.hash(), root.hash());
+    EXPECT_EQ(read.children()[3]->items().get<std::string>("MODE")->choices().size(), 2U);
+
+    /* the image of the read tree is the same image */
+    EXPECT_EQ(image_of(read), bytes);
+}
+
+
+TEST(Snapshot, LazyRoundTrip) {
+    const group root = make_tree();
+    std::istringstream in(image_of(root));
+    const group read = snapshot::read_lazy(in);
+    EXPECT_TRUE(equal_trees(read, root));
+}
+
+
+TEST(Snapshot, CorruptInputIsRejected) {
+    EXPECT_THROW(snapshot::read("", 0U), std::runtime_error);
+    const std::string garbage(256, 'x');
+    EXPECT_THROW(snapshot::read(garbage.data(), garbage.size()), std::runtime_error);
+
+    const std::string bytes = image_of(make_tree());
+    for (std::size_t n = 0; n < bytes.size(); n += 7) {
+        const std::string cut = bytes.substr(0, n);
+        EXPECT_THROW(snapshot::read(cut.data(), cut.size()), std::runtime_error);
+    }
+
+    /* a flipped byte either still reads as an image or is rejected, never read out of bounds */
+    for (std::size_t pos = 0; pos < bytes.size(); ++pos) {
+        std::string flipped = bytes;
+        flipped[pos] = static_cast<char>(flipped[pos] ^ 0x5A);
+        bool handled = true;
+        try {
+            const group read = snapshot::read(flipped.data(), flipped.size());
+            (void)read.hash();
+        } catch (const std::runtime_error&) {
+        } catch (...) {
+            handled = false;
+        }
+        EXPECT_TRUE(handled);
+    }
+}
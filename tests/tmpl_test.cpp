@@ -0,0 +1,215 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    using treecode::clone_mode;
+    using treecode::container;
+    using treecode::group;
+    using treecode::tmpl;
+
+    /* a template with a DID group holding an item slot and an inline slot */
+    tmpl make_template() {
+        tmpl t("T");
+        group did("DID");
+        did.items().add<std::string>("ID", std::string("FD00"));
+        did.items().add_inline<int>("LIMIT", 4);
+        group element("ELEMENT");
+        element.items().add<std::string>("NAME", std::string("none"));
+        did.add(std::move(element));
+        t.add(std::move(did));
+        return t;
+    }
+} // namespace
+
+
+TEST(Tmpl, CloneModesProduceEqualInstances) {
+    const tmpl t = make_template();
+    const group deep = t.clone("DID");
+    const group shared = t.clone("DID", clone_mode::shared);
+    EXPECT_EQ(deep.items().value<std::string>("ID"), std::string("FD00"));
+    EXPECT_EQ(shared.items().value<std::string>("ID"), std::string("FD00"));
+    EXPECT_EQ(shared.items().value<int>("LIMIT"), 4);
+    ASSERT_EQ(shared.children().size(), 1U);
+    EXPECT_EQ(shared.children()[0]->items().value<std::string>("NAME"), std::string("none"));
+}
+
+
+TEST(Tmpl, GetOnSharedInstancesCopiesTheItem) {
+    const tmpl t = make_template();
+    group first = t.clone("DID", clone_mode::shared);
+    const group second = t.clone("DID", clone_mode::shared);
+
+    /* the constant get hands out a writable item, so it copies the shared item as well */
+    const auto id = std::as_const(first).items().get<std::string>("ID");
+    ASSERT_TRUE(id != nullptr);
+    EXPECT_FALSE(first.items().view("ID").is_shared());
+    EXPECT_TRUE(first.items().get<std::string>("ID") == id);
+
+    id->value("FD01");
+    EXPECT_EQ(first.items().value<std::string>("ID"), std::string("FD01"));
+    EXPECT_EQ(second.items().value<std::string>("ID"), std::string("FD00"));
+    EXPECT_EQ(t.clone("DID").items().value<std::string>("ID"), std::string("FD00"));
+    EXPECT_EQ(t.clone("DID", clone_mode::shared).items().value<std::string>("ID"), std::string("FD00"));
+}
+
+
+TEST(Tmpl, SharedChildItemsAreCopiedOnWrite) {
+    const tmpl t = make_template();
+    group first = t.clone("DID", clone_mode::shared);
+    const group second = t.clone("DID", clone_mode::shared);
+    first.children()[0]->items().value<std::string>("NAME", "Interface1");
+    EXPECT_EQ(first.children()[0]->items().value<std::string>("NAME"), std::string("Interface1"));
+    EXPECT_EQ(second.children()[0]->items().value<std::string>("NAME"), std::string("none"));
+    EXPECT_EQ(t.clone("DID", clone_mode::shared).children()[0]->items().value<std::string>("NAME"), std::string("none"));
+}
+
+
+TEST(Tmpl, ReadsKeepItemsShared) {
+    const tmpl t = make_template();
+    group instance = t.clone("DID", clone_mode::shared);
+    container& items = instance.children()[0]->items();
+
+    /* reads of a non-constant instance go through the constant accessors, which never copy */
+    EXPECT_EQ(items.value<std::string>("NAME"), std::string("none"));
+    EXPECT_EQ(*items.find("NAME")->get_if<std::string>(), std::string("none"));
+    EXPECT_TRUE(items.view("NAME").has_value());
+    EXPECT_TRUE(items.exists("NAME"));
+    EXPECT_FALSE(items.is_required("NAME"));
+    EXPECT_EQ(items.keys().size(), 1U);
+    items.for_each([](const container::item_view& view) { (void)view.value(); });
+    (void)instance.hash();
+    const group copy = instance;
+    EXPECT_TRUE(items.view("NAME").is_shared());
+    EXPECT_TRUE(copy.children()[0]->items().view("NAME").is_shared());
+
+    /* get and get<T> hand out a writable item, so they copy it even if it is only read */
+    group by_get = t.clone("DID", clone_mode::shared);
+    (void)by_get.children()[0]->items().get("NAME");
+    EXPECT_FALSE(by_get.children()[0]->items().view("NAME").is_shared());
+    group by_typed_get = t.clone("DID", clone_mode::shared);
+    (void)by_typed_get.children()[0]->items().get<std::string>("NAME");
+    EXPECT_FALSE(by_typed_get.children()[0]->items().view("NAME").is_shared());
+
+    /* every write copies the item */
+    items.required("NAME");
+    EXPECT_FALSE(items.view("NAME").is_shared());
+    group cleared = t.clone("DID", clone_mode::shared);
+    cleared.children()[0]->items().clear_value("NAME");
+    EXPECT_FALSE(cleared.children()[0]->items().view("NAME").is_shared());
+    EXPECT_EQ(t.clone("DID").children()[0]->items().value<std::string>("NAME"), std::string("none"));
+}
+
+
+TEST(Tmpl, ClonesSeeChangesToTemplateGroups) {
+    tmpl t = make_template();
+    auto held = std::make_shared<group>("HELD");
+    held->items().add_inline<int>("SIZE", 1);
+    t.add(held);
+    EXPECT_EQ(t.clone("DID").items().value<std::string>("ID"), std::string("FD00"));
+    EXPECT_EQ(t.clone("HELD").items().value<int>("SIZE"), 1);
+
+    /* writes through groups(), through a held group and deep down a template group are seen */
+    t.groups()[0]->items().value<std::string>("ID", "FD02");
+    t.groups()[0]->children()[0]->items().add<int>("PORT", 80);
+    held->items().value<int>("SIZE", 2);
+    held->emplace_child("EXTRA");
+
+    const group did = t.clone("DID", clone_mode::shared);
+    EXPECT_EQ(did.items().value<std::string>("ID"), std::string("FD02"));
+    EXPECT_EQ(did.children()[0]->items().value<int>("PORT"), 80);
+    const group again = t.clone("HELD");
+    EXPECT_EQ(again.items().value<int>("SIZE"), 2);
+    ASSERT_EQ(again.children().size(), 1U);
+    EXPECT_EQ(again.children()[0]->name(), std::string("EXTRA"));
+
+    /* the instances are not template groups, writing them leaves the plans alone */
+    group instance = t.clone("HELD");
+    instance.items().value<int>("SIZE", 3);
+    EXPECT_EQ(t.clone("HELD").items().value<int>("SIZE"), 2);
+}
+
+
+TEST(Tmpl, ClonesSeeChangesTheHashCannotSee) {
+    tmpl t("T");
+    auto held = std::make_shared<group>("HELD");
+    held->items().add<std::vector<int>>("LIST", std::vector<int>{1, 2});
+    held->emplace_child("CHILD")->items().add<std::vector<int>>("LIST", std::vector<int>{3});
+    t.add(held);
+    ASSERT_EQ(t.clone("HELD").items().value<std::vector<int>>("LIST"), (std::vector<int>{1, 2}));
+
+    /* items of user types hash by address, the values change in place and keep the hash */
+    const std::uint64_t before = held->hash();
+    held->items().get<std::vector<int>>("LIST")->value(std::vector<int>{5});
+    held->children()[0]->items().get<std::vector<int>>("LIST")->value(std::vector<int>{6});
+    ASSERT_EQ(held->hash(), before);
+
+    const group instance = t.clone("HELD");
+    EXPECT_EQ(instance.items().value<std::vector<int>>("LIST"), std::vector<int>{5});
+    EXPECT_EQ(instance.children()[0]->items().value<std::vector<int>>("LIST"), std::vector<int>{6});
+
+    /* a second change after the clone is seen as well */
+    held->children()[0]->items().get<std::vector<int>>("LIST")->value(std::vector<int>{7});
+    EXPECT_EQ(t.clone("HELD").children()[0]->items().value<std::vector<int>>("LIST"), std::vector<int>{7});
+}
+
+
+TEST(Tmpl, ClonePtrBuildsTheInstanceInItsResource) {
+    const tmpl t = make_template();
+    std::pmr::monotonic_buffer_resource arena;
+    const auto node = t.clone_ptr("DID", clone_mode::shared, &arena);
+    ASSERT_TRUE(node != nullptr);
+    EXPECT_TRUE(node->resource() == &arena);
+    EXPECT_TRUE(node->items().resource() == &arena);
+    ASSERT_EQ(node->children().size(), 1U);
+    EXPECT_TRUE(node->children()[0]->resource() == &arena);
+    EXPECT_EQ(node->hash(), t.clone("DID").hash());
+}
+
+
+TEST(Tmpl, CloneNInstancesAreIndependent) {
+    const tmpl t = make_template();
+    for (clone_mode mode : {clone_mode::deep, clone_mode::shared}) {
+        auto instances = t.clone_n("DID", 4, mode);
+        ASSERT_EQ(instances.size(), 4U);
+        for (const auto& instance : instances) EXPECT_EQ(instance->hash(), t.clone("DID").hash());
+
+        /* writes to one instance, its items and its children leave the others and the template alone */
+        instances[1]->items().value<std::string>("ID", "FD01");
+        instances[1]->items().value<int>("LIMIT", 8);
+        instances[1]->children()[0]->items().value<std::string>("NAME", "Interface1");
+        instances[2]->emplace_child("EXTRA");
+        EXPECT_EQ(instances[0]->items().value<std::string>("ID"), std::string("FD00"));
+        EXPECT_EQ(instances[0]->items().value<int>("LIMIT"), 4);
+        EXPECT_EQ(instances[3]->children()[0]->items().value<std::string>("NAME"), std::string("none"));
+        EXPECT_EQ(instances[3]->children().size(), 1U);
+        EXPECT_TRUE(instances[0]->children()[0] != instances[3]->children()[0]);
+        EXPECT_EQ(t.clone("DID", mode).hash(), instances[0]->hash());
+
+        /* the instances outlive the vector through any one of them */
+        const auto kept = instances[1];
+        instances.clear();
+        EXPECT_EQ(kept->items().value<std::string>("ID"), std::string("FD01"));
+        EXPECT_EQ(kept->children()[0]->items().value<std::string>("NAME"), std::string("Interface1"));
+    }
+
+    /* instances attached to a group, or handed to a function, are independent as well */
+    group root("ROOT");
+    t.clone_n("DID", 3, root, clone_mode::shared);
+    ASSERT_EQ(root.children().size(), 3U);
+    root.children()[0]->items().value<std::string>("ID", "FD03");
+    EXPECT_EQ(root.children()[2]->items().value<std::string>("ID"), std::string("FD00"));
+    std::size_t seen = 0;
+    t.clone_n("DID", 2, [&seen](const std::shared_ptr<group>& instance) {
+        if (seen++ == 0) instance->items().value<int>("LIMIT", 9);
+        else EXPECT_EQ(instance->items().value<int>("LIMIT"), 4);
+    });
+    EXPECT_EQ(seen, 2U);
+    EXPECT_EQ(t.clone("DID").items().value<int>("LIMIT"), 4);
+}
@@ -0,0 +1,79 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+    using treecode::group;
+    using treecode::traversal;
+
+    /*
+     * R
+     * ├ A
+     * │ ├ A1
+     * │ └ A2
+     * │   └ A21
+     * ├ B
+     * └ C
+     *   └ C1
+     */
+    group make_tree() {
+        group root("R");
+        auto a = root.emplace_child("A");
+        a->emplace_child("A1");
+        a->emplace_child("A2")->emplace_child("A21");
+        root.emplace_child("B");
+        root.emplace_child("C")->emplace_child("C1");
+        for (auto& n : treecode::walk(root)) n.node->items().add_inline<int>("K" + n.node->name(), static_cast<int>(n.depth));
+        return root;
+    }
+
+    /* the visited groups as name:depth:index:parent */
+    std::vector<std::string> visit(const group& root, traversal order) {
+        std::vector<std::string> seen;
+        for (const auto& n : treecode::walk(root, order)) {
+            seen.push_back(n.node->name() + ":" + std::to_string(n.depth) + ":" + std::to_string(n.index) + ":" +
+                (n.parent ? n.parent->name() : std::string("-")));
+        }
+        return seen;
+    }
+} // namespace
+
+
+TEST(Traversal, PreOrder) {
+    const group root = make_tree();
+    EXPECT_EQ(visit(root, traversal::pre_order), (std::vector<std::string>{
+        "R:0:0:-", "A:1:0:R", "A1:2:0:A", "A2:2:1:A", "A21:3:0:A2", "B:1:1:R", "C:1:2:R", "C1:2:0:C"}));
+}
+
+
+TEST(Traversal, PostOrder) {
+    const group root = make_tree();
+    EXPECT_EQ(visit(root, traversal::post_order), (std::vector<std::string>{
+        "A1:2:0:A", "A21:3:0:A2", "A2:2:1:A", "A:1:0:R", "B:1:1:R", "C1:2:0:C", "C:1:2:R", "R:0:0:-"}));
+}
+
+
+TEST(Traversal, BreadthFirst) {
+    const group root = make_tree();
+    EXPECT_EQ(visit(root, traversal::breadth_first), (std::vector<std::string>{
+        "R:0:0:-", "A:1:0:R", "B:1:1:R", "C:1:2:R", "A1:2:0:A", "A2:2:1:A", "C1:2:0:C", "A21:3:0:A2"}));
+}
+
+
+TEST(Traversal, SingleGroupAndItems) {
+    const group single("S");
+    for (traversal order : {traversal::pre_order, traversal::post_order, traversal::breadth_first}) {
+        EXPECT_EQ(visit(single, order), std::vector<std::string>{"S:0:0:-"});
+        EXPECT_TRUE(treecode::walk_items(single, order).begin() == treecode::walk_items(single, order).end());
+    }
+
+    /* items follow the order of their groups, groups without items are skipped */
+    group root = make_tree();
+    root.children()[1]->items().remove("KB");
+    root.items().add_inline<int>("EXTRA", 0);
+    std::vector<std::string> keys;
+    for (const auto& item : treecode::walk_items(root, traversal::post_order)) keys.push_back(item.id.str() + ":" + std::to_string(item.depth));
+    EXPECT_EQ(keys, (std::vector<std::string>{"KA1:2", "KA21:3", "KA2:2", "KA:1", "KC1:2", "KC:1", "KR:0", "EXTRA:0"}));
+}
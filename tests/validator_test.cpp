@@ -0,0 +1,88 @@
+#include <treecode.hpp>
+#include <check.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    using treecode::group;
+    using treecode::issue;
+    using treecode::tmpl;
+
+    /* a template with a DID group holding a required item, a choice item and an ELEMENT child */
+    tmpl make_template() {
+        tmpl t("T");
+        group did("DID");
+        did.items().add<std::string>("ID", std::string("FD00"));
+        did.items().required("ID");
+        did.items().emplace<std::string>("MODE",
+            std::make_shared<const std::vector<std::string>>(std::vector<std::string>{"RO", "RW"}))->value("RO");
+        did.items().add_inline<int>("LIMIT", 4);
+        group element("ELEMENT");
+        element.items().add<std::string>("NAME", std::string("none"));
+        did.add(std::move(element));
+        t.add(std::move(did));
+        return t;
+    }
+
+    std::vector<issue> kinds(const treecode::validation& result) {
+        std::vector<issue> found;
+        for (const auto& d : result.diagnostics) found.push_back(d.kind);
+        return found;
+    }
+} // namespace
+
+
+TEST(Validator, ClonesMatchTheirTemplate) {
+    const tmpl t = make_template();
+    group root("ROOT");
+    for (int i = 0; i < 30; ++i) root.add(t.clone("DID", i % 2 ? treecode::clone_mode::shared : treecode::clone_mode::deep));
+    const treecode::validator check(t);
+    const auto serial = check.run(root);
+    EXPECT_TRUE(serial.ok());
+    EXPECT_EQ(serial.groups, 60U);
+    treecode::parallel options;
+    options.grain = 4;
+    EXPECT_TRUE(check.run(root, options).ok());
+}
+
+
+TEST(Validator, ReportsEachIssue) {
+    const tmpl t = make_template();
+    group root("ROOT");
+    group did = t.clone("DID");
+    did.items().remove("LIMIT");
+    did.items().add<int>("EXTRA", 1);
+    did.items().clear_value("ID");
+    did.remove(did.children()[0]);
+    did.add(group("STRAY"));
+    root.add(std::move(did));
+
+    const auto result = treecode::validate(root, t);
+    EXPECT_EQ(kinds(result), (std::vector<issue>{issue::required_unset, issue::missing_item,
+        issue::unexpected_item, issue::missing_group, issue::unexpected_group}));
+    ASSERT_EQ(result.diagnostics.size(), 5U);
+    EXPECT_EQ(result.diagnostics[0].path, std::string("DID[0]"));
+    EXPECT_EQ(result.diagnostics[0].key, std::string("ID"));
+    EXPECT_EQ(result.diagnostics[1].key, std::string("LIMIT"));
+    EXPECT_EQ(result.diagnostics[4].path, std::string("DID[0]/STRAY[0]"));
+}
+
+
+TEST(Validator, RunsSeeTemplateChanges) {
+    tmpl t = make_template();
+    const treecode::validator check(t);
+    group root("ROOT");
+    root.add(t.clone("DID"));
+    EXPECT_TRUE(check.run(root).ok());
+
+    /* a validator kept across a template change checks against the changed group */
+    t.groups()[0]->items().add_inline<bool>("ENABLED", true);
+    EXPECT_EQ(kinds(check.run(root)), std::vector<issue>{issue::missing_item});
+    root.add(t.clone("DID"));
+    const auto result = check.run(root);
+    ASSERT_EQ(result.diagnostics.size(), 1U);
+    EXPECT_EQ(result.diagnostics[0].path, std::string("DID[0]"));
+}